@@ -0,0 +1,575 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+//
+// mjaccess_bench -- standalone throughput benchmark for libmjaccess.
+//
+// Runs embedded reference models through model load, mjaccess_step,
+// mjaccess_batched_step (a grid of num_envs x num_threads), every
+// mjaccess_batched_get_* gather and the instanced render-matrix export of all
+// envs, and prints one CSV row (or JSON object)
+// per measurement so results can be diffed across releases.
+//
+//   mjaccess_bench [--models pendulum,humanoid,boxpile,terrain]
+//                  [--envs 1,16,64,256] [--threads 1,2,4,8]
+//                  [--steps 20000] [--format csv|json] [--out file]
+//                  [--record file]
+//
+// --steps is the env-step budget of each measurement (batched runs step
+// steps / num_envs times). Efficiency compares the per-thread rate with the
+// first thread count at the same num_envs. --record repeats every batched
+// measurement while recording qpos/qvel/ctrl/sensordata (delta + compress) to
+// the file; its efficiency is the rate relative to the unrecorded run.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "mjaccess.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_LIST 16
+
+// ── Reference models ─────────────────────────────────────────
+
+static const char* k_pendulum_xml =
+    "<mujoco model='pendulum'>"
+    "  <option timestep='0.002'/>"
+    "  <worldbody>"
+    "    <body name='pole' pos='0 0 1'>"
+    "      <joint name='hinge' type='hinge' axis='0 1 0' damping='0.05'/>"
+    "      <geom type='capsule' fromto='0 0 0 0 0 -0.6' size='0.04' mass='1'/>"
+    "    </body>"
+    "  </worldbody>"
+    "  <actuator><motor joint='hinge' gear='1' ctrlrange='-1 1' ctrllimited='true'/></actuator>"
+    "</mujoco>";
+
+static const char* k_humanoid_xml =
+    "<mujoco model='humanoid'>"
+    "  <option timestep='0.005' iterations='50' solver='Newton'/>"
+    "  <default>"
+    "    <joint armature='1' damping='1' limited='true'/>"
+    "    <geom conaffinity='0' condim='3' contype='1' friction='1 0.1 0.1' margin='0.001'/>"
+    "    <motor ctrllimited='true' ctrlrange='-0.4 0.4'/>"
+    "  </default>"
+    "  <worldbody>"
+    "    <geom name='floor' type='plane' size='20 20 0.125' conaffinity='1' condim='3'/>"
+    "    <body name='torso' pos='0 0 1.4'>"
+    "      <freejoint name='root'/>"
+    "      <geom name='torso1' type='capsule' fromto='0 -.07 0 0 .07 0' size='0.07'/>"
+    "      <geom name='head' type='sphere' pos='0 0 .19' size='.09'/>"
+    "      <geom name='uwaist' type='capsule' fromto='-.01 -.06 -.12 -.01 .06 -.12' size='0.06'/>"
+    "      <body name='lwaist' pos='-.01 0 -0.260' quat='1.000 0 -0.002 0'>"
+    "        <geom name='lwaist' type='capsule' fromto='0 -.06 0 0 .06 0' size='0.06'/>"
+    "        <joint name='abdomen_z' type='hinge' pos='0 0 0.065' axis='0 0 1' range='-45 45' stiffness='20'/>"
+    "        <joint name='abdomen_y' type='hinge' pos='0 0 0.065' axis='0 1 0' range='-75 30' stiffness='10'/>"
+    "        <body name='pelvis' pos='0 0 -0.165' quat='1.000 0 -0.002 0'>"
+    "          <joint name='abdomen_x' type='hinge' pos='0 0 0.1' axis='1 0 0' range='-35 35' stiffness='10'/>"
+    "          <geom name='butt' type='capsule' fromto='-.02 -.07 0 -.02 .07 0' size='0.09'/>"
+    "          <body name='right_thigh' pos='0 -0.1 -0.04'>"
+    "            <joint name='right_hip_x' type='hinge' axis='1 0 0' range='-25 5' armature='0.01'/>"
+    "            <joint name='right_hip_z' type='hinge' axis='0 0 1' range='-60 35' armature='0.01'/>"
+    "            <joint name='right_hip_y' type='hinge' axis='0 1 0' range='-110 20' armature='0.01'/>"
+    "            <geom name='right_thigh1' type='capsule' fromto='0 0 0 0 0.01 -.34' size='0.06'/>"
+    "            <body name='right_shin' pos='0 0.01 -0.403'>"
+    "              <joint name='right_knee' type='hinge' pos='0 0 .02' axis='0 -1 0' range='-160 -2'/>"
+    "              <geom name='right_shin1' type='capsule' fromto='0 0 0 0 0 -.3' size='0.049'/>"
+    "              <body name='right_foot' pos='0 0 -0.45'>"
+    "                <geom name='right_foot' type='sphere' pos='0 0 0.1' size='0.075' contype='1'/>"
+    "              </body>"
+    "            </body>"
+    "          </body>"
+    "          <body name='left_thigh' pos='0 0.1 -0.04'>"
+    "            <joint name='left_hip_x' type='hinge' axis='-1 0 0' range='-25 5' armature='0.01'/>"
+    "            <joint name='left_hip_z' type='hinge' axis='0 0 -1' range='-60 35' armature='0.01'/>"
+    "            <joint name='left_hip_y' type='hinge' axis='0 1 0' range='-110 20' armature='0.01'/>"
+    "            <geom name='left_thigh1' type='capsule' fromto='0 0 0 0 -0.01 -.34' size='0.06'/>"
+    "            <body name='left_shin' pos='0 -0.01 -0.403'>"
+    "              <joint name='left_knee' type='hinge' pos='0 0 .02' axis='0 -1 0' range='-160 -2'/>"
+    "              <geom name='left_shin1' type='capsule' fromto='0 0 0 0 0 -.3' size='0.049'/>"
+    "              <body name='left_foot' pos='0 0 -0.45'>"
+    "                <geom name='left_foot' type='sphere' pos='0 0 0.1' size='0.075' contype='1'/>"
+    "              </body>"
+    "            </body>"
+    "          </body>"
+    "        </body>"
+    "      </body>"
+    "      <body name='right_upper_arm' pos='0 -0.17 0.06'>"
+    "        <joint name='right_shoulder1' type='hinge' axis='2 1 1' range='-85 60'/>"
+    "        <joint name='right_shoulder2' type='hinge' axis='0 -1 1' range='-85 60'/>"
+    "        <geom name='right_uarm1' type='capsule' fromto='0 0 0 .16 -.16 -.16' size='0.04 0.16'/>"
+    "        <body name='right_lower_arm' pos='.18 -.18 -.18'>"
+    "          <joint name='right_elbow' type='hinge' axis='0 -1 1' range='-90 50' stiffness='0'/>"
+    "          <geom name='right_larm' type='capsule' fromto='0.01 0.01 0.01 .17 .17 .17' size='0.031'/>"
+    "          <geom name='right_hand' type='sphere' pos='.18 .18 .18' size='0.04'/>"
+    "        </body>"
+    "      </body>"
+    "      <body name='left_upper_arm' pos='0 0.17 0.06'>"
+    "        <joint name='left_shoulder1' type='hinge' axis='2 -1 1' range='-60 85'/>"
+    "        <joint name='left_shoulder2' type='hinge' axis='0 1 1' range='-60 85'/>"
+    "        <geom name='left_uarm1' type='capsule' fromto='0 0 0 .16 .16 -.16' size='0.04 0.16'/>"
+    "        <body name='left_lower_arm' pos='.18 .18 -.18'>"
+    "          <joint name='left_elbow' type='hinge' axis='0 -1 -1' range='-90 50' stiffness='0'/>"
+    "          <geom name='left_larm' type='capsule' fromto='0.01 -0.01 0.01 .17 -.17 .17' size='0.031'/>"
+    "          <geom name='left_hand' type='sphere' pos='.18 -.18 .18' size='0.04'/>"
+    "        </body>"
+    "      </body>"
+    "    </body>"
+    "  </worldbody>"
+    "  <actuator>"
+    "    <motor gear='100' joint='abdomen_y'/>"
+    "    <motor gear='100' joint='abdomen_z'/>"
+    "    <motor gear='100' joint='abdomen_x'/>"
+    "    <motor gear='100' joint='right_hip_x'/>"
+    "    <motor gear='100' joint='right_hip_z'/>"
+    "    <motor gear='300' joint='right_hip_y'/>"
+    "    <motor gear='200' joint='right_knee'/>"
+    "    <motor gear='100' joint='left_hip_x'/>"
+    "    <motor gear='100' joint='left_hip_z'/>"
+    "    <motor gear='300' joint='left_hip_y'/>"
+    "    <motor gear='200' joint='left_knee'/>"
+    "    <motor gear='25' joint='right_shoulder1'/>"
+    "    <motor gear='25' joint='right_shoulder2'/>"
+    "    <motor gear='25' joint='right_elbow'/>"
+    "    <motor gear='25' joint='left_shoulder1'/>"
+    "    <motor gear='25' joint='left_shoulder2'/>"
+    "    <motor gear='25' joint='left_elbow'/>"
+    "  </actuator>"
+    "</mujoco>";
+
+#define TERRAIN_NROW 64
+#define TERRAIN_NCOL 64
+
+static const char* k_terrain_xml =
+    "<mujoco model='terrain'>"
+    "  <option timestep='0.004'/>"
+    "  <asset>"
+    "    <hfield name='terrain' nrow='64' ncol='64' size='4 4 0.5 0.1'/>"
+    "  </asset>"
+    "  <worldbody>"
+    "    <geom type='hfield' hfield='terrain'/>"
+    "    <body pos='-1 -1 1'><freejoint/><geom type='sphere' size='0.15'/></body>"
+    "    <body pos='1 -1 1'><freejoint/><geom type='capsule' size='0.1 0.2'/></body>"
+    "    <body pos='-1 1 1'><freejoint/><geom type='box' size='0.15 0.15 0.15'/></body>"
+    "    <body pos='1 1 1'><freejoint/><geom type='ellipsoid' size='0.2 0.15 0.1'/></body>"
+    "    <body pos='0 0 1.2'><freejoint/><geom type='cylinder' size='0.15 0.1'/></body>"
+    "  </worldbody>"
+    "</mujoco>";
+
+// 4 x 4 x 4 free boxes dropped onto a plane: dozens of box-box contacts.
+static char* make_boxpile_xml(void) {
+    size_t cap = 32768;
+    char* xml = (char*)malloc(cap);
+    if (!xml) return NULL;
+    int len = snprintf(xml, cap,
+                       "<mujoco model='boxpile'><option timestep='0.004'/><worldbody>"
+                       "<geom type='plane' size='5 5 0.1'/>");
+    for (int z = 0; z < 4; z++) {
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                len += snprintf(xml + len, cap - len,
+                                "<body pos='%.3f %.3f %.3f' euler='%d %d %d'><freejoint/>"
+                                "<geom type='box' size='0.1 0.1 0.1'/></body>",
+                                (x - 1.5) * 0.21 + 0.02 * z, (y - 1.5) * 0.21 - 0.02 * z,
+                                0.15 + z * 0.25, 7 * x, 11 * y, 13 * z);
+            }
+        }
+    }
+    snprintf(xml + len, cap - len, "</worldbody></mujoco>");
+    return xml;
+}
+
+typedef struct {
+    const char* name;
+    char*       xml;
+} BenchModel;
+
+static MjAccessModel* load_bench_model(const BenchModel* bm) {
+    MjAccessModel* model = mjaccess_load_model_from_string(bm->xml);
+    if (model && strcmp(bm->name, "terrain") == 0) {
+        static float heights[TERRAIN_NROW * TERRAIN_NCOL];
+        for (int r = 0; r < TERRAIN_NROW; r++) {
+            for (int c = 0; c < TERRAIN_NCOL; c++) {
+                double h = 0.5 + 0.25 * sin(r * 0.35) * cos(c * 0.27) + 0.1 * sin((r + c) * 0.9);
+                heights[r * TERRAIN_NCOL + c] = (float)h;
+            }
+        }
+        mjaccess_model_set_hfield_data(model, mjaccess_model_hfield_adr(model, 0), heights,
+                                       TERRAIN_NROW * TERRAIN_NCOL);
+    }
+    return model;
+}
+
+// ── Timing and output ────────────────────────────────────────
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Deterministic controls in [-1, 1].
+static void fill_ctrl(double* ctrl, int n, unsigned seed) {
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        ctrl[i] = (double)(seed >> 8) / (double)(1u << 24) * 2.0 - 1.0;
+    }
+}
+
+typedef struct {
+    const char* model;
+    const char* bench;     // load, step, batched_step[_record|_active], gather_<field>,
+                           // render_matrices, terrain_walk
+    int         num_envs;
+    int         threads;
+    long long   steps;     // env-steps (or calls for load/gather/render)
+    double      seconds;
+    double      efficiency;  // per-thread rate vs. the first thread count, 0 = n/a
+    double      bytes;       // bytes moved per call for gathers, 0 = n/a
+} BenchRow;
+
+typedef struct {
+    FILE* out;
+    int   json;
+    int   rows;
+} BenchReport;
+
+static void report_begin(BenchReport* rep) {
+    if (rep->json) {
+        fprintf(rep->out, "[\n");
+    } else {
+        fprintf(rep->out, "model,bench,num_envs,threads,steps,seconds,steps_per_sec,"
+                          "ns_per_env_step,efficiency,gather_gbps\n");
+    }
+}
+
+static void report_row(BenchReport* rep, const BenchRow* row) {
+    double rate = row->seconds > 0 ? row->steps / row->seconds : 0;
+    double ns = row->steps > 0 ? row->seconds * 1e9 / row->steps : 0;
+    double gbps = row->bytes > 0 && row->seconds > 0 ? row->bytes * row->steps / row->seconds * 1e-9 : 0;
+    if (rep->json) {
+        fprintf(rep->out,
+                "%s  {\"model\": \"%s\", \"bench\": \"%s\", \"num_envs\": %d, \"threads\": %d, "
+                "\"steps\": %lld, \"seconds\": %.6f, \"steps_per_sec\": %.1f, "
+                "\"ns_per_env_step\": %.1f, \"efficiency\": %.3f, \"gather_gbps\": %.3f}",
+                rep->rows ? ",\n" : "", row->model, row->bench, row->num_envs, row->threads,
+                row->steps, row->seconds, rate, ns, row->efficiency, gbps);
+    } else {
+        fprintf(rep->out, "%s,%s,%d,%d,%lld,%.6f,%.1f,%.1f,%.3f,%.3f\n", row->model, row->bench,
+                row->num_envs, row->threads, row->steps, row->seconds, rate, ns,
+                row->efficiency, gbps);
+    }
+    fflush(rep->out);
+    rep->rows++;
+}
+
+static void report_end(BenchReport* rep) {
+    if (rep->json) fprintf(rep->out, "\n]\n");
+}
+
+// ── Benchmarks ───────────────────────────────────────────────
+
+static void bench_load(BenchReport* rep, const BenchModel* bm) {
+    const int reps = 5;
+    double t0 = now_sec();
+    for (int i = 0; i < reps; i++) mjaccess_free_model(load_bench_model(bm));
+    BenchRow row = { bm->name, "load", 0, 1, reps, now_sec() - t0, 0, 0 };
+    report_row(rep, &row);
+}
+
+static void bench_step(BenchReport* rep, const BenchModel* bm, int steps) {
+    MjAccessModel* model = load_bench_model(bm);
+    MjAccessData* data = mjaccess_make_data(model);
+    int nu = mjaccess_model_info(model).nu;
+    double* ctrl = (double*)malloc((nu > 0 ? nu : 1) * sizeof(double));
+    fill_ctrl(ctrl, nu, 1);
+    mjaccess_set_ctrl(data, ctrl, nu);
+    for (int i = 0; i < steps / 10; i++) mjaccess_step(model, data);  // warm up
+
+    double t0 = now_sec();
+    for (int i = 0; i < steps; i++) mjaccess_step(model, data);
+    BenchRow row = { bm->name, "step", 1, 1, steps, now_sec() - t0, 0, 0 };
+    report_row(rep, &row);
+
+    free(ctrl);
+    mjaccess_free_data(data);
+    mjaccess_free_model(model);
+}
+
+typedef const double* (*GatherFn)(const MjAccessBatchedSim*, int*);
+
+static const struct {
+    const char* name;
+    GatherFn    fn;
+} k_gathers[] = {
+    { "gather_qpos",          mjaccess_batched_get_qpos },
+    { "gather_qvel",          mjaccess_batched_get_qvel },
+    { "gather_ctrl",          mjaccess_batched_get_ctrl },
+    { "gather_xpos",          mjaccess_batched_get_xpos },
+    { "gather_xquat",         mjaccess_batched_get_xquat },
+    { "gather_subtree_com",   mjaccess_batched_get_subtree_com },
+    { "gather_cinert",        mjaccess_batched_get_cinert },
+    { "gather_cvel",          mjaccess_batched_get_cvel },
+    { "gather_qfrc_actuator", mjaccess_batched_get_qfrc_actuator },
+    { "gather_cfrc_ext",      mjaccess_batched_get_cfrc_ext },
+    { "gather_sensordata",    mjaccess_batched_get_sensordata },
+    { "gather_geom_xpos",     mjaccess_batched_get_geom_xpos },
+    { "gather_geom_xmat",     mjaccess_batched_get_geom_xmat },
+};
+
+// Page a 2048^2 world through the terrain hfield along a diagonal walk;
+// bytes is the mean hfield data copied per recentering call.
+static void bench_terrain(BenchReport* rep, const BenchModel* bm) {
+    MjAccessModel* model = load_bench_model(bm);
+    MjAccessTerrainConfig cfg = { 0, -1, 2048, 2048, { 0, 0 }, 8, -1 };
+    MjAccessTerrain* terrain = mjaccess_terrain_create(model, &cfg, NULL);
+    if (terrain) {
+        int rows, cols;
+        float* world = mjaccess_terrain_world(terrain, &rows, &cols);
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++)
+                world[(size_t)r * cols + c] = (float)(0.5 + 0.25 * sin(r * 0.35) * cos(c * 0.27));
+        const int calls = 20000;
+        long long copied = 0;
+        double t0 = now_sec();
+        for (int i = 0; i < calls; i++) {
+            double s = 10.0 + i * 0.01;  // metres; cells are 8 / 63 m
+            copied += mjaccess_terrain_center(terrain, s, s * 0.5);
+        }
+        BenchRow row = { bm->name, "terrain_walk", 0, 1, calls, now_sec() - t0, 0,
+                         (double)copied * sizeof(float) / calls };
+        report_row(rep, &row);
+        mjaccess_terrain_free(terrain);
+    }
+    mjaccess_free_model(model);
+}
+
+// Batched throughput over the num_envs x threads grid; gathers are measured
+// once per num_envs on the single-threaded sim.
+static void bench_batched(BenchReport* rep, const BenchModel* bm, const int* envs, int n_envs,
+                          const int* threads, int n_threads, int steps, const char* record) {
+    MjAccessModel* model = load_bench_model(bm);
+    int nu = mjaccess_model_info(model).nu;
+    for (int e = 0; e < n_envs; e++) {
+        int ne = envs[e];
+        size_t nctrl = (size_t)ne * (nu > 0 ? nu : 1);
+        double* ctrl = (double*)malloc(nctrl * sizeof(double));
+        fill_ctrl(ctrl, (int)nctrl, 7);
+        // env-steps per measurement, at least one step per env
+        int iters = steps / ne > 0 ? steps / ne : 1;
+        double base_rate = 0;
+
+        for (int t = 0; t < n_threads; t++) {
+            MjAccessBatchedConfig cfg;
+            memset(&cfg, 0, sizeof(cfg));
+            cfg.num_envs = ne;
+            cfg.num_threads = threads[t];
+            MjAccessBatchedSim* sim = mjaccess_batched_create(model, &cfg);
+            if (!sim) continue;
+            for (int i = 0; i < iters / 10 + 1; i++) mjaccess_batched_step(sim, ctrl);
+
+            double t0 = now_sec();
+            for (int i = 0; i < iters; i++) mjaccess_batched_step(sim, ctrl);
+            double sec = now_sec() - t0;
+            long long env_steps = (long long)iters * ne;
+            double rate = sec > 0 ? env_steps / sec : 0;
+            int nt = mjaccess_batched_num_threads(sim);
+            if (t == 0) base_rate = rate / nt;
+            BenchRow row = { bm->name, "batched_step", ne, nt, env_steps, sec,
+                             base_rate > 0 ? rate / (base_rate * nt) : 0, 0 };
+            report_row(rep, &row);
+
+            if (record) {
+                MjAccessRecordConfig rc;
+                memset(&rc, 0, sizeof(rc));
+                rc.flags = MJA_RECORD_DELTA | MJA_RECORD_COMPRESS;
+                if (mjaccess_batched_record_start(sim, record, &rc) == 0) {
+                    double r0 = now_sec();
+                    for (int i = 0; i < iters; i++) mjaccess_batched_step(sim, ctrl);
+                    double rsec = now_sec() - r0;
+                    mjaccess_batched_record_stop(sim);
+                    BenchRow rrow = { bm->name, "batched_step_record", ne, nt, env_steps, rsec,
+                                      rsec > 0 ? sec / rsec : 0, 0 };
+                    report_row(rep, &rrow);
+                }
+            }
+
+            // a quarter of the envs active: efficiency is the active env-step
+            // rate over the full-batch rate, 1.0 when idle envs cost nothing
+            int* mask = (int*)malloc(ne * sizeof(int));
+            if (mask) {
+                for (int i = 0; i < ne; i++) mask[i] = i % 4 == 0;
+                int na = mjaccess_batched_set_active(sim, mask);
+                double a0 = now_sec();
+                for (int i = 0; i < iters; i++) mjaccess_batched_step(sim, ctrl);
+                double asec = now_sec() - a0;
+                long long active_steps = (long long)iters * na;
+                BenchRow arow = { bm->name, "batched_step_active", ne, nt, active_steps, asec,
+                                  asec > 0 && rate > 0 ? active_steps / asec / rate : 0, 0 };
+                report_row(rep, &arow);
+                mjaccess_batched_set_active(sim, NULL);
+                free(mask);
+            }
+
+            // a perturbation scattered into every env before each step: the
+            // efficiency is the plain step time over step + scatter time
+            int* envs = (int*)malloc(ne * sizeof(int));
+            double* push = (double*)malloc(ne * sizeof(double));
+            if (envs && push) {
+                int elem = 0;
+                for (int i = 0; i < ne; i++) {
+                    envs[i] = i;
+                    push[i] = 0.01 * (i % 7);
+                }
+                double s0 = now_sec();
+                for (int i = 0; i < iters; i++) {
+                    mjaccess_batched_scatter(sim, MJA_CMD_QFRC_APPLIED, envs, ne, &elem, 1, push);
+                    mjaccess_batched_step(sim, ctrl);
+                }
+                double ssec = now_sec() - s0;
+                BenchRow srow = { bm->name, "batched_scatter", ne, nt, env_steps, ssec,
+                                  ssec > 0 ? sec / ssec : 0, 0 };
+                report_row(rep, &srow);
+            }
+            free(envs);
+            free(push);
+
+            int nmat = mjaccess_batched_render_setup(sim, 0) >= 0
+                           ? mjaccess_batched_render_geoms(sim, NULL, 0) * ne : 0;
+            float* mats = nmat > 0 ? (float*)malloc((size_t)nmat * 16 * sizeof(float)) : NULL;
+            if (mats) {
+                const int reps = 200;
+                double m0 = now_sec();
+                for (int i = 0; i < reps; i++)
+                    mjaccess_batched_render_matrices(sim, NULL, ne, NULL, mats, nmat);
+                BenchRow mrow = { bm->name, "render_matrices", ne, nt, reps, now_sec() - m0,
+                                  0, (double)nmat * 16 * sizeof(float) };
+                report_row(rep, &mrow);
+                free(mats);
+            }
+
+            if (t == 0) {
+                const int reps = 200;
+                for (size_t g = 0; g < sizeof(k_gathers) / sizeof(k_gathers[0]); g++) {
+                    int n = 0;
+                    k_gathers[g].fn(sim, &n);
+                    double g0 = now_sec();
+                    for (int i = 0; i < reps; i++) k_gathers[g].fn(sim, &n);
+                    BenchRow grow = { bm->name, k_gathers[g].name, ne, nt, reps, now_sec() - g0,
+                                      0, (double)n * sizeof(double) };
+                    report_row(rep, &grow);
+                }
+            }
+            mjaccess_batched_free(sim);
+        }
+        free(ctrl);
+    }
+    mjaccess_free_model(model);
+}
+
+// ── Command line ─────────────────────────────────────────────
+
+static int parse_list(const char* arg, int* out) {
+    int n = 0;
+    while (*arg && n < MAX_LIST) {
+        int v = atoi(arg);
+        if (v > 0) out[n++] = v;
+        const char* comma = strchr(arg, ',');
+        if (!comma) break;
+        arg = comma + 1;
+    }
+    return n;
+}
+
+static int model_selected(const char* list, const char* name) {
+    if (!list) return 1;
+    size_t len = strlen(name);
+    for (const char* p = list; (p = strstr(p, name)) != NULL; p += len) {
+        if ((p == list || p[-1] == ',') && (p[len] == ',' || p[len] == '\0')) return 1;
+    }
+    return 0;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--models a,b] [--envs 1,16,64,256] [--threads 1,2,4,8]\n"
+            "          [--steps N] [--format csv|json] [--out file] [--record file]\n"
+            "models: pendulum, humanoid, boxpile, terrain\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* models = NULL;
+    const char* out_path = NULL;
+    const char* record = NULL;
+    int envs[MAX_LIST] = { 1, 16, 64, 256 };
+    int n_envs = 4;
+    int threads[MAX_LIST];
+    int n_threads = 0;
+    int steps = 20000;
+    int json = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(a, "--models") == 0 && v) { models = v; i++; }
+        else if (strcmp(a, "--envs") == 0 && v) { n_envs = parse_list(v, envs); i++; }
+        else if (strcmp(a, "--threads") == 0 && v) { n_threads = parse_list(v, threads); i++; }
+        else if (strcmp(a, "--steps") == 0 && v) { steps = atoi(v); i++; }
+        else if (strcmp(a, "--format") == 0 && v) { json = strcmp(v, "json") == 0; i++; }
+        else if (strcmp(a, "--out") == 0 && v) { out_path = v; i++; }
+        else if (strcmp(a, "--record") == 0 && v) { record = v; i++; }
+        else { usage(argv[0]); return 2; }
+    }
+    if (n_threads == 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        for (int t = 1; t <= ncpu && n_threads < MAX_LIST; t *= 2) threads[n_threads++] = t;
+        if (ncpu > 1 && threads[n_threads - 1] != ncpu && n_threads < MAX_LIST)
+            threads[n_threads++] = (int)ncpu;
+    }
+    if (n_envs == 0 || steps <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    BenchReport rep = { stdout, json, 0 };
+    if (out_path) {
+        rep.out = fopen(out_path, "w");
+        if (!rep.out) {
+            fprintf(stderr, "mjaccess_bench: cannot open %s\n", out_path);
+            return 1;
+        }
+    }
+    mjaccess_model_cache_set_dir(NULL);  // time the compiler, not the cache
+
+    BenchModel bench_models[] = {
+        { "pendulum", (char*)k_pendulum_xml },
+        { "humanoid", (char*)k_humanoid_xml },
+        { "boxpile",  make_boxpile_xml() },
+        { "terrain",  (char*)k_terrain_xml },
+    };
+    report_begin(&rep);
+    int status = 0;
+    for (size_t m = 0; m < sizeof(bench_models) / sizeof(bench_models[0]); m++) {
+        const BenchModel* bm = &bench_models[m];
+        if (!model_selected(models, bm->name)) continue;
+        MjAccessModel* probe = bm->xml ? load_bench_model(bm) : NULL;
+        if (!probe) {
+            fprintf(stderr, "mjaccess_bench: failed to load model '%s'\n", bm->name);
+            status = 1;
+            continue;
+        }
+        mjaccess_free_model(probe);
+        bench_load(&rep, bm);
+        bench_step(&rep, bm, steps);
+        bench_batched(&rep, bm, envs, n_envs, threads, n_threads, steps, record);
+        if (strcmp(bm->name, "terrain") == 0) bench_terrain(&rep, bm);
+    }
+    report_end(&rep);
+
+    free(bench_models[2].xml);
+    if (rep.out != stdout) fclose(rep.out);
+    return status;
+}
@@ -3,82 +3,989 @@
 //
 // Thin C accessor shim over MuJoCo's mjModel/mjData.
 // All getters return native double* -- zero conversion.
-// Batched stepping uses GCD dispatch_apply.
+// Batched stepping runs on a persistent pthread worker pool.
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // sched_setaffinity / CPU_SET
+#endif
 
 #include "mjaccess.h"
 #include <mujoco/mujoco.h>
-#ifdef __APPLE__
-#include <dispatch/dispatch.h>
-#endif
+#include <float.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#ifndef _WIN32
+#define MJA_HAVE_THREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <time.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <direct.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// ── Worker pool ──────────────────────────────────────────────
+//
+// Persistent workers created once per batched sim. A job covers [0, n) and
+// is pre-split into one contiguous range per worker; each worker claims
+// fixed-size chunks from its own range first and then steals chunks from the
+// other ranges, so envs with expensive contacts do not leave cores idle.
+// The calling thread participates as worker 0. Without pthreads (Windows)
+// every job runs inline on the caller.
+
+typedef void (*MjaTaskFn)(void* ctx, int begin, int end, int worker);
+
+typedef struct {
+    atomic_int next;
+    int        end;
+    char       pad[64 - sizeof(atomic_int) - sizeof(int)];  // one range per cache line
+} MjaRange;
+
+typedef struct {
+    int        num_threads;  // total workers, including the caller
+    int        chunk_size;   // 0 = auto per job
+    int        pin_threads;
+    int        cpu_offset;
+    MjaRange*  ranges;       // [num_threads]
+    int        job_chunk;
+    MjaTaskFn  job_fn;
+    void*      job_ctx;
+#ifdef MJA_HAVE_THREADS
+    pthread_t*      threads;  // [num_threads - 1]
+    pthread_mutex_t mutex;
+    pthread_cond_t  wake;
+    pthread_cond_t  done;
+    unsigned long   generation;
+    int             shutdown;
+    atomic_int      pending;  // background workers still inside the current job
+#endif
+} MjaPool;
+
+static int mja_online_cpus(void) {
+#ifdef MJA_HAVE_THREADS
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+static void pool_work(MjaPool* pool, int worker) {
+    int nt = pool->num_threads;
+    int chunk = pool->job_chunk;
+    for (int k = 0; k < nt; k++) {
+        MjaRange* r = &pool->ranges[(worker + k) % nt];
+        for (;;) {
+            int b = atomic_fetch_add_explicit(&r->next, chunk, memory_order_relaxed);
+            if (b >= r->end) break;
+            int e = b + chunk < r->end ? b + chunk : r->end;
+            pool->job_fn(pool->job_ctx, b, e, worker);
+        }
+    }
+}
+
+#ifdef MJA_HAVE_THREADS
+typedef struct {
+    MjaPool* pool;
+    int      worker;
+} MjaWorkerArg;
+
+static void pool_pin_current_thread(const MjaPool* pool, int worker) {
+#ifdef __linux__
+    if (!pool->pin_threads) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((pool->cpu_offset + worker) % mja_online_cpus(), &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)pool; (void)worker;  // no hard affinity on Apple platforms
+#endif
+}
+
+static void* pool_thread_main(void* arg) {
+    MjaWorkerArg a = *(MjaWorkerArg*)arg;
+    free(arg);
+    MjaPool* pool = a.pool;
+    pool_pin_current_thread(pool, a.worker);
+
+    unsigned long seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&pool->mutex);
+        while (!pool->shutdown && pool->generation == seen)
+            pthread_cond_wait(&pool->wake, &pool->mutex);
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+
+        pool_work(pool, a.worker);
+
+        if (atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_acq_rel) == 1) {
+            pthread_mutex_lock(&pool->mutex);
+            pthread_cond_signal(&pool->done);
+            pthread_mutex_unlock(&pool->mutex);
+        }
+    }
+    return NULL;
+}
+#endif
+
+static void pool_destroy(MjaPool* pool);
+
+static MjaPool* pool_create(int num_threads, int chunk_size, int pin_threads, int cpu_offset) {
+#ifndef MJA_HAVE_THREADS
+    num_threads = 1;
+#endif
+    if (num_threads < 1) num_threads = 1;
+    MjaPool* pool = (MjaPool*)calloc(1, sizeof(MjaPool));
+    if (!pool) return NULL;
+    pool->num_threads = num_threads;
+    pool->chunk_size  = chunk_size > 0 ? chunk_size : 0;
+    pool->pin_threads = pin_threads;
+    pool->cpu_offset  = cpu_offset > 0 ? cpu_offset : 0;
+    pool->ranges = (MjaRange*)calloc(num_threads, sizeof(MjaRange));
+    if (!pool->ranges) { free(pool); return NULL; }
+#ifdef MJA_HAVE_THREADS
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    atomic_init(&pool->pending, 0);
+    if (num_threads > 1) {
+        pool->threads = (pthread_t*)calloc(num_threads - 1, sizeof(pthread_t));
+        for (int w = 1; w < num_threads; w++) {
+            MjaWorkerArg* arg = pool->threads ? (MjaWorkerArg*)malloc(sizeof(MjaWorkerArg)) : NULL;
+            if (!arg) {
+                pool->num_threads = w;  // join the workers started so far
+                pool_destroy(pool);
+                return NULL;
+            }
+            arg->pool = pool;
+            arg->worker = w;
+            if (pthread_create(&pool->threads[w - 1], NULL, pool_thread_main, arg) != 0) {
+                free(arg);
+                pool->num_threads = w;  // keep the workers that did start
+                break;
+            }
+        }
+    }
+#endif
+    return pool;
+}
+
+static void pool_destroy(MjaPool* pool) {
+    if (!pool) return;
+#ifdef MJA_HAVE_THREADS
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+    for (int w = 1; w < pool->num_threads; w++)
+        pthread_join(pool->threads[w - 1], NULL);
+    free(pool->threads);
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->mutex);
+#endif
+    free(pool->ranges);
+    free(pool);
+}
+
+// Run fn over [0, n) on all workers and return once every index is done.
+// bounds (optional, [num_threads + 1]) overrides the even split: worker w
+// starts on [bounds[w], bounds[w + 1]) before stealing.
+static void pool_run_split(MjaPool* pool, int n, const int* bounds, MjaTaskFn fn, void* ctx) {
+    if (n <= 0) return;
+    int nt = pool ? pool->num_threads : 1;
+    if (nt <= 1 || n == 1) {
+        fn(ctx, 0, n, 0);
+        return;
+    }
+
+    int chunk = pool->chunk_size;
+    if (chunk <= 0) {
+        chunk = n / (nt * 8);  // ~8 chunks per worker leaves room to steal
+        if (bounds) {
+            for (int w = 0; w < nt; w++) {
+                int len = bounds[w + 1] - bounds[w];
+                if (len > 0 && len / 4 < chunk) chunk = len / 4;
+            }
+        }
+        if (chunk < 1) chunk = 1;
+    }
+    pool->job_chunk = chunk;
+    pool->job_fn = fn;
+    pool->job_ctx = ctx;
+    for (int w = 0; w < nt; w++) {
+        int b = bounds ? bounds[w] : (int)((long long)n * w / nt);
+        int e = bounds ? bounds[w + 1] : (int)((long long)n * (w + 1) / nt);
+        atomic_store_explicit(&pool->ranges[w].next, b, memory_order_relaxed);
+        pool->ranges[w].end = e;
+    }
+
+#ifdef MJA_HAVE_THREADS
+    atomic_store_explicit(&pool->pending, nt - 1, memory_order_relaxed);
+    pthread_mutex_lock(&pool->mutex);
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    pool_work(pool, 0);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (atomic_load_explicit(&pool->pending, memory_order_acquire) > 0)
+        pthread_cond_wait(&pool->done, &pool->mutex);
+    pthread_mutex_unlock(&pool->mutex);
+#else
+    pool_work(pool, 0);
+#endif
+}
+
+static void pool_run(MjaPool* pool, int n, MjaTaskFn fn, void* ctx) {
+    pool_run_split(pool, n, NULL, fn, ctx);
+}
 
 // ── Opaque struct definitions ────────────────────────────────
 
 struct MjAccessModel {
     mjModel* mj;
+    mjSpec*  spec;        // kept by editable models, NULL otherwise
+    // batched sims and terrains made from mj; they keep pointers into it, so
+    // recompile and reload refuse while any exist
+    int      dependents;
+    unsigned generation;  // bumped whenever mj is recompiled or replaced
+    int      from_cache;  // mj came from the compiled-model cache: no last XML
 };
 
+typedef struct MjaFd MjaFd;
+static void fd_free(MjaFd* fd);
+
+// Contact filter: a contact passes when one geom is in side 0 and the other
+// in side 1. A side with no registered objects matches every geom.
+typedef struct {
+    unsigned char* geom_side;  // [ngeom] bit s set = geom in side s
+    int            ngeom;
+    int            any[2];
+} MjaContactFilter;
+
 struct MjAccessData {
     mjData*  mj;
     mjModel* model_ref;  // non-owning
+    MjaFd*   fd;         // transition_fd pool and scratch, NULL until first use
+    MjaContactFilter contact_filter;
+    // frames bound by mjaccess_bind_transforms
+    int*     xf_type;    // [xf_n] mjtObj
+    int*     xf_id;      // [xf_n]
+    float*   xf_offset;  // [xf_n * 7] local offsets, NULL = none
+    int      xf_n;
+};
+
+// mjData arrays an observation plan reads from.
+enum {
+    MJA_OBS_SRC_QPOS = 0,
+    MJA_OBS_SRC_QVEL,
+    MJA_OBS_SRC_CTRL,
+    MJA_OBS_SRC_XPOS,
+    MJA_OBS_SRC_XQUAT,
+    MJA_OBS_SRC_CVEL,
+    MJA_OBS_SRC_SUBTREE_COM,
+    MJA_OBS_SRC_CFRC_EXT,
+    MJA_OBS_SRC_SITE_XPOS,
+    MJA_OBS_SRC_GEOM_XPOS,
+    MJA_OBS_SRC_SENSORDATA
 };
 
+// One contiguous copy of an observation plan: len doubles from an mjData
+// array (src) at src_off into the float row at dst_off.
+typedef struct {
+    int src;
+    int src_off;
+    int len;
+    int dst_off;
+} MjaObsRun;
+
+// Running per-feature moments (Welford). Workers accumulate the rows they
+// gather into their own partial, which the caller folds into the totals after
+// the job (Chan et al. pairwise merge).
+typedef struct {
+    double  count;
+    double* mean;  // [dim]
+    double* m2;    // [dim] sum of squared deviations from the mean
+    char    pad[64 - sizeof(double) - 2 * sizeof(double*)];  // one partial per cache line
+} MjaMoments;
+
+typedef struct {
+    MjAccessProfile p;
+    double          busy_ms;
+    char            pad[64 - sizeof(double)];  // keep workers off each other's lines
+} MjaProfileAcc;
+
+typedef struct MjaRecorder MjaRecorder;
+
+// Queued physics-thread command; its values live in the list's value buffer.
+typedef struct {
+    int type;
+    int offset;
+    int n;
+    int value_off;
+} MjaCmd;
+
+typedef struct {
+    MjaCmd* cmds;
+    int     n, cap;
+    double* values;
+    int     nvalues, values_cap;
+} MjaCmdList;
+
+// One staged batched scatter call; its lists and values live in the sim's buffers.
+typedef struct {
+    int field;      // MJA_CMD_* data array
+    int n_envs;
+    int n;          // values per env
+    int envs_off;   // into scatter_ints
+    int elems_off;  // into scatter_ints, -1 = elements [0, n)
+    int values_off; // into scatter_values, [n_envs][n]
+} MjaScatter;
+
+static void batched_scatter_flush(MjAccessBatchedSim* sim);
+
 struct MjAccessBatchedSim {
+    MjAccessModel* owner;  // counts this sim as a dependent
     mjModel*  model_ref;  // non-owning
     int       num_envs;
     mjData**  datas;       // array of num_envs mjData*
-    // contiguous gather buffers for batched getters
-    double*   qpos_buf;
-    double*   qvel_buf;
-    double*   xpos_buf;
-    double*   subtree_com_buf;
-    double*   cinert_buf;
-    double*   cvel_buf;
-    double*   qfrc_actuator_buf;
-    double*   cfrc_ext_buf;
+    MjaPool*  pool;
+    int       owns_pool;   // 0 = borrowed from a multi-model sim
+    // [num_envs * dim] buffers for batched getters. With contiguous_state
+    // these are the state slabs themselves: each env's mjData field pointer
+    // is redirected into its row, so getters return them without copying.
+    int       contiguous;
+    int       dims[MJA_FIELD_COUNT];
+    double*   bufs[MJA_FIELD_COUNT];
+    void*     slab_arena;
+    // caller-owned [num_envs * dim] destinations filled by the step workers
+    unsigned  output_mask;
+    double*   outputs[MJA_FIELD_COUNT];
+    // initial-state snapshot pool (mj_getState layout, snap_size doubles each)
+    unsigned  snap_spec;
+    int       snap_size;
+    int       snap_count;
+    int       snap_capacity;
+    double*   snaps;
+    // auto-reset
+    int       detect_bad_state;
+    uint64_t* rng;           // [num_envs] snapshot selection streams
+    int*      done;          // [num_envs] caller done mask, consumed by the next step
+    int*      done_index;    // [num_envs] snapshot per done env, -1 = random
+    int       done_pending;
+    int*      reset_flags;   // [num_envs] 1 if the last step/reset restarted the env
+    // active-env mask: steps visit the compacted active list only
+    unsigned char* active;   // [num_envs] 1 = stepped, NULL = all active
+    int*      active_envs;   // [num_envs] ascending; the first active_count are live
+    int       active_count;
+    // observation plan -> packed float32 [num_envs * obs_dim]
+    MjaObsRun* obs_runs;
+    int        obs_nruns;
+    int        obs_cap;
+    int        obs_dim;
+    float*     obs_buf;      // internal destination
+    float*     obs_out;      // obs_buf or a caller-bound buffer
+    // running normalization; the obs tensor holds normalized values when enabled
+    int         norm_frozen;
+    int         obs_norm;
+    float       obs_clip;    // FLT_MAX = no clipping
+    double      obs_eps;
+    MjaMoments  obs_stats;
+    MjaMoments* obs_parts;   // [num_threads] partials of the running job
+    float*      obs_shift;   // [obs_dim] mean
+    float*      obs_scale;   // [obs_dim] 1 / sqrt(var + eps)
+    void*       obs_norm_arena;
+    double*     rew_ret;     // [num_envs] discounted returns, NULL = reward norm off
+    float       rew_gamma;
+    float       rew_clip;
+    double      rew_eps;
+    double      rew_count;
+    double      rew_mean;
+    double      rew_m2;
+    // domain randomization: per-env copies of selected model arrays. Each
+    // worker steps against its own shallow mjModel whose randomized array
+    // pointers are aimed at the current env's row.
+    int         param_dim[MJA_PARAM_COUNT];  // per-env row length
+    double*     params[MJA_PARAM_COUNT];     // [num_envs * param_dim], NULL = shared
+    int         params_on;
+    mjModel*    env_models;                  // [num_threads]
+    double*     subtreemass;                 // [num_envs * nbody] with body mass randomized
+    int         subtreemass_stale;           // mass table handed out: resum before every job
+    MjAccessRandTerm* rand_terms;
+    int         rand_nterms;
+    int         rand_cap;
+    int         rand_on_reset;
+    uint64_t*   rand_rng;                    // [num_envs] resampling streams
+    // profiling: NULL = off
+    MjaProfileAcc* prof;      // [num_threads]
+    mjTimerStat*   prof_seen; // [num_envs * mjNTIMER] env timers at the last harvest
+    long long   prof_jobs;
+    double      prof_wall_ms;
+    // trajectory recording: NULL = off
+    MjaRecorder* rec;
+    // transition_fd scratch on the sim's pool, NULL until first use
+    MjaFd*      fd;
+    // contact export: filled by the workers after every step/reset, cap 0 = off
+    MjaContactFilter contact_filter;
+    int         contact_cap;
+    MjAccessContact* contacts;   // [num_envs * contact_cap]
+    int*        contact_counts;  // [num_envs] contacts written per env
+    // scatter writes staged for the next step or reset, applied call by call on the pool
+    MjaScatter* scatter;
+    int         scatter_n, scatter_cap;
+    int*        scatter_ints;    // env and element lists
+    int         scatter_nints, scatter_ints_cap;
+    double*     scatter_values;
+    int         scatter_nvalues, scatter_values_cap;
+    unsigned char* scatter_seen; // [num_envs] duplicate-env check
+    // instanced rendering batches
+    MjAccessRenderBatch* render_batches;  // [render_nbatches]
+    int         render_nbatches;
+    int         render_total;             // geoms per env over all batches
+    int*        render_geoms;             // [render_total] in batch order
+    float*      render_scale;             // [render_total * 3] Unity-axis scale
+    // async stepping: one job in flight, run by a driver thread as worker 0
+    double*     async_ctrl;     // [num_envs * nu] staged ctrl
+    int         async_first;
+    int         async_count;
+    int         async_substeps;
+    atomic_int  async_busy;
+#ifdef MJA_HAVE_THREADS
+    int             async_started;
+    int             async_pending;
+    int             async_quit;
+    pthread_t       async_thread;
+    pthread_mutex_t async_mutex;
+    pthread_cond_t  async_cv;
+#endif
 };
 
+struct MjAccessMultiSim {
+    MjaPool*             pool;
+    int                  ngroups;
+    int                  cap;
+    MjAccessBatchedSim** groups;     // [ngroups], share `pool`
+    int*                 env_first;  // [ngroups + 1] prefix of env counts
+    int*                 ctrl_first; // [ngroups + 1] prefix of ctrl sizes
+    double*              cost_ns;    // [ngroups] smoothed ns per env step, 0 = unmeasured
+    double*              acc;        // per worker: {ns, count} per group, cache-line padded
+    int                  acc_stride; // groups per worker block
+    int*                 sorted;     // [ngroups] groups by descending cost
+    int*                 env_group;  // [total envs] group of each global env index
+    int*                 order;      // [total envs] cost-sorted global env indices
+    int*                 bounds;     // [num_threads + 1] per-worker ranges of `order`
+};
+
+// ── Compiled-model cache ─────────────────────────────────────
+//
+// Optional on-disk cache of compiled models, keyed by a hash of the MJCF
+// text (plus the file path for path loads) and the MuJoCo version. A hit
+// loads the mj_saveModel binary through a VFS buffer and skips the XML
+// compiler. Assets referenced by file name are not part of the key.
+
+static char         g_cache_dir[1024];
+static atomic_llong g_cache_hits;
+static atomic_llong g_cache_misses;
+static atomic_llong g_cache_stores;
+static atomic_llong g_compile_ns;
+static atomic_llong g_cache_load_ns;
+
+static long long mja_now_ns(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (long long)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+// FNV-1a, 64 bit.
+static uint64_t mja_hash(uint64_t h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+static uint64_t model_cache_key(const char* path, const char* xml, size_t len) {
+    int version = mj_version();
+    int num_size = (int)sizeof(mjtNum);
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = mja_hash(h, &version, sizeof(version));
+    h = mja_hash(h, &num_size, sizeof(num_size));
+    if (path) h = mja_hash(h, path, strlen(path) + 1);
+    return mja_hash(h, xml, len);
+}
+
+static char* mja_read_file(const char* path, size_t* len) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    char* buf = NULL;
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+    if (size >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+        buf = (char*)malloc((size_t)size + 1);
+        if (buf && fread(buf, 1, (size_t)size, f) != (size_t)size) {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(f);
+    if (buf) {
+        buf[size] = '\0';
+        *len = (size_t)size;
+    }
+    return buf;
+}
+
+static void model_cache_path(char* out, size_t cap, uint64_t key) {
+    snprintf(out, cap, "%s/%016llx.mjb", g_cache_dir, (unsigned long long)key);
+}
+
+static mjModel* model_cache_load(uint64_t key) {
+    char path[1100];
+    model_cache_path(path, sizeof(path), key);
+    long long t0 = mja_now_ns();
+    size_t len = 0;
+    char* buf = mja_read_file(path, &len);
+    mjModel* mj = NULL;
+    if (buf && len > 0) {
+        mjVFS vfs;
+        mj_defaultVFS(&vfs);
+        if (mj_addBufferVFS(&vfs, "model.mjb", buf, (int)len) == 0)
+            mj = mj_loadModel("model.mjb", &vfs);
+        mj_deleteVFS(&vfs);
+    }
+    free(buf);
+    if (mj) {
+        atomic_fetch_add(&g_cache_hits, 1);
+        atomic_fetch_add(&g_cache_load_ns, mja_now_ns() - t0);
+    } else {
+        atomic_fetch_add(&g_cache_misses, 1);
+    }
+    return mj;
+}
+
+// Written to a temporary name and renamed, so concurrent loaders never see
+// a partial binary.
+static void model_cache_store(const mjModel* mj, uint64_t key) {
+    int size = mj_sizeModel(mj);
+    void* buf = size > 0 ? malloc(size) : NULL;
+    if (!buf) return;
+    mj_saveModel(mj, NULL, buf, size);
+
+    char path[1100], tmp[1200];
+    model_cache_path(path, sizeof(path), key);
+    snprintf(tmp, sizeof(tmp), "%s.%llx.tmp", path, (unsigned long long)mja_now_ns());
+    FILE* f = fopen(tmp, "wb");
+    int ok = f && fwrite(buf, 1, (size_t)size, f) == (size_t)size;
+    if (f && fclose(f) != 0) ok = 0;
+    free(buf);
+    if (ok && rename(tmp, path) == 0) {
+        atomic_fetch_add(&g_cache_stores, 1);
+    } else {
+        remove(tmp);
+    }
+}
+
+static mjModel* model_compile(const char* filename, const mjVFS* vfs, char* error, int error_sz) {
+    long long t0 = mja_now_ns();
+    mjModel* mj = mj_loadXML(filename, vfs, error, error_sz);
+    atomic_fetch_add(&g_compile_ns, mja_now_ns() - t0);
+    return mj;
+}
+
+MJA_API int mjaccess_model_cache_set_dir(const char* dir) {
+    if (!dir || !dir[0]) {
+        g_cache_dir[0] = '\0';
+        return 0;
+    }
+    size_t len = strlen(dir);
+    while (len > 1 && (dir[len - 1] == '/' || dir[len - 1] == '\\')) len--;
+    if (len >= sizeof(g_cache_dir)) return -1;
+    memcpy(g_cache_dir, dir, len);
+    g_cache_dir[len] = '\0';
+#ifdef _WIN32
+    _mkdir(g_cache_dir);
+#else
+    mkdir(g_cache_dir, 0755);
+#endif
+    return 0;
+}
+
+MJA_API void mjaccess_model_cache_get_stats(MjAccessModelCacheStats* out) {
+    if (!out) return;
+    out->hits       = atomic_load(&g_cache_hits);
+    out->misses     = atomic_load(&g_cache_misses);
+    out->stores     = atomic_load(&g_cache_stores);
+    out->compile_ms = atomic_load(&g_compile_ns) * 1e-6;
+    out->load_ms    = atomic_load(&g_cache_load_ns) * 1e-6;
+}
+
+MJA_API void mjaccess_model_cache_reset_stats(void) {
+    atomic_store(&g_cache_hits, 0);
+    atomic_store(&g_cache_misses, 0);
+    atomic_store(&g_cache_stores, 0);
+    atomic_store(&g_compile_ns, 0);
+    atomic_store(&g_cache_load_ns, 0);
+}
+
 // ── Model lifecycle ──────────────────────────────────────────
 
 MJA_API MjAccessModel* mjaccess_load_model(const char* xml_path) {
     if (!xml_path) return NULL;
     char error[1000] = "";
-    mjModel* mj = mj_loadXML(xml_path, NULL, error, sizeof(error));
+    mjModel* mj = NULL;
+    uint64_t key = 0;
+    int cached = 0;
+    if (g_cache_dir[0]) {
+        size_t len = 0;
+        char* xml = mja_read_file(xml_path, &len);
+        if (xml) {
+            key = model_cache_key(xml_path, xml, len);
+            cached = 1;
+            free(xml);
+            mj = model_cache_load(key);
+        }
+    }
+    int compiled = !mj;
+    if (compiled) {
+        mj = model_compile(xml_path, NULL, error, sizeof(error));
+        if (mj && cached) model_cache_store(mj, key);
+    }
     if (!mj) {
         fprintf(stderr, "mjaccess_load_model error: %s\n", error);
         return NULL;
     }
     MjAccessModel* m = (MjAccessModel*)calloc(1, sizeof(MjAccessModel));
     m->mj = mj;
+    m->from_cache = !compiled;
     return m;
 }
 
+static mjModel* model_load_string(const char* xml_string, char* error, int error_sz,
+                                  int* from_cache) {
+    int len = (int)strlen(xml_string);
+    mjModel* mj = NULL;
+    uint64_t key = 0;
+    if (g_cache_dir[0]) {
+        key = model_cache_key(NULL, xml_string, (size_t)len);
+        mj = model_cache_load(key);
+    }
+    *from_cache = mj != NULL;
+    if (!mj) {
+        mjVFS vfs;
+        mj_defaultVFS(&vfs);
+        mj_addBufferVFS(&vfs, "model.xml", xml_string, len);
+        mj = model_compile("model.xml", &vfs, error, error_sz);
+        mj_deleteVFS(&vfs);
+        if (mj && g_cache_dir[0]) model_cache_store(mj, key);
+    }
+    return mj;
+}
+
+static mjModel* model_compile_spec(mjSpec* spec) {
+    long long t0 = mja_now_ns();
+    mjModel* mj = mj_compile(spec, NULL);
+    atomic_fetch_add(&g_compile_ns, mja_now_ns() - t0);
+    return mj;
+}
+
 MJA_API MjAccessModel* mjaccess_load_model_from_string(const char* xml_string) {
     if (!xml_string) return NULL;
     char error[1000] = "";
-    mjVFS vfs;
-    mj_defaultVFS(&vfs);
-    int len = (int)strlen(xml_string);
-    mj_addBufferVFS(&vfs, "model.xml", xml_string, len);
-    mjModel* mj = mj_loadXML("model.xml", &vfs, error, sizeof(error));
-    mj_deleteVFS(&vfs);
+    int from_cache;
+    mjModel* mj = model_load_string(xml_string, error, sizeof(error), &from_cache);
     if (!mj) {
         fprintf(stderr, "mjaccess_load_model_from_string error: %s\n", error);
         return NULL;
     }
     MjAccessModel* m = (MjAccessModel*)calloc(1, sizeof(MjAccessModel));
     m->mj = mj;
+    m->from_cache = from_cache;
     return m;
 }
 
 MJA_API void mjaccess_free_model(MjAccessModel* model) {
     if (!model) return;
     if (model->mj) mj_deleteModel(model->mj);
+    if (model->spec) mj_deleteSpec(model->spec);
     free(model);
 }
 
+// ── Incremental scene edits ──────────────────────────────────
+//
+// Editable models keep the mjSpec they were compiled from. Edits touch only
+// the spec; mjaccess_spec_recompile then rebuilds mjModel/mjData in place
+// with mj_recompile, which carries the state of surviving elements over.
+
+MJA_API MjAccessModel* mjaccess_load_model_editable(const char* xml_string) {
+    if (!xml_string) return NULL;
+    char error[1000] = "";
+    mjSpec* spec = mj_parseXMLString(xml_string, NULL, error, sizeof(error));
+    if (!spec) {
+        fprintf(stderr, "mjaccess_load_model_editable error: %s\n", error);
+        return NULL;
+    }
+    mjModel* mj = model_compile_spec(spec);
+    if (!mj) {
+        fprintf(stderr, "mjaccess_load_model_editable error: %s\n", mjs_getError(spec));
+        mj_deleteSpec(spec);
+        return NULL;
+    }
+    MjAccessModel* m = (MjAccessModel*)calloc(1, sizeof(MjAccessModel));
+    m->mj = mj;
+    m->spec = spec;
+    return m;
+}
+
+MJA_API int mjaccess_model_is_editable(const MjAccessModel* model) {
+    return (model && model->spec) ? 1 : 0;
+}
+
+static mjsElement* spec_find(MjAccessModel* model, int obj_type, const char* name) {
+    if (!model || !model->spec || !name) return NULL;
+    return mjs_findElement(model->spec, obj_type, name);
+}
+
+MJA_API int mjaccess_spec_delete(MjAccessModel* model, int obj_type, const char* name) {
+    mjsElement* el = spec_find(model, obj_type, name);
+    if (!el) return -1;
+    return mjs_delete(model->spec, el) == 0 ? 0 : -1;
+}
+
+MJA_API int mjaccess_spec_add_body(MjAccessModel* model, const char* parent, const char* name,
+                                   const double* pos3, const double* quat4) {
+    if (!model || !model->spec || !name) return -1;
+    mjsBody* p = mjs_findBody(model->spec, parent ? parent : "world");
+    mjsBody* b = p ? mjs_addBody(p, NULL) : NULL;
+    if (!b) return -1;
+    mjs_setName(b->element, name);
+    if (pos3) memcpy(b->pos, pos3, 3 * sizeof(double));
+    if (quat4) memcpy(b->quat, quat4, 4 * sizeof(double));
+    return 0;
+}
+
+MJA_API int mjaccess_spec_add_geom(MjAccessModel* model, const char* body, const char* name,
+                                   int geom_type, const double* size3, const double* pos3) {
+    if (!model || !model->spec || !body) return -1;
+    mjsBody* b = mjs_findBody(model->spec, body);
+    mjsGeom* g = b ? mjs_addGeom(b, NULL) : NULL;
+    if (!g) return -1;
+    if (name) mjs_setName(g->element, name);
+    g->type = geom_type;
+    if (size3) memcpy(g->size, size3, 3 * sizeof(double));
+    if (pos3) memcpy(g->pos, pos3, 3 * sizeof(double));
+    return 0;
+}
+
+// Write up to `width` leading values of an attribute (e.g. just a sphere's radius).
+static int spec_copy(double* dst, int width, const double* values, int n) {
+    if (n < 1 || n > width) return -1;
+    memcpy(dst, values, n * sizeof(double));
+    return 0;
+}
+
+static int spec_copy_f(float* dst, int width, const double* values, int n) {
+    if (n < 1 || n > width) return -1;
+    for (int i = 0; i < n; i++) dst[i] = (float)values[i];
+    return 0;
+}
+
+MJA_API int mjaccess_spec_set_attr(MjAccessModel* model, int obj_type, const char* name,
+                                   int attr, const double* values, int n) {
+    mjsElement* el = spec_find(model, obj_type, name);
+    if (!el || !values) return -1;
+    switch (obj_type) {
+    case mjOBJ_BODY: {
+        mjsBody* b = mjs_asBody(el);
+        if (!b) return -1;
+        switch (attr) {
+        case MJA_SPEC_POS:  return spec_copy(b->pos, 3, values, n);
+        case MJA_SPEC_QUAT: return spec_copy(b->quat, 4, values, n);
+        case MJA_SPEC_MASS: return spec_copy(&b->mass, 1, values, n);
+        default:            return -1;
+        }
+    }
+    case mjOBJ_GEOM: {
+        mjsGeom* g = mjs_asGeom(el);
+        if (!g) return -1;
+        switch (attr) {
+        case MJA_SPEC_POS:      return spec_copy(g->pos, 3, values, n);
+        case MJA_SPEC_QUAT:     return spec_copy(g->quat, 4, values, n);
+        case MJA_SPEC_SIZE:     return spec_copy(g->size, 3, values, n);
+        case MJA_SPEC_MASS:     return spec_copy(&g->mass, 1, values, n);
+        case MJA_SPEC_FRICTION: return spec_copy(g->friction, 3, values, n);
+        case MJA_SPEC_RGBA:     return spec_copy_f(g->rgba, 4, values, n);
+        default:                return -1;
+        }
+    }
+    case mjOBJ_SITE: {
+        mjsSite* st = mjs_asSite(el);
+        if (!st) return -1;
+        switch (attr) {
+        case MJA_SPEC_POS:  return spec_copy(st->pos, 3, values, n);
+        case MJA_SPEC_QUAT: return spec_copy(st->quat, 4, values, n);
+        case MJA_SPEC_SIZE: return spec_copy(st->size, 3, values, n);
+        case MJA_SPEC_RGBA: return spec_copy_f(st->rgba, 4, values, n);
+        default:            return -1;
+        }
+    }
+    default:
+        return -1;
+    }
+}
+
+// Model-sized caches hanging off a data; rebuilt on demand after a recompile.
+static void data_drop_model_caches(MjAccessData* data) {
+    fd_free(data->fd);
+    data->fd = NULL;
+    free(data->contact_filter.geom_side);
+    memset(&data->contact_filter, 0, sizeof(data->contact_filter));
+}
+
+static int model_check_dependents(const MjAccessModel* model, const char* fn) {
+    if (!model->dependents) return 0;
+    fprintf(stderr, "%s error: %d batched sim(s) or terrain(s) still use the model\n", fn,
+            model->dependents);
+    return -1;
+}
+
+MJA_API int mjaccess_spec_recompile(MjAccessModel* model, MjAccessData* data) {
+    if (!model || !model->spec || !data || !data->mj) return -1;
+    if (model_check_dependents(model, "mjaccess_spec_recompile") != 0) return -1;
+    long long t0 = mja_now_ns();
+    int rc = mj_recompile(model->spec, NULL, model->mj, data->mj);
+    atomic_fetch_add(&g_compile_ns, mja_now_ns() - t0);
+    if (rc != 0) {
+        fprintf(stderr, "mjaccess_spec_recompile error: %s\n", mjs_getError(model->spec));
+        return -1;
+    }
+    data->model_ref = model->mj;
+    data_drop_model_caches(data);
+    model->generation++;
+    return 0;
+}
+
+// Copy old joint k's state onto new joint j (a changed joint type restarts
+// from qpos0).
+static void model_copy_joint_state(const mjModel* src_m, int k, const double* qpos,
+                                   const double* qvel, const mjModel* dst_m, int j, mjData* dst) {
+    if (k < 0 || k >= src_m->njnt || j < 0) return;
+    int type = dst_m->jnt_type[j];
+    if (src_m->jnt_type[k] != type) return;
+    int nq = type == mjJNT_FREE ? 7 : type == mjJNT_BALL ? 4 : 1;
+    int nv = type == mjJNT_FREE ? 6 : type == mjJNT_BALL ? 3 : 1;
+    memcpy(dst->qpos + dst_m->jnt_qposadr[j], qpos + src_m->jnt_qposadr[k], nq * sizeof(double));
+    memcpy(dst->qvel + dst_m->jnt_dofadr[j], qvel + src_m->jnt_dofadr[k], nv * sizeof(double));
+}
+
+// Copy joint state between models: by the explicit new name -> old id pairs
+// when old_joint_ids is given (n may be 0), else by joint name.
+static void model_map_joint_state(const mjModel* src_m, const double* qpos, const double* qvel,
+                                  const mjModel* dst_m, mjData* dst,
+                                  const char* const* joint_names, const int* old_joint_ids, int n) {
+    if (old_joint_ids) {
+        for (int i = 0; i < n; i++) {
+            int j = joint_names[i] ? mj_name2id(dst_m, mjOBJ_JOINT, joint_names[i]) : -1;
+            model_copy_joint_state(src_m, old_joint_ids[i], qpos, qvel, dst_m, j, dst);
+        }
+        return;
+    }
+    for (int j = 0; j < dst_m->njnt; j++) {
+        const char* name = mj_id2name(dst_m, mjOBJ_JOINT, j);
+        if (!name || !name[0]) continue;
+        model_copy_joint_state(src_m, mj_name2id(src_m, mjOBJ_JOINT, name), qpos, qvel,
+                               dst_m, j, dst);
+    }
+}
+
+MJA_API int mjaccess_model_reload(MjAccessModel* model, MjAccessData* data, const char* xml_string,
+                                  const double* old_qpos, const double* old_qvel) {
+    return mjaccess_model_reload_mapped(model, data, xml_string, old_qpos, old_qvel,
+                                        NULL, NULL, 0);
+}
+
+// Full rebuild from regenerated MJCF that keeps the handles: compile the new
+// model (through the cache, or into a new spec for editable models), map the
+// joint state over natively and swap the new model/data into place.
+MJA_API int mjaccess_model_reload_mapped(MjAccessModel* model, MjAccessData* data,
+                                         const char* xml_string, const double* old_qpos,
+                                         const double* old_qvel, const char* const* joint_names,
+                                         const int* old_joint_ids, int n_joints) {
+    if (!model || !model->mj || !data || !data->mj || !xml_string) return -1;
+    if (n_joints < 0 || (n_joints > 0 && (!joint_names || !old_joint_ids))) return -1;
+    if (!old_joint_ids && joint_names) return -1;
+    if (model_check_dependents(model, "mjaccess_model_reload") != 0) return -1;
+    char error[1000] = "";
+    mjSpec* spec = NULL;
+    mjModel* mj;
+    int from_cache = 0;
+    if (model->spec) {
+        spec = mj_parseXMLString(xml_string, NULL, error, sizeof(error));
+        mj = spec ? model_compile_spec(spec) : NULL;
+        if (spec && !mj) snprintf(error, sizeof(error), "%s", mjs_getError(spec));
+    } else {
+        mj = model_load_string(xml_string, error, sizeof(error), &from_cache);
+    }
+    mjData* d = mj ? mj_makeData(mj) : NULL;
+    if (!d) {
+        fprintf(stderr, "mjaccess_model_reload error: %s\n", error);
+        if (mj) mj_deleteModel(mj);
+        if (spec) mj_deleteSpec(spec);
+        return -1;
+    }
+
+    model_map_joint_state(model->mj, old_qpos ? old_qpos : data->mj->qpos,
+                          old_qvel ? old_qvel : data->mj->qvel, mj, d,
+                          joint_names, old_joint_ids, n_joints);
+    d->time = data->mj->time;
+
+    mj_deleteData(data->mj);
+    mj_deleteModel(model->mj);
+    if (spec) {
+        mj_deleteSpec(model->spec);
+        model->spec = spec;
+    }
+    model->mj = mj;
+    model->from_cache = from_cache;
+    model->generation++;
+    data->mj = d;
+    data->model_ref = mj;
+    data_drop_model_caches(data);
+    return 0;
+}
+
 // ── Model accessors ──────────────────────────────────────────
 
 MJA_API MjAccessModelInfo mjaccess_model_info(const MjAccessModel* model) {
@@ -89,6 +996,7 @@ MJA_API MjAccessModelInfo mjaccess_model_info(const MjAccessModel* model) {
     info.nbody = m->nbody;  info.njnt = m->njnt;  info.ngeom = m->ngeom;
     info.nsite = m->nsite;  info.nmocap = m->nmocap;  info.ntendon = m->ntendon;
     info.nsensor = m->nsensor;  info.nsensordata = m->nsensordata;  info.neq = m->neq;
+    info.na = m->na;
     return info;
 }
 
@@ -192,6 +1100,30 @@ MJA_API void mjaccess_model_set_hfield_data(MjAccessModel* model, int offset,
     memcpy(model->mj->hfield_data + offset, values, count * sizeof(float));
 }
 
+// Copy a rows x cols block with source row pitch `stride` into rows
+// [row, row + rows) and cols [col, col + cols) of one hfield.
+static void hfield_write_rect(float* dst, int ncol, int row, int col, int rows, int cols,
+                              const float* src, int stride) {
+    for (int r = 0; r < rows; r++)
+        memcpy(dst + (size_t)(row + r) * ncol + col, src + (size_t)r * stride,
+               cols * sizeof(float));
+}
+
+MJA_API int mjaccess_model_set_hfield_rect(MjAccessModel* model, int hfield_id, int row, int col,
+                                           int rows, int cols, const float* values, int stride) {
+    if (!model || !model->mj || !values || hfield_id < 0 || hfield_id >= model->mj->nhfield)
+        return -1;
+    const mjModel* m = model->mj;
+    int nrow = m->hfield_nrow[hfield_id], ncol = m->hfield_ncol[hfield_id];
+    if (stride <= 0) stride = cols;
+    if (row < 0 || col < 0 || rows <= 0 || cols <= 0 || stride < cols ||
+        row + rows > nrow || col + cols > ncol)
+        return -1;
+    hfield_write_rect(m->hfield_data + m->hfield_adr[hfield_id], ncol, row, col, rows, cols,
+                      values, stride);
+    return 0;
+}
+
 // ── Data lifecycle ───────────────────────────────────────────
 
 MJA_API MjAccessData* mjaccess_make_data(MjAccessModel* model) {
@@ -207,6 +1139,11 @@ MJA_API MjAccessData* mjaccess_make_data(MjAccessModel* model) {
 MJA_API void mjaccess_free_data(MjAccessData* data) {
     if (!data) return;
     if (data->mj) mj_deleteData(data->mj);
+    fd_free(data->fd);
+    free(data->contact_filter.geom_side);
+    free(data->xf_type);
+    free(data->xf_id);
+    free(data->xf_offset);
     free(data);
 }
 
@@ -221,6 +1158,11 @@ MJA_API void mjaccess_step(MjAccessModel* model, MjAccessData* data) {
     if (model && model->mj && data && data->mj) mj_step(model->mj, data->mj);
 }
 
+MJA_API void mjaccess_step_n(MjAccessModel* model, MjAccessData* data, int n_substeps) {
+    if (!model || !model->mj || !data || !data->mj) return;
+    for (int k = 0; k < n_substeps; k++) mj_step(model->mj, data->mj);
+}
+
 MJA_API void mjaccess_forward(MjAccessModel* model, MjAccessData* data) {
     if (model && model->mj && data && data->mj) mj_forward(model->mj, data->mj);
 }
@@ -358,11 +1300,99 @@ MJA_API int mjaccess_get_warning_count(const MjAccessData* data, int index) {
     return data->mj->warning[index].number;
 }
 
+// ── Profiling ────────────────────────────────────────────────
+
+// The clock is counted across profile_timers and every profiling batched
+// sim. A clock the application installed is kept (it fills the timers just
+// as well); ours is removed with the last user, restoring the previous one.
+static atomic_int g_profile_users;
+static atomic_int g_profile_timers_on;  // profile_timers holds one reference
+static mjfTime    g_profile_prev;
+
+static mjtNum mja_profile_clock(void) {
+    return (mjtNum)mja_now_ns() * 1e-6;
+}
+
+static void profile_clock_acquire(void) {
+    if (atomic_fetch_add(&g_profile_users, 1) == 0) {
+        g_profile_prev = mjcb_time;
+        if (!mjcb_time) mjcb_time = mja_profile_clock;
+    }
+}
+
+static void profile_clock_release(void) {
+    if (atomic_fetch_sub(&g_profile_users, 1) == 1 && mjcb_time == mja_profile_clock)
+        mjcb_time = g_profile_prev;
+}
+
+static int profile_bin(long long ns) {
+    long long us = ns / 1000;
+    int bin = 0;
+    while (us > 0 && bin < MJA_PROFILE_BINS - 1) {
+        us >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+// Fold the stage timers a data gained since seen[] (its timers at the last
+// harvest) and its solver counts into p. The timers themselves are left
+// alone; a count below the mark means mj_resetData cleared them.
+static void profile_harvest(MjAccessProfile* p, const mjData* d, mjTimerStat* seen) {
+    int nt = mjNTIMER < MJA_PROFILE_STAGES ? mjNTIMER : MJA_PROFILE_STAGES;
+    for (int k = 0; k < nt; k++) {
+        if (d->timer[k].number < seen[k].number) memset(&seen[k], 0, sizeof(seen[k]));
+        p->stage_ms[k] += d->timer[k].duration - seen[k].duration;
+        p->stage_calls[k] += d->timer[k].number - seen[k].number;
+        seen[k] = d->timer[k];
+    }
+    p->contacts += d->ncon;
+    p->constraints += d->nefc;
+    p->solver_iters += d->solver_niter[0];
+    if (d->ncon > p->max_contacts) p->max_contacts = d->ncon;
+    if (d->nefc > p->max_constraints) p->max_constraints = d->nefc;
+}
+
+MJA_API void mjaccess_profile_timers(int enabled) {
+    if (atomic_exchange(&g_profile_timers_on, enabled != 0) == (enabled != 0)) return;
+    if (enabled) profile_clock_acquire();
+    else profile_clock_release();
+}
+
+MJA_API void mjaccess_get_profile(const MjAccessData* data, MjAccessProfile* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!data || !data->mj) return;
+    const mjData* d = data->mj;
+    int nt = mjNTIMER < MJA_PROFILE_STAGES ? mjNTIMER : MJA_PROFILE_STAGES;
+    for (int k = 0; k < nt; k++) {
+        out->stage_ms[k] = d->timer[k].duration;
+        out->stage_calls[k] = d->timer[k].number;
+    }
+    out->env_steps = d->timer[mjTIMER_STEP].number;
+    out->step_ms = d->timer[mjTIMER_STEP].duration;
+    out->contacts = out->max_contacts = d->ncon;
+    out->constraints = out->max_constraints = d->nefc;
+    out->solver_iters = d->solver_niter[0];
+}
+
+MJA_API void mjaccess_reset_profile(MjAccessData* data) {
+    if (!data || !data->mj) return;
+    memset(data->mj->timer, 0, sizeof(data->mj->timer));
+}
+
 // ── Model I/O ────────────────────────────────────────────────
 
 MJA_API int mjaccess_save_last_xml(const MjAccessModel* model, const char* path,
                                    char* error_buf, int error_buf_size) {
     if (!model || !model->mj || !path) return -1;
+    if (model->from_cache) {
+        // no XML was parsed for this model; the last XML belongs to another
+        if (error_buf && error_buf_size > 0)
+            snprintf(error_buf, (size_t)error_buf_size,
+                     "model was loaded from the compiled-model cache; load it with the cache off");
+        return -1;
+    }
     mj_saveLastXML(path, (mjModel*)model->mj, error_buf, error_buf_size);
     if (error_buf && error_buf[0] != '\0') return -1;
     return 0;
@@ -380,56 +1410,1825 @@ MJA_API void mjaccess_load_plugin_library(const char* path) {
     if (path) mj_loadPluginLibrary(path);
 }
 
-// ── Batched simulation ───────────────────────────────────────
+// ── Bulk transforms ──────────────────────────────────────────
 
-static void batched_free_buffers(MjAccessBatchedSim* sim) {
-    free(sim->qpos_buf);            sim->qpos_buf = NULL;
-    free(sim->qvel_buf);            sim->qvel_buf = NULL;
-    free(sim->xpos_buf);            sim->xpos_buf = NULL;
-    free(sim->subtree_com_buf);     sim->subtree_com_buf = NULL;
-    free(sim->cinert_buf);          sim->cinert_buf = NULL;
-    free(sim->cvel_buf);            sim->cvel_buf = NULL;
-    free(sim->qfrc_actuator_buf);   sim->qfrc_actuator_buf = NULL;
-    free(sim->cfrc_ext_buf);        sim->cfrc_ext_buf = NULL;
+static int xf_count(const mjModel* m, int type) {
+    switch (type) {
+    case mjOBJ_BODY:
+    case mjOBJ_XBODY: return m->nbody;
+    case mjOBJ_GEOM:  return m->ngeom;
+    case mjOBJ_SITE:  return m->nsite;
+    default:          return 0;
+    }
 }
 
-MJA_API MjAccessBatchedSim* mjaccess_batched_create(MjAccessModel* model,
-                                                    const MjAccessBatchedConfig* config) {
-    if (!model || !model->mj || !config || config->num_envs <= 0) return NULL;
-    mjModel* mj = model->mj;
-    int ne = config->num_envs;
+MJA_API int mjaccess_bind_transforms(MjAccessData* data, const int* objtypes, const int* ids,
+                                     const float* offsets, int n) {
+    if (!data || !data->model_ref || n < 0 || (n > 0 && (!objtypes || !ids))) return -1;
+    for (int i = 0; i < n; i++) {
+        if (ids[i] < 0 || ids[i] >= xf_count(data->model_ref, objtypes[i])) return -1;
+    }
+    int* type = (int*)malloc((n + 1) * sizeof(int));
+    int* id = (int*)malloc((n + 1) * sizeof(int));
+    float* off = offsets ? (float*)malloc((n * 7 + 1) * sizeof(float)) : NULL;
+    if (!type || !id || (offsets && !off)) {
+        free(type);
+        free(id);
+        free(off);
+        return -1;
+    }
+    memcpy(type, objtypes, n * sizeof(int));
+    memcpy(id, ids, n * sizeof(int));
+    if (off) memcpy(off, offsets, n * 7 * sizeof(float));
+    free(data->xf_type);
+    free(data->xf_id);
+    free(data->xf_offset);
+    data->xf_type = type;
+    data->xf_id = id;
+    data->xf_offset = off;
+    data->xf_n = n;
+    return 0;
+}
 
-    MjAccessBatchedSim* sim = (MjAccessBatchedSim*)calloc(1, sizeof(MjAccessBatchedSim));
-    sim->model_ref = mj;
-    sim->num_envs = ne;
-    sim->datas = (mjData**)calloc(ne, sizeof(mjData*));
+// MuJoCo (w, x, y, z) -> Unity (x, z, y, -w), see MjEngineTool.UnityQuaternion.
+static void xf_unity_rot(float* dst, const mjtNum* q) {
+    dst[0] = (float)q[1];
+    dst[1] = (float)q[3];
+    dst[2] = (float)q[2];
+    dst[3] = (float)-q[0];
+}
 
-    for (int i = 0; i < ne; i++) {
-        sim->datas[i] = mj_makeData(mj);
-        if (!sim->datas[i]) {
-            mjaccess_batched_free(sim);
-            return NULL;
+// pose = pose * offset, both Unity-space (x, y, z, w) rotations.
+static void xf_compose(MjAccessPose* p, const float* off) {
+    const float* q = p->rot;
+    float x = off[0], y = off[1], z = off[2];
+    // v' = v + 2 * q.w * (q.xyz x v) + 2 * q.xyz x (q.xyz x v)
+    float tx = 2 * (q[1] * z - q[2] * y);
+    float ty = 2 * (q[2] * x - q[0] * z);
+    float tz = 2 * (q[0] * y - q[1] * x);
+    p->pos[0] += x + q[3] * tx + (q[1] * tz - q[2] * ty);
+    p->pos[1] += y + q[3] * ty + (q[2] * tx - q[0] * tz);
+    p->pos[2] += z + q[3] * tz + (q[0] * ty - q[1] * tx);
+    const float* r = off + 3;
+    float rot[4] = {
+        q[3] * r[0] + q[0] * r[3] + q[1] * r[2] - q[2] * r[1],
+        q[3] * r[1] - q[0] * r[2] + q[1] * r[3] + q[2] * r[0],
+        q[3] * r[2] + q[0] * r[1] - q[1] * r[0] + q[2] * r[3],
+        q[3] * r[3] - q[0] * r[0] - q[1] * r[1] - q[2] * r[2],
+    };
+    memcpy(p->rot, rot, sizeof(rot));
+}
+
+MJA_API int mjaccess_export_transforms(const MjAccessData* data, MjAccessPose* out, int n) {
+    if (!data || !data->mj || !data->model_ref || !out || n < data->xf_n) return -1;
+    const mjModel* m = data->model_ref;
+    const mjData* d = data->mj;
+    for (int i = 0; i < data->xf_n; i++) {
+        int type = data->xf_type[i], id = data->xf_id[i];
+        MjAccessPose* p = &out[i];
+        if (id >= xf_count(m, type)) {
+            MjAccessPose identity = { { 0, 0, 0 }, { 0, 0, 0, 1 } };
+            *p = identity;
+            continue;
+        }
+        const mjtNum* pos;
+        mjtNum quat[4];
+        switch (type) {
+        case mjOBJ_BODY:
+            pos = d->xpos + 3 * id;
+            memcpy(quat, d->xquat + 4 * id, sizeof(quat));
+            break;
+        case mjOBJ_XBODY:
+            pos = d->xipos + 3 * id;
+            mju_mat2Quat(quat, d->ximat + 9 * id);
+            break;
+        case mjOBJ_GEOM:
+            pos = d->geom_xpos + 3 * id;
+            mju_mat2Quat(quat, d->geom_xmat + 9 * id);
+            break;
+        default:
+            pos = d->site_xpos + 3 * id;
+            mju_mat2Quat(quat, d->site_xmat + 9 * id);
+            break;
         }
+        p->pos[0] = (float)pos[0];
+        p->pos[1] = (float)pos[2];
+        p->pos[2] = (float)pos[1];
+        xf_unity_rot(p->rot, quat);
+        if (data->xf_offset) xf_compose(p, data->xf_offset + 7 * i);
     }
+    return data->xf_n;
+}
 
-    if (config->solver_iterations > 0)
-        mj->opt.iterations = config->solver_iterations;
-
-    // Pre-allocate gather buffers
-    sim->qpos_buf            = (double*)malloc(ne * mj->nq * sizeof(double));
-    sim->qvel_buf            = (double*)malloc(ne * mj->nv * sizeof(double));
-    sim->xpos_buf            = (double*)malloc(ne * mj->nbody * 3 * sizeof(double));
-    sim->subtree_com_buf     = (double*)malloc(ne * mj->nbody * 3 * sizeof(double));
-    sim->cinert_buf          = (double*)malloc(ne * mj->nbody * 10 * sizeof(double));
-    sim->cvel_buf            = (double*)malloc(ne * mj->nbody * 6 * sizeof(double));
-    sim->qfrc_actuator_buf   = (double*)malloc(ne * mj->nv * sizeof(double));
-    sim->cfrc_ext_buf        = (double*)malloc(ne * mj->nbody * 6 * sizeof(double));
+// ── Contacts ─────────────────────────────────────────────────
 
+// Replace one side of a filter with the given geoms, or every geom of the
+// given bodies; n = 0 makes the side match everything.
+static int contact_filter_set(MjaContactFilter* f, const mjModel* m, int side, int objtype,
+                              const int* ids, int n) {
+    if (side < 0 || side > 1 || n < 0 || (n > 0 && !ids)) return -1;
+    if (objtype != mjOBJ_GEOM && objtype != mjOBJ_BODY) return -1;
+    int count = objtype == mjOBJ_GEOM ? m->ngeom : m->nbody;
+    for (int i = 0; i < n; i++) {
+        if (ids[i] < 0 || ids[i] >= count) return -1;
+    }
+    if (f->ngeom != m->ngeom) {
+        free(f->geom_side);
+        f->geom_side = (unsigned char*)calloc(m->ngeom + 1, 1);
+        f->ngeom = f->geom_side ? m->ngeom : 0;
+        if (!f->geom_side) return -1;
+        f->any[0] = f->any[1] = 1;
+    }
+    unsigned char bit = (unsigned char)(1u << side);
+    for (int g = 0; g < f->ngeom; g++) f->geom_side[g] &= (unsigned char)~bit;
+    for (int i = 0; i < n; i++) {
+        if (objtype == mjOBJ_GEOM) {
+            f->geom_side[ids[i]] |= bit;
+        } else {
+            for (int g = 0; g < m->ngeom; g++)
+                if (m->geom_bodyid[g] == ids[i]) f->geom_side[g] |= bit;
+        }
+    }
+    f->any[side] = n == 0;
+    return 0;
+}
+
+static int contact_in_side(const MjaContactFilter* f, int side, int geom) {
+    if (!f->geom_side || f->any[side]) return 1;
+    return geom >= 0 && geom < f->ngeom && (f->geom_side[geom] >> side & 1);
+}
+
+static int contact_passes(const MjaContactFilter* f, int g1, int g2) {
+    return (contact_in_side(f, 0, g1) && contact_in_side(f, 1, g2)) ||
+           (contact_in_side(f, 0, g2) && contact_in_side(f, 1, g1));
+}
+
+// Pack the filtered contacts of d into out; returns the number that passed,
+// of which the first `capacity` are written.
+static int contact_export(const MjaContactFilter* f, const mjModel* m, const mjData* d,
+                          MjAccessContact* out, int capacity) {
+    int n = 0;
+    for (int i = 0; i < d->ncon; i++) {
+        const mjContact* c = &d->contact[i];
+        if (!contact_passes(f, c->geom[0], c->geom[1])) continue;
+        if (n < capacity) {
+            MjAccessContact* o = &out[n];
+            for (int k = 0; k < 2; k++) {
+                o->geom[k] = c->geom[k];
+                o->body[k] = c->geom[k] >= 0 ? m->geom_bodyid[c->geom[k]] : -1;
+            }
+            o->dist = c->dist;
+            memcpy(o->pos, c->pos, sizeof(o->pos));
+            memcpy(o->frame, c->frame, sizeof(o->frame));
+            if (c->efc_address >= 0)
+                mj_contactForce(m, d, i, o->force);
+            else
+                memset(o->force, 0, sizeof(o->force));
+        }
+        n++;
+    }
+    return n;
+}
+
+MJA_API int mjaccess_contact_filter(MjAccessData* data, int side, int objtype, const int* ids,
+                                    int n) {
+    if (!data || !data->model_ref) return -1;
+    return contact_filter_set(&data->contact_filter, data->model_ref, side, objtype, ids, n);
+}
+
+MJA_API int mjaccess_export_contacts(const MjAccessData* data, MjAccessContact* out,
+                                     int capacity) {
+    if (!data || !data->mj || capacity < 0 || (capacity > 0 && !out)) return -1;
+    return contact_export(&data->contact_filter, data->model_ref, data->mj, out, capacity);
+}
+
+// ── Kinematic playback ───────────────────────────────────────
+
+#define MJA_TRAJ_MAGIC "MJATRAJ\0"
+
+typedef struct {
+    char    magic[8];
+    int32_t version;
+    int32_t nq;
+    int64_t nframes;
+    int64_t index_offset;  // byte offset of the nframes frame times
+    char    reserved[32];
+} MjaTrajHeader;
+
+struct MjAccessTrajectory {
+    const unsigned char* base;
+    size_t               size;
+    int                  nq;
+    long long            nframes;
+    const double*        frames;  // [nframes * nq], in the mapping
+    const double*        times;   // [nframes], in the mapping
+    double               t0;
+    double               dt;      // mean spacing, first guess of locate
+#ifdef _WIN32
+    HANDLE               file;
+    HANDLE               mapping;
+#endif
+};
+
+struct MjAccessTrajWriter {
+    FILE*     file;
+    int       nq;
+    long long nframes;
+    long long cap;
+    double*   times;
+    int       error;
+};
+
+static void traj_unmap(MjAccessTrajectory* t) {
+#ifdef _WIN32
+    if (t->base) UnmapViewOfFile(t->base);
+    if (t->mapping) CloseHandle(t->mapping);
+    if (t->file && t->file != INVALID_HANDLE_VALUE) CloseHandle(t->file);
+#else
+    if (t->base) munmap((void*)t->base, t->size);
+#endif
+    free(t);
+}
+
+MJA_API MjAccessTrajectory* mjaccess_traj_open(const char* path) {
+    if (!path) return NULL;
+    MjAccessTrajectory* t = (MjAccessTrajectory*)calloc(1, sizeof(MjAccessTrajectory));
+    if (!t) return NULL;
+#ifdef _WIN32
+    t->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                          FILE_FLAG_RANDOM_ACCESS, NULL);
+    LARGE_INTEGER size;
+    if (t->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(t->file, &size) ||
+        (unsigned long long)size.QuadPart < sizeof(MjaTrajHeader)) {
+        traj_unmap(t);
+        return NULL;
+    }
+    t->size = (size_t)size.QuadPart;
+    t->mapping = CreateFileMappingA(t->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (t->mapping) t->base = (const unsigned char*)MapViewOfFile(t->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!t->base) {
+        traj_unmap(t);
+        return NULL;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(MjaTrajHeader)) {
+        if (fd >= 0) close(fd);
+        free(t);
+        return NULL;
+    }
+    t->size = (size_t)st.st_size;
+    void* base = mmap(NULL, t->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the file open
+    if (base == MAP_FAILED) {
+        free(t);
+        return NULL;
+    }
+    t->base = (const unsigned char*)base;
+#endif
+    MjaTrajHeader h;
+    memcpy(&h, t->base, sizeof(h));
+    unsigned long long frame_bytes = (unsigned long long)h.nframes * h.nq * sizeof(double);
+    if (memcmp(h.magic, MJA_TRAJ_MAGIC, 8) != 0 || h.version != 1 || h.nq <= 0 ||
+        h.nframes <= 0 || h.index_offset < (int64_t)(sizeof(h) + frame_bytes) ||
+        (unsigned long long)h.index_offset + h.nframes * sizeof(double) > t->size) {
+        traj_unmap(t);
+        return NULL;
+    }
+    t->nq = h.nq;
+    t->nframes = h.nframes;
+    t->frames = (const double*)(t->base + sizeof(h));
+    t->times = (const double*)(t->base + h.index_offset);
+    t->t0 = t->times[0];
+    t->dt = h.nframes > 1 ? (t->times[h.nframes - 1] - t->t0) / (double)(h.nframes - 1) : 0;
+    return t;
+}
+
+MJA_API void mjaccess_traj_close(MjAccessTrajectory* traj) {
+    if (traj) traj_unmap(traj);
+}
+
+MJA_API long long mjaccess_traj_num_frames(const MjAccessTrajectory* traj) {
+    return traj ? traj->nframes : 0;
+}
+
+MJA_API int mjaccess_traj_nq(const MjAccessTrajectory* traj) {
+    return traj ? traj->nq : 0;
+}
+
+MJA_API double mjaccess_traj_time(const MjAccessTrajectory* traj, long long frame) {
+    if (!traj || frame < 0 || frame >= traj->nframes) return 0;
+    return traj->times[frame];
+}
+
+MJA_API const double* mjaccess_traj_frame(const MjAccessTrajectory* traj, long long frame) {
+    if (!traj || frame < 0 || frame >= traj->nframes) return NULL;
+    return traj->frames + frame * traj->nq;
+}
+
+// The even-spacing guess is checked against the index and only falls back to
+// a binary search when the frames are not evenly spaced.
+MJA_API double mjaccess_traj_locate(const MjAccessTrajectory* traj, double time) {
+    if (!traj) return 0;
+    long long n = traj->nframes;
+    const double* ts = traj->times;
+    if (n == 1 || time <= ts[0]) return 0;
+    if (time >= ts[n - 1]) return (double)(n - 1);
+    long long k = traj->dt > 0 ? (long long)((time - traj->t0) / traj->dt) : 0;
+    if (k < 0) k = 0;
+    if (k > n - 2) k = n - 2;
+    if (!(ts[k] <= time && time < ts[k + 1])) {
+        long long lo = 0, hi = n - 1;  // ts[lo] <= time < ts[hi]
+        while (hi - lo > 1) {
+            long long mid = lo + (hi - lo) / 2;
+            if (ts[mid] <= time) lo = mid; else hi = mid;
+        }
+        k = lo;
+    }
+    double span = ts[k + 1] - ts[k];
+    return (double)k + (span > 0 ? (time - ts[k]) / span : 0);
+}
+
+MJA_API int mjaccess_traj_apply(const MjAccessTrajectory* traj, MjAccessModel* model,
+                                MjAccessData* data, double frame) {
+    if (!traj || !model || !model->mj || !data || !data->mj) return -1;
+    const mjModel* m = model->mj;
+    mjData* d = data->mj;
+    if (m->nq != traj->nq) return -1;
+    if (!(frame > 0)) frame = 0;  // also catches NaN
+    if (frame > (double)(traj->nframes - 1)) frame = (double)(traj->nframes - 1);
+    long long k = (long long)frame;
+    double f = frame - (double)k;
+    const double* a = traj->frames + k * traj->nq;
+    if (f <= 0 || k + 1 >= traj->nframes) {
+        memcpy(d->qpos, a, m->nq * sizeof(double));
+        d->time = traj->times[k];
+    } else {
+        const double* b = a + traj->nq;
+        for (int i = 0; i < m->nq; i++) d->qpos[i] = a[i] + f * (b[i] - a[i]);
+        for (int j = 0; j < m->njnt; j++) {
+            int type = m->jnt_type[j];
+            if (type == mjJNT_FREE)
+                mju_normalize4(d->qpos + m->jnt_qposadr[j] + 3);
+            else if (type == mjJNT_BALL)
+                mju_normalize4(d->qpos + m->jnt_qposadr[j]);
+        }
+        d->time = traj->times[k] + f * (traj->times[k + 1] - traj->times[k]);
+    }
+    mj_kinematics(m, d);
+    return 0;
+}
+
+static int traj_write_header(MjAccessTrajWriter* w) {
+    MjaTrajHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, MJA_TRAJ_MAGIC, 8);
+    h.version = 1;
+    h.nq = w->nq;
+    h.nframes = w->nframes;
+    h.index_offset = (int64_t)(sizeof(h) + (unsigned long long)w->nframes * w->nq * sizeof(double));
+    return fwrite(&h, sizeof(h), 1, w->file) == 1 ? 0 : -1;
+}
+
+MJA_API MjAccessTrajWriter* mjaccess_traj_writer_open(const char* path, int nq) {
+    if (!path || nq <= 0) return NULL;
+    MjAccessTrajWriter* w = (MjAccessTrajWriter*)calloc(1, sizeof(MjAccessTrajWriter));
+    if (!w) return NULL;
+    w->nq = nq;
+    w->file = fopen(path, "wb");
+    if (!w->file || traj_write_header(w) != 0) {  // placeholder until close
+        if (w->file) fclose(w->file);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+// Frame times must not decrease.
+MJA_API int mjaccess_traj_writer_add(MjAccessTrajWriter* w, double time, const double* qpos) {
+    if (!w || !qpos || (w->nframes > 0 && time < w->times[w->nframes - 1])) return -1;
+    if (w->nframes == w->cap) {
+        long long cap = w->cap ? w->cap * 2 : 1024;
+        double* times = (double*)realloc(w->times, cap * sizeof(double));
+        if (!times) return -1;
+        w->times = times;
+        w->cap = cap;
+    }
+    if (fwrite(qpos, sizeof(double), w->nq, w->file) != (size_t)w->nq) {
+        w->error = 1;
+        return -1;
+    }
+    w->times[w->nframes++] = time;
+    return 0;
+}
+
+MJA_API int mjaccess_traj_writer_close(MjAccessTrajWriter* w) {
+    if (!w) return -1;
+    int err = w->error || w->nframes == 0;
+    if (!err && fwrite(w->times, sizeof(double), w->nframes, w->file) != (size_t)w->nframes) err = 1;
+    if (!err && (fseek(w->file, 0, SEEK_SET) != 0 || traj_write_header(w) != 0)) err = 1;
+    if (fclose(w->file) != 0) err = 1;
+    free(w->times);
+    free(w);
+    return err ? -1 : 0;
+}
+
+MJA_API int mjaccess_record_export_traj(const char* record_path, int env, const char* traj_path,
+                                        double dt) {
+    MjAccessRecordInfo info;
+    MjAccessRecordReader* rd = mjaccess_record_open(record_path, &info);
+    if (!rd) return -1;
+    int nq = info.dims[MJA_FIELD_QPOS];
+    if (env < 0 || env >= info.num_envs || !(info.field_mask & (1u << MJA_FIELD_QPOS)) || nq <= 0) {
+        mjaccess_record_close(rd);
+        return -1;
+    }
+    int off = 2 * sizeof(int32_t);  // qpos is the first field of a row
+    unsigned char* rows = (unsigned char*)malloc((size_t)info.num_envs * info.row_bytes);
+    double* qpos = (double*)malloc(nq * sizeof(double));
+    MjAccessTrajWriter* w = rows && qpos ? mjaccess_traj_writer_open(traj_path, nq) : NULL;
+    int rc = w ? 0 : -1;
+    long long frame;
+    int first, count, r = 0;
+    while (w && (r = mjaccess_record_next(rd, rows, &frame, &first, &count)) == 1) {
+        if (env < first || env >= first + count) continue;
+        const unsigned char* row = rows + (size_t)env * info.row_bytes + off;
+        if (info.elem_size == 4) {
+            for (int i = 0; i < nq; i++) {
+                float v;
+                memcpy(&v, row + i * sizeof(float), sizeof(float));
+                qpos[i] = v;
+            }
+        } else {
+            memcpy(qpos, row, nq * sizeof(double));
+        }
+        if (mjaccess_traj_writer_add(w, frame * dt, qpos) != 0) {
+            rc = -1;
+            break;
+        }
+    }
+    if (r < 0) rc = -1;
+    if (w && mjaccess_traj_writer_close(w) != 0) rc = -1;
+    mjaccess_record_close(rd);
+    free(rows);
+    free(qpos);
+    return rc;
+}
+
+// ── Trajectory recorder ──────────────────────────────────────
+//
+// A ring of ring_frames slots, each with a row per env. The stepping thread
+// claims the slot at `head` before a job, workers fill the rows of the envs
+// they step, and the slot is published by advancing `head` once the job has
+// joined. The writer thread encodes slots from `tail`, hands them back by
+// advancing `tail`, and writes each batch as one chunk.
+
+#define MJA_RECORD_MAGIC "MJAREC\0\0"
+#define MJA_RECORD_CHUNK 0x4B434A4Du  // "MJCK"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t n_frames;
+    uint64_t size;
+} MjaRecChunk;
+
+typedef struct {
+    int64_t  frame;
+    int32_t  env_first;
+    int32_t  env_count;
+    uint32_t size;
+    uint32_t reserved;
+} MjaRecFrame;
+
+struct MjaRecorder {
+    FILE*              file;
+    MjAccessRecordInfo info;
+    int                field_off[MJA_FIELD_COUNT];  // byte offset in a row, -1 = not recorded
+    int                cap;
+    int                chunk_frames;
+    size_t             slot_bytes;
+    unsigned char*     ring;         // [cap * slot_bytes]
+    long long*         slot_frame;   // [cap]
+    int*               slot_first;   // [cap]
+    int*               slot_count;   // [cap]
+    unsigned char*     cur;          // slot of the running job, NULL = frame dropped
+    atomic_llong       head;         // frames published
+    atomic_llong       tail;         // frames consumed by the writer
+    int32_t*           episode;      // [num_envs]
+    int32_t*           episode_step; // [num_envs]
+    // producer stats
+    long long          frames;
+    long long          dropped;
+    double             stall_ms;
+    // writer state
+    unsigned char*     prev;         // [num_envs * row_bytes] last recorded rows (delta)
+    unsigned char*     work;         // [num_envs * row_bytes]
+    unsigned char*     shuf;         // [num_envs * row_bytes]
+    unsigned char*     packed;       // one encoded chunk
+    atomic_llong       bytes_raw;
+    atomic_llong       bytes_written;
+    atomic_int         io_error;
+#ifdef MJA_HAVE_THREADS
+    pthread_t          thread;
+    atomic_int         quit;
+#endif
+};
+
+struct MjAccessRecordReader {
+    FILE*              file;
+    MjAccessRecordInfo info;
+    int                chunk_left;
+    unsigned char*     prev;
+    unsigned char*     buf;
+    unsigned char*     tmp;
+    unsigned char*     packed;
+};
+
+// Worst case of zero-run coding: one control byte per 128 literals.
+static size_t zrle_bound(size_t n) {
+    return n + n / 128 + 1;
+}
+
+// A control byte c < 128 is followed by c + 1 literal bytes; c >= 128 stands
+// for a run of c - 126 zero bytes (2..129).
+static size_t zrle_encode(const unsigned char* in, size_t n, unsigned char* out) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        size_t z = i;
+        while (z < n && z - i < 129 && in[z] == 0) z++;
+        if (z - i >= 2) {
+            out[o++] = (unsigned char)(z - i + 126);
+            i = z;
+            continue;
+        }
+        size_t e = i;
+        while (e < n && e - i < 128 && !(in[e] == 0 && e + 1 < n && in[e + 1] == 0)) e++;
+        out[o++] = (unsigned char)(e - i - 1);
+        memcpy(out + o, in + i, e - i);
+        o += e - i;
+        i = e;
+    }
+    return o;
+}
+
+static int zrle_decode(const unsigned char* in, size_t n, unsigned char* out, size_t len) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        unsigned c = in[i++];
+        size_t r = c >= 128 ? c - 126 : c + 1;
+        if (o + r > len) return -1;
+        if (c >= 128) {
+            memset(out + o, 0, r);
+        } else {
+            if (i + r > n) return -1;
+            memcpy(out + o, in + i, r);
+            i += r;
+        }
+        o += r;
+    }
+    return o == len ? 0 : -1;
+}
+
+// Gather byte b of every es-byte word into plane b, so the slowly changing
+// sign/exponent bytes (zeros after delta coding) end up in long runs.
+static void rec_shuffle(unsigned char* dst, const unsigned char* src, size_t n, int es) {
+    size_t words = n / es;
+    for (int b = 0; b < es; b++)
+        for (size_t j = 0; j < words; j++) dst[b * words + j] = src[j * es + b];
+}
+
+static void rec_unshuffle(unsigned char* dst, const unsigned char* src, size_t n, int es) {
+    size_t words = n / es;
+    for (int b = 0; b < es; b++)
+        for (size_t j = 0; j < words; j++) dst[j * es + b] = src[b * words + j];
+}
+
+#ifdef MJA_HAVE_THREADS
+static void mja_sleep_us(long us) {
+    struct timespec ts = { us / 1000000, (us % 1000000) * 1000 };
+    nanosleep(&ts, NULL);
+}
+#endif
+
+// Encode ring slot `slot` into out; returns the bytes used.
+static size_t recorder_encode(MjaRecorder* r, int slot, unsigned char* out) {
+    size_t rb = (size_t)r->info.row_bytes;
+    int first = r->slot_first[slot];
+    size_t n = (size_t)r->slot_count[slot] * rb;
+    const unsigned char* data = r->ring + (size_t)slot * r->slot_bytes + first * rb;
+    if (r->info.flags & MJA_RECORD_DELTA) {
+        unsigned char* prev = r->prev + first * rb;
+        for (size_t i = 0; i < n; i++) {
+            unsigned char v = data[i];
+            r->work[i] = v ^ prev[i];
+            prev[i] = v;
+        }
+        data = r->work;
+    }
+    MjaRecFrame hdr = { r->slot_frame[slot], first, r->slot_count[slot], 0, 0 };
+    unsigned char* payload = out + sizeof(hdr);
+    if (r->info.flags & MJA_RECORD_COMPRESS) {
+        rec_shuffle(r->shuf, data, n, r->info.elem_size);
+        hdr.size = (uint32_t)zrle_encode(r->shuf, n, payload);
+    } else {
+        memcpy(payload, data, n);
+        hdr.size = (uint32_t)n;
+    }
+    memcpy(out, &hdr, sizeof(hdr));
+    atomic_fetch_add_explicit(&r->bytes_raw, (long long)n, memory_order_relaxed);
+    return sizeof(hdr) + hdr.size;
+}
+
+// Encode and write up to chunk_frames published frames; returns the count.
+// Slots are released as soon as they are encoded, before the write.
+static int recorder_drain(MjaRecorder* r) {
+    long long tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    long long head = atomic_load_explicit(&r->head, memory_order_acquire);
+    if (head == tail) return 0;
+    int n = head - tail < r->chunk_frames ? (int)(head - tail) : r->chunk_frames;
+    size_t size = 0;
+    for (int k = 0; k < n; k++)
+        size += recorder_encode(r, (int)((tail + k) % r->cap), r->packed + sizeof(MjaRecChunk) + size);
+    atomic_store_explicit(&r->tail, tail + n, memory_order_release);
+    MjaRecChunk chunk = { MJA_RECORD_CHUNK, (uint32_t)n, size };
+    memcpy(r->packed, &chunk, sizeof(chunk));
+    size += sizeof(chunk);
+    if (fwrite(r->packed, 1, size, r->file) != size)
+        atomic_store_explicit(&r->io_error, 1, memory_order_relaxed);
+    else
+        atomic_fetch_add_explicit(&r->bytes_written, (long long)size, memory_order_relaxed);
+    return n;
+}
+
+#ifdef MJA_HAVE_THREADS
+static void* recorder_main(void* arg) {
+    MjaRecorder* r = (MjaRecorder*)arg;
+    for (;;) {
+        int quit = atomic_load_explicit(&r->quit, memory_order_acquire);
+        if (recorder_drain(r) > 0) continue;
+        if (quit) break;
+        mja_sleep_us(200);
+    }
+    return NULL;
+}
+#endif
+
+static void recorder_free(MjaRecorder* r) {
+    if (r->file) fclose(r->file);
+    free(r->ring);
+    free(r->slot_frame);
+    free(r->slot_first);
+    free(r->slot_count);
+    free(r->episode);
+    free(r->episode_step);
+    free(r->prev);
+    free(r->work);
+    free(r->shuf);
+    free(r->packed);
+    free(r);
+}
+
+static MjaRecorder* recorder_open(const char* path, int num_envs, const int* dims,
+                                  unsigned mask, const MjAccessRecordConfig* config) {
+    MjaRecorder* r = (MjaRecorder*)calloc(1, sizeof(MjaRecorder));
+    if (!r) return NULL;
+    MjAccessRecordInfo* info = &r->info;
+    info->version = 2;  // 2: geom_xpos and geom_xmat fields
+    info->num_envs = num_envs;
+    info->field_mask = mask;
+    info->flags = config->flags & (MJA_RECORD_FLOAT32 | MJA_RECORD_DELTA |
+                                   MJA_RECORD_COMPRESS | MJA_RECORD_DROP);
+    info->elem_size = (info->flags & MJA_RECORD_FLOAT32) ? 4 : 8;
+    int off = 2 * sizeof(int32_t);
+    for (int f = 0; f < MJA_FIELD_COUNT; f++) {
+        info->dims[f] = dims[f];
+        r->field_off[f] = (mask >> f) & 1u ? off : -1;
+        if ((mask >> f) & 1u) off += dims[f] * info->elem_size;
+    }
+    info->row_bytes = off;
+    r->cap = config->ring_frames > 0 ? config->ring_frames : 16;
+    r->chunk_frames = config->chunk_frames > 0 ? config->chunk_frames : 8;
+    if (r->chunk_frames > r->cap) r->chunk_frames = r->cap;
+    r->slot_bytes = (size_t)num_envs * off;
+    size_t frame_max = sizeof(MjaRecFrame) + zrle_bound(r->slot_bytes);
+    r->ring = (unsigned char*)malloc(r->cap * r->slot_bytes);
+    r->slot_frame = (long long*)malloc(r->cap * sizeof(long long));
+    r->slot_first = (int*)malloc(r->cap * sizeof(int));
+    r->slot_count = (int*)malloc(r->cap * sizeof(int));
+    r->episode = (int32_t*)calloc(num_envs, sizeof(int32_t));
+    r->episode_step = (int32_t*)calloc(num_envs, sizeof(int32_t));
+    r->prev = (unsigned char*)calloc(r->slot_bytes, 1);
+    r->work = (unsigned char*)malloc(r->slot_bytes);
+    r->shuf = (unsigned char*)malloc(r->slot_bytes);
+    r->packed = (unsigned char*)malloc(sizeof(MjaRecChunk) + r->chunk_frames * frame_max);
+    r->file = fopen(path, "wb");
+    if (!r->ring || !r->slot_frame || !r->slot_first || !r->slot_count || !r->episode ||
+        !r->episode_step || !r->prev || !r->work || !r->shuf || !r->packed || !r->file ||
+        fwrite(MJA_RECORD_MAGIC, 1, 8, r->file) != 8 ||
+        fwrite(info, sizeof(*info), 1, r->file) != 1) {
+        recorder_free(r);
+        return NULL;
+    }
+    atomic_store(&r->bytes_written, (long long)(8 + sizeof(*info)));
+#ifdef MJA_HAVE_THREADS
+    if (pthread_create(&r->thread, NULL, recorder_main, r) != 0) {
+        recorder_free(r);
+        return NULL;
+    }
+#endif
+    return r;
+}
+
+// Drains every published frame, then closes the file.
+static int recorder_close(MjaRecorder* r) {
+#ifdef MJA_HAVE_THREADS
+    atomic_store_explicit(&r->quit, 1, memory_order_release);
+    pthread_join(r->thread, NULL);
+#else
+    while (recorder_drain(r) > 0) {}
+#endif
+    int err = atomic_load(&r->io_error) || fflush(r->file) != 0;
+    recorder_free(r);
+    return err ? -1 : 0;
+}
+
+static void recorder_new_episode(MjaRecorder* r, int env) {
+    r->episode[env]++;
+    r->episode_step[env] = 0;
+}
+
+// Claim the slot for the next job on the stepping thread. A full ring stalls
+// until the writer frees a slot, or drops the frame under MJA_RECORD_DROP.
+static void recorder_acquire(MjaRecorder* r, int env_first, int env_count) {
+    long long head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&r->tail, memory_order_acquire) >= r->cap) {
+        if (r->info.flags & MJA_RECORD_DROP) {
+            r->cur = NULL;
+            r->dropped++;
+            r->frames++;
+            return;
+        }
+#ifdef MJA_HAVE_THREADS
+        long long t0 = mja_now_ns();
+        while (head - atomic_load_explicit(&r->tail, memory_order_acquire) >= r->cap)
+            mja_sleep_us(50);
+        r->stall_ms += (mja_now_ns() - t0) * 1e-6;
+#endif
+    }
+    int slot = (int)(head % r->cap);
+    r->cur = r->ring + (size_t)slot * r->slot_bytes;
+    r->slot_frame[slot] = r->frames++;
+    r->slot_first[slot] = env_first;
+    r->slot_count[slot] = env_count;
+}
+
+static void recorder_publish(MjaRecorder* r) {
+    if (!r->cur) return;
+    r->cur = NULL;
+    atomic_store_explicit(&r->head, atomic_load_explicit(&r->head, memory_order_relaxed) + 1,
+                          memory_order_release);
+#ifndef MJA_HAVE_THREADS
+    while (recorder_drain(r) > 0) {}
+#endif
+}
+
+// ── Terrain paging ───────────────────────────────────────────
+
+struct MjAccessTerrain {
+    MjAccessModel* owner;  // counts this terrain as a dependent
+    mjModel*  m;         // non-owning
+    int       hfield;
+    int       nrow, ncol;
+    float*    window;    // the hfield's rows in m->hfield_data
+    double*   pos;       // xy written on recenter: body_pos of a static body, or geom_pos
+    double    off[2];    // geom xy inside that body, subtracted from the window center
+    double    dx, dy;    // cell spacing
+    float*    world;     // [rows * cols] row-major, row = y
+    int       rows, cols;
+    double    origin[2];
+    int       tile;
+    int       track_body;
+    int       r0, c0;    // window origin in world cells, -1 = not filled yet
+    size_t    map_size;  // 0 = world is malloc'd
+#ifdef _WIN32
+    HANDLE    file;
+    HANDLE    mapping;
+#endif
+};
+
+static void terrain_release(MjAccessTerrain* t) {
+    if (t->owner) t->owner->dependents--;
+    if (!t->map_size) {
+        free(t->world);
+    } else {
+#ifdef _WIN32
+        if (t->world) UnmapViewOfFile(t->world);
+        if (t->mapping) CloseHandle(t->mapping);
+        if (t->file && t->file != INVALID_HANDLE_VALUE) CloseHandle(t->file);
+#else
+        munmap(t->world, t->map_size);
+#endif
+    }
+    free(t);
+}
+
+// Copy-on-write mapping: dirty writes land in private pages, never in the file.
+static int terrain_map(MjAccessTerrain* t, const char* path, size_t bytes) {
+#ifdef _WIN32
+    t->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                          FILE_FLAG_RANDOM_ACCESS, NULL);
+    LARGE_INTEGER size;
+    if (t->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(t->file, &size) ||
+        (unsigned long long)size.QuadPart < bytes)
+        return -1;
+    t->map_size = bytes;
+    t->mapping = CreateFileMappingA(t->file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (t->mapping) t->world = (float*)MapViewOfFile(t->mapping, FILE_MAP_COPY, 0, 0, bytes);
+    return t->world ? 0 : -1;
+#else
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t)st.st_size < bytes) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    void* base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return -1;
+    t->world = (float*)base;
+    t->map_size = bytes;
+    return 0;
+#endif
+}
+
+static int terrain_unrotated(const mjtNum* q) {
+    return q[0] > 0 && fabs(q[1]) < 1e-9 && fabs(q[2]) < 1e-9 && fabs(q[3]) < 1e-9;
+}
+
+MJA_API MjAccessTerrain* mjaccess_terrain_create(MjAccessModel* model,
+                                                 const MjAccessTerrainConfig* config,
+                                                 const char* path) {
+    if (!model || !model->mj || !config) return NULL;
+    mjModel* m = model->mj;
+    int h = config->hfield_id;
+    if (h < 0 || h >= m->nhfield || m->hfield_nrow[h] < 2 || m->hfield_ncol[h] < 2 ||
+        config->rows < m->hfield_nrow[h] || config->cols < m->hfield_ncol[h] ||
+        config->track_body >= m->nbody)
+        return NULL;
+    int g = config->geom_id;
+    if (g < 0) {
+        for (g = 0; g < m->ngeom; g++)
+            if (m->geom_type[g] == mjGEOM_HFIELD && m->geom_dataid[g] == h) break;
+    }
+    if (g >= m->ngeom || m->geom_type[g] != mjGEOM_HFIELD || m->geom_dataid[g] != h) return NULL;
+    // the window is placed by writing xy into a world-aligned frame: the
+    // geom's own on the world body, else its static body's, which must be a
+    // child of the world
+    int b = m->geom_bodyid[g];
+    if (!terrain_unrotated(m->geom_quat + 4 * g)) return NULL;
+    if (b != 0 && (m->body_weldid[b] != 0 || m->body_parentid[b] != 0 ||
+                   !terrain_unrotated(m->body_quat + 4 * b)))
+        return NULL;
+
+    MjAccessTerrain* t = (MjAccessTerrain*)calloc(1, sizeof(MjAccessTerrain));
+    if (!t) return NULL;
+    t->m = m;
+    t->hfield = h;
+    t->nrow = m->hfield_nrow[h];
+    t->ncol = m->hfield_ncol[h];
+    t->window = m->hfield_data + m->hfield_adr[h];
+    t->pos = b != 0 ? m->body_pos + 3 * b : m->geom_pos + 3 * g;
+    if (b != 0) {
+        t->off[0] = m->geom_pos[3 * g];
+        t->off[1] = m->geom_pos[3 * g + 1];
+    }
+    t->dx = 2 * m->hfield_size[4 * h] / (t->ncol - 1);
+    t->dy = 2 * m->hfield_size[4 * h + 1] / (t->nrow - 1);
+    t->rows = config->rows;
+    t->cols = config->cols;
+    t->origin[0] = config->origin[0];
+    t->origin[1] = config->origin[1];
+    t->tile = config->tile > 0 ? config->tile : 16;
+    t->track_body = config->track_body;
+    t->r0 = t->c0 = -1;
+
+    size_t bytes = (size_t)t->rows * t->cols * sizeof(float);
+    if (path) {
+        if (terrain_map(t, path, bytes) != 0) {
+            terrain_release(t);
+            return NULL;
+        }
+    } else {
+        t->world = (float*)calloc((size_t)t->rows * t->cols, sizeof(float));
+        if (!t->world) {
+            terrain_release(t);
+            return NULL;
+        }
+    }
+    t->owner = model;
+    model->dependents++;
+    return t;
+}
+
+MJA_API void mjaccess_terrain_free(MjAccessTerrain* terrain) {
+    if (terrain) terrain_release(terrain);
+}
+
+MJA_API float* mjaccess_terrain_world(MjAccessTerrain* terrain, int* rows, int* cols) {
+    if (!terrain) {
+        if (rows) *rows = 0;
+        if (cols) *cols = 0;
+        return NULL;
+    }
+    if (rows) *rows = terrain->rows;
+    if (cols) *cols = terrain->cols;
+    return terrain->world;
+}
+
+MJA_API void mjaccess_terrain_window(const MjAccessTerrain* terrain, int* row, int* col) {
+    if (row) *row = terrain ? terrain->r0 : -1;
+    if (col) *col = terrain ? terrain->c0 : -1;
+}
+
+// Copy world rows [r0 + row, + rows) x cols [c0 + col, + cols) into the window.
+static int terrain_fetch(MjAccessTerrain* t, int row, int col, int rows, int cols) {
+    if (rows <= 0 || cols <= 0) return 0;
+    hfield_write_rect(t->window, t->ncol, row, col, rows, cols,
+                      t->world + (size_t)(t->r0 + row) * t->cols + t->c0 + col, t->cols);
+    return rows * cols;
+}
+
+// Move the window to (r0, c0). Overlapping cells are shifted inside the
+// hfield; only the newly exposed strips are read from the world map.
+static int terrain_move(MjAccessTerrain* t, int r0, int c0) {
+    int dr = r0 - t->r0, dc = c0 - t->c0;
+    int nrow = t->nrow, ncol = t->ncol;
+    int full = t->r0 < 0 || abs(dr) >= nrow || abs(dc) >= ncol;
+    t->r0 = r0;
+    t->c0 = c0;
+    t->pos[0] = t->origin[0] + (c0 + 0.5 * (ncol - 1)) * t->dx - t->off[0];
+    t->pos[1] = t->origin[1] + (r0 + 0.5 * (nrow - 1)) * t->dy - t->off[1];
+    if (full) return terrain_fetch(t, 0, 0, nrow, ncol);
+
+    // window row i now holds what row i + dr held; walk away from the source
+    int keep_r0 = dr > 0 ? 0 : -dr, keep_r1 = dr > 0 ? nrow - dr : nrow;
+    int keep_c0 = dc > 0 ? 0 : -dc, keep_c1 = dc > 0 ? ncol - dc : ncol;
+    int keep = keep_c1 - keep_c0;
+    for (int k = 0; k < keep_r1 - keep_r0; k++) {
+        int i = dr > 0 ? keep_r0 + k : keep_r1 - 1 - k;
+        float* dst = t->window + (size_t)i * ncol + keep_c0;
+        memmove(dst, dst + (ptrdiff_t)dr * ncol + dc, keep * sizeof(float));
+    }
+    int copied = terrain_fetch(t, 0, 0, keep_r0, ncol);
+    copied += terrain_fetch(t, keep_r1, 0, nrow - keep_r1, ncol);
+    copied += terrain_fetch(t, keep_r0, 0, keep_r1 - keep_r0, keep_c0);
+    copied += terrain_fetch(t, keep_r0, keep_c1, keep_r1 - keep_r0, ncol - keep_c1);
+    return copied;
+}
+
+static int terrain_clamp(int v, int hi) {
+    return v < 0 ? 0 : v > hi ? hi : v;
+}
+
+// Recentering moves the window in whole tiles and only once the target is a
+// full tile off center, so a body jittering on a boundary does not thrash.
+MJA_API int mjaccess_terrain_center(MjAccessTerrain* terrain, double x, double y) {
+    if (!terrain) return -1;
+    MjAccessTerrain* t = terrain;
+    int tile = t->tile;
+    int want_c = (int)floor((x - t->origin[0]) / t->dx - 0.5 * (t->ncol - 1) + 0.5);
+    int want_r = (int)floor((y - t->origin[1]) / t->dy - 0.5 * (t->nrow - 1) + 0.5);
+    int r0, c0;
+    if (t->r0 < 0) {
+        r0 = (int)floor((double)want_r / tile + 0.5) * tile;
+        c0 = (int)floor((double)want_c / tile + 0.5) * tile;
+    } else {
+        r0 = t->r0 + (want_r - t->r0) / tile * tile;
+        c0 = t->c0 + (want_c - t->c0) / tile * tile;
+    }
+    r0 = terrain_clamp(r0, t->rows - t->nrow);
+    c0 = terrain_clamp(c0, t->cols - t->ncol);
+    if (r0 == t->r0 && c0 == t->c0) return 0;
+    return terrain_move(t, r0, c0);
+}
+
+MJA_API int mjaccess_terrain_update(MjAccessTerrain* terrain, const MjAccessData* data) {
+    if (!terrain || !data || terrain->track_body < 0) return -1;
+    const double* p = data->mj->xpos + 3 * terrain->track_body;
+    return mjaccess_terrain_center(terrain, p[0], p[1]);
+}
+
+MJA_API int mjaccess_terrain_refresh(MjAccessTerrain* terrain) {
+    if (!terrain || terrain->r0 < 0) return -1;
+    return terrain_fetch(terrain, 0, 0, terrain->nrow, terrain->ncol);
+}
+
+// The dirty rectangle goes to the world map, and its overlap with the
+// window straight into the hfield.
+MJA_API int mjaccess_terrain_write(MjAccessTerrain* terrain, int row, int col, int rows, int cols,
+                                   const float* values, int stride) {
+    if (!terrain || !values) return -1;
+    MjAccessTerrain* t = terrain;
+    if (stride <= 0) stride = cols;
+    if (row < 0 || col < 0 || rows <= 0 || cols <= 0 || stride < cols ||
+        row + rows > t->rows || col + cols > t->cols)
+        return -1;
+    hfield_write_rect(t->world, t->cols, row, col, rows, cols, values, stride);
+    if (t->r0 < 0) return 0;
+    int r_lo = row > t->r0 ? row : t->r0;
+    int c_lo = col > t->c0 ? col : t->c0;
+    int r_hi = row + rows < t->r0 + t->nrow ? row + rows : t->r0 + t->nrow;
+    int c_hi = col + cols < t->c0 + t->ncol ? col + cols : t->c0 + t->ncol;
+    if (r_lo >= r_hi || c_lo >= c_hi) return 0;
+    hfield_write_rect(t->window, t->ncol, r_lo - t->r0, c_lo - t->c0, r_hi - r_lo, c_hi - c_lo,
+                      values + (size_t)(r_lo - row) * stride + (c_lo - col), stride);
+    return (r_hi - r_lo) * (c_hi - c_lo);
+}
+
+// ── Physics thread ───────────────────────────────────────────
+
+// Snapshot slot: header, bound poses, sensordata.
+typedef struct {
+    double    time;
+    long long step;
+    long long wall_ns;  // publication time, anchors the reader's interpolation
+} MjaSnapHeader;
+
+#define MJA_SNAP_FRESH 4  // middle slot holds a snapshot the reader has not taken
+
+struct MjAccessPhysicsThread {
+    MjAccessData* data;      // non-owning; exclusive to the thread while it runs
+    mjModel*  m;
+    double    speed;
+    double    max_lag;
+    double    render_delay;
+    int       npose;
+    // four snapshot slots: the writer's, the exchanged middle, and the
+    // reader's previous and current, so the reader always holds a pair
+    size_t    slot_bytes;
+    unsigned char* slots;
+    atomic_int middle;       // slot index | MJA_SNAP_FRESH
+    int       back;          // writer
+    int       prev, cur;     // reader
+    // wall clock <-> sim clock, thread-private; rebased on start, resume and dropped lag
+    long long base_wall_ns;
+    double    base_sim;
+    atomic_llong steps;
+    int       warn0[mjNWARNING];
+    atomic_int error;        // first mjtWarning raised, -1 = none
+    atomic_int paused;
+    atomic_int quit;
+    // commands: producers append to `queued` under cmd_mutex; the thread swaps
+    // it with `applying` before each step, so neither side waits on the other
+    MjaCmdList queued, applying;
+#ifdef MJA_HAVE_THREADS
+    pthread_mutex_t cmd_mutex;
+    pthread_mutex_t step_mutex;  // held across each step; lock() takes it
+    pthread_t thread;
+#endif
+};
+
+static MjaSnapHeader* snap_header(const MjAccessPhysicsThread* pt, int slot) {
+    return (MjaSnapHeader*)(pt->slots + (size_t)slot * pt->slot_bytes);
+}
+
+static MjAccessPose* snap_poses(const MjAccessPhysicsThread* pt, int slot) {
+    return (MjAccessPose*)((unsigned char*)snap_header(pt, slot) + sizeof(MjaSnapHeader));
+}
+
+static double* snap_sensors(const MjAccessPhysicsThread* pt, int slot) {
+    return (double*)(snap_poses(pt, slot) + pt->npose);
+}
+
+static void cmd_list_free(MjaCmdList* l) {
+    free(l->cmds);
+    free(l->values);
+    memset(l, 0, sizeof(*l));
+}
+
+// mjData array addressed by an MJA_CMD_* type: stores its start in *base and
+// returns its length, or -1 for RESET and unknown types.
+static int cmd_array(const mjModel* m, mjData* d, int type, mjtNum** base) {
+    switch (type) {
+    case MJA_CMD_CTRL:         *base = d->ctrl;         return m->nu;
+    case MJA_CMD_QPOS:         *base = d->qpos;         return m->nq;
+    case MJA_CMD_QVEL:         *base = d->qvel;         return m->nv;
+    case MJA_CMD_ACT:          *base = d->act;          return m->na;
+    case MJA_CMD_MOCAP_POS:    *base = d->mocap_pos;    return m->nmocap * 3;
+    case MJA_CMD_MOCAP_QUAT:   *base = d->mocap_quat;   return m->nmocap * 4;
+    case MJA_CMD_XFRC_APPLIED: *base = d->xfrc_applied; return m->nbody * 6;
+    case MJA_CMD_QFRC_APPLIED: *base = d->qfrc_applied; return m->nv;
+    default:                   return -1;
+    }
+}
+
+// Destination of a command's values, or NULL when [offset, offset + n) is out of range.
+static mjtNum* cmd_target(const mjModel* m, mjData* d, int type, int offset, int n) {
+    mjtNum* base;
+    int size = cmd_array(m, d, type, &base);
+    if (offset < 0 || n <= 0 || offset + n > size) return NULL;
+    return base + offset;
+}
+
+#ifdef MJA_HAVE_THREADS
+static void snap_write(MjAccessPhysicsThread* pt, int slot) {
+    const mjData* d = pt->data->mj;
+    MjaSnapHeader* h = snap_header(pt, slot);
+    h->time = d->time;
+    h->step = atomic_load(&pt->steps);
+    h->wall_ns = mja_now_ns();
+    if (pt->npose) mjaccess_export_transforms(pt->data, snap_poses(pt, slot), pt->npose);
+    memcpy(snap_sensors(pt, slot), d->sensordata, pt->m->nsensordata * sizeof(double));
+}
+
+static void cmd_apply(MjAccessPhysicsThread* pt, const MjaCmdList* l) {
+    mjModel* m = pt->m;
+    mjData* d = pt->data->mj;
+    for (int i = 0; i < l->n; i++) {
+        const MjaCmd* c = &l->cmds[i];
+        if (c->type == MJA_CMD_RESET) {
+            if (c->offset >= 0) mj_resetDataKeyframe(m, d, c->offset);
+            else mj_resetData(m, d);
+            continue;
+        }
+        memcpy(cmd_target(m, d, c->type, c->offset, c->n), l->values + c->value_off,
+               c->n * sizeof(double));
+    }
+}
+
+static void physics_rebase(MjAccessPhysicsThread* pt) {
+    pt->base_sim = pt->data->mj->time;
+    pt->base_wall_ns = mja_now_ns();
+}
+
+static double physics_clock(const MjAccessPhysicsThread* pt) {
+    return pt->base_sim + (mja_now_ns() - pt->base_wall_ns) * 1e-9 * pt->speed;
+}
+
+static void physics_step(MjAccessPhysicsThread* pt) {
+    pthread_mutex_lock(&pt->cmd_mutex);
+    MjaCmdList tmp = pt->applying;
+    pt->applying = pt->queued;
+    pt->queued = tmp;
+    pt->queued.n = 0;
+    pt->queued.nvalues = 0;
+    pthread_mutex_unlock(&pt->cmd_mutex);
+
+    mjData* d = pt->data->mj;
+    cmd_apply(pt, &pt->applying);
+    mj_step(pt->m, d);
+    atomic_fetch_add(&pt->steps, 1);
+    for (int w = 0; w < mjNWARNING; w++) {
+        if (d->warning[w].number > pt->warn0[w]) {
+            atomic_store(&pt->error, w);
+            break;
+        }
+    }
+    snap_write(pt, pt->back);
+    int old = atomic_exchange(&pt->middle, pt->back | MJA_SNAP_FRESH);
+    pt->back = old & 3;
+}
+
+// Steps whenever the data falls behind the wall-driven clock and sleeps
+// otherwise. A stall longer than max_lag is dropped rather than replayed.
+static void* physics_main(void* arg) {
+    MjAccessPhysicsThread* pt = (MjAccessPhysicsThread*)arg;
+    const mjData* d = pt->data->mj;
+    double dt = pt->m->opt.timestep;
+    int idle = 0;
+    physics_rebase(pt);
+    while (!atomic_load(&pt->quit)) {
+        if (atomic_load(&pt->paused) || atomic_load(&pt->error) >= 0) {
+            idle = 1;
+            mja_sleep_us(1000);
+            continue;
+        }
+        pthread_mutex_lock(&pt->step_mutex);
+        if (idle) {
+            physics_rebase(pt);
+            idle = 0;
+        }
+        double clock = physics_clock(pt);
+        if (clock - d->time > pt->max_lag) {
+            physics_rebase(pt);
+            clock = d->time;
+        }
+        if (clock - d->time >= dt) physics_step(pt);
+        double wait_us = (d->time + dt - clock) / pt->speed * 1e6;
+        pthread_mutex_unlock(&pt->step_mutex);
+        if (wait_us >= 50) mja_sleep_us(wait_us > 2000 ? 2000 : (long)wait_us);
+    }
+    return NULL;
+}
+#endif
+
+MJA_API MjAccessPhysicsThread* mjaccess_physics_start(MjAccessData* data,
+                                                      const MjAccessPhysicsConfig* config) {
+#ifdef MJA_HAVE_THREADS
+    if (!data || !data->mj || !data->model_ref) return NULL;
+    MjAccessPhysicsThread* pt = (MjAccessPhysicsThread*)calloc(1, sizeof(MjAccessPhysicsThread));
+    if (!pt) return NULL;
+    pt->data = data;
+    pt->m = data->model_ref;
+    double dt = pt->m->opt.timestep;
+    pt->speed = config && config->speed > 0 ? config->speed : 1.0;
+    pt->max_lag = config && config->max_lag > 0 ? config->max_lag : 0.1;
+    pt->render_delay = config && config->render_delay > 0 ? config->render_delay : dt;
+    if (pt->max_lag < 2 * dt) pt->max_lag = 2 * dt;
+    pt->npose = data->xf_n;
+    pt->slot_bytes = (sizeof(MjaSnapHeader) + pt->npose * sizeof(MjAccessPose) +
+                      pt->m->nsensordata * sizeof(double) + 63) & ~(size_t)63;
+    pt->slots = (unsigned char*)malloc(4 * pt->slot_bytes);
+    if (!pt->slots) {
+        free(pt);
+        return NULL;
+    }
+    for (int w = 0; w < mjNWARNING; w++) pt->warn0[w] = data->mj->warning[w].number;
+    atomic_init(&pt->steps, 0);
+    // every slot starts as the current state, so the reader always has a pair
+    for (int k = 0; k < 4; k++) snap_write(pt, k);
+    pt->back = 0;
+    atomic_init(&pt->middle, 1);
+    pt->prev = 2;
+    pt->cur = 3;
+    atomic_init(&pt->error, -1);
+    atomic_init(&pt->paused, 0);
+    atomic_init(&pt->quit, 0);
+    pthread_mutex_init(&pt->cmd_mutex, NULL);
+    pthread_mutex_init(&pt->step_mutex, NULL);
+    if (pthread_create(&pt->thread, NULL, physics_main, pt) != 0) {
+        pthread_mutex_destroy(&pt->cmd_mutex);
+        pthread_mutex_destroy(&pt->step_mutex);
+        free(pt->slots);
+        free(pt);
+        return NULL;
+    }
+    return pt;
+#else
+    (void)data;
+    (void)config;
+    return NULL;
+#endif
+}
+
+// Joins the thread; queued commands that were never consumed are dropped.
+MJA_API void mjaccess_physics_stop(MjAccessPhysicsThread* pt) {
+    if (!pt) return;
+#ifdef MJA_HAVE_THREADS
+    atomic_store(&pt->quit, 1);
+    pthread_join(pt->thread, NULL);
+    pthread_mutex_destroy(&pt->cmd_mutex);
+    pthread_mutex_destroy(&pt->step_mutex);
+#endif
+    cmd_list_free(&pt->queued);
+    cmd_list_free(&pt->applying);
+    free(pt->slots);
+    free(pt);
+}
+
+MJA_API int mjaccess_physics_command(MjAccessPhysicsThread* pt, int type, int offset,
+                                     const double* values, int n) {
+    if (!pt) return -1;
+    if (type == MJA_CMD_RESET) {
+        if (offset >= pt->m->nkey) return -1;
+        n = 0;
+    } else if (!values || !cmd_target(pt->m, pt->data->mj, type, offset, n)) {
+        return -1;
+    }
+#ifdef MJA_HAVE_THREADS
+    pthread_mutex_lock(&pt->cmd_mutex);
+#endif
+    MjaCmdList* l = &pt->queued;
+    int ok = 1;
+    if (l->n == l->cap) {
+        int cap = l->cap ? l->cap * 2 : 16;
+        MjaCmd* cmds = (MjaCmd*)realloc(l->cmds, cap * sizeof(MjaCmd));
+        if (cmds) {
+            l->cmds = cmds;
+            l->cap = cap;
+        } else {
+            ok = 0;
+        }
+    }
+    if (ok && l->nvalues + n > l->values_cap) {
+        int cap = l->values_cap ? l->values_cap : 64;
+        while (cap < l->nvalues + n) cap *= 2;
+        double* v = (double*)realloc(l->values, cap * sizeof(double));
+        if (v) {
+            l->values = v;
+            l->values_cap = cap;
+        } else {
+            ok = 0;
+        }
+    }
+    if (ok) {
+        MjaCmd c = { type, offset, n, l->nvalues };
+        l->cmds[l->n++] = c;
+        if (n) memcpy(l->values + l->nvalues, values, n * sizeof(double));
+        l->nvalues += n;
+    }
+#ifdef MJA_HAVE_THREADS
+    pthread_mutex_unlock(&pt->cmd_mutex);
+#endif
+    return ok ? 0 : -1;
+}
+
+// Reader side, main thread only: take the newest snapshot if one was
+// published. Returns 1 when prev/cur advanced, 0 otherwise.
+MJA_API int mjaccess_physics_latest(MjAccessPhysicsThread* pt, MjAccessPhysicsFrame* prev,
+                                    MjAccessPhysicsFrame* cur) {
+    if (!pt) return -1;
+    int fresh = 0;
+    if (atomic_load(&pt->middle) & MJA_SNAP_FRESH) {
+        int got = atomic_exchange(&pt->middle, pt->prev);
+        pt->prev = pt->cur;
+        pt->cur = got & 3;
+        fresh = 1;
+    }
+    MjAccessPhysicsFrame* out[2] = { prev, cur };
+    int slot[2] = { pt->prev, pt->cur };
+    for (int k = 0; k < 2; k++) {
+        if (!out[k]) continue;
+        const MjaSnapHeader* h = snap_header(pt, slot[k]);
+        out[k]->time = h->time;
+        out[k]->step = h->step;
+        out[k]->poses = snap_poses(pt, slot[k]);
+        out[k]->sensordata = snap_sensors(pt, slot[k]);
+    }
+    return fresh;
+}
+
+// Poses at render_delay behind the sim time extrapolated from the newest
+// snapshot, blended between the held pair (lerp positions, nlerp rotations)
+// and clamped to it, so a paused or stalled thread shows its last state.
+MJA_API int mjaccess_physics_interpolate(MjAccessPhysicsThread* pt, MjAccessPose* out, int n) {
+    if (!pt || !out || n < pt->npose) return -1;
+    MjAccessPhysicsFrame a, b;
+    mjaccess_physics_latest(pt, &a, &b);
+    double alpha = 1;
+    double span = b.time - a.time;
+    if (span > 0) {
+        long long wall = snap_header(pt, pt->cur)->wall_ns;
+        double target = b.time + (mja_now_ns() - wall) * 1e-9 * pt->speed - pt->render_delay;
+        alpha = (target - a.time) / span;
+        alpha = alpha < 0 ? 0 : alpha > 1 ? 1 : alpha;
+    }
+    float t = (float)alpha;
+    for (int i = 0; i < pt->npose; i++) {
+        const MjAccessPose* p = &a.poses[i];
+        const MjAccessPose* q = &b.poses[i];
+        MjAccessPose* o = &out[i];
+        for (int k = 0; k < 3; k++) o->pos[k] = p->pos[k] + (q->pos[k] - p->pos[k]) * t;
+        float dot = p->rot[0] * q->rot[0] + p->rot[1] * q->rot[1] + p->rot[2] * q->rot[2] +
+                    p->rot[3] * q->rot[3];
+        float sign = dot < 0 ? -1.0f : 1.0f, norm = 0;
+        for (int k = 0; k < 4; k++) {
+            o->rot[k] = p->rot[k] * (1 - t) + q->rot[k] * sign * t;
+            norm += o->rot[k] * o->rot[k];
+        }
+        norm = norm > 0 ? 1.0f / sqrtf(norm) : 1.0f;
+        for (int k = 0; k < 4; k++) o->rot[k] *= norm;
+    }
+    return pt->npose;
+}
+
+// Exclusive access to the mjData between two steps, for code that must read
+// or write it directly; keep the section short, the thread waits on it.
+MJA_API void mjaccess_physics_lock(MjAccessPhysicsThread* pt) {
+#ifdef MJA_HAVE_THREADS
+    if (pt) pthread_mutex_lock(&pt->step_mutex);
+#else
+    (void)pt;
+#endif
+}
+
+MJA_API void mjaccess_physics_unlock(MjAccessPhysicsThread* pt) {
+#ifdef MJA_HAVE_THREADS
+    if (pt) pthread_mutex_unlock(&pt->step_mutex);
+#else
+    (void)pt;
+#endif
+}
+
+MJA_API void mjaccess_physics_set_paused(MjAccessPhysicsThread* pt, int paused) {
+    if (pt) atomic_store(&pt->paused, paused != 0);
+}
+
+MJA_API int mjaccess_physics_error(const MjAccessPhysicsThread* pt) {
+    return pt ? atomic_load(&pt->error) : -1;
+}
+
+MJA_API long long mjaccess_physics_steps(const MjAccessPhysicsThread* pt) {
+    return pt ? atomic_load(&pt->steps) : 0;
+}
+
+// ── Batched simulation ───────────────────────────────────────
+
+// Address of the mjData pointer that backs a batched field.
+static mjtNum** batched_field_ptr(mjData* d, int field) {
+    switch (field) {
+    case MJA_FIELD_QPOS:          return &d->qpos;
+    case MJA_FIELD_QVEL:          return &d->qvel;
+    case MJA_FIELD_CTRL:          return &d->ctrl;
+    case MJA_FIELD_XPOS:          return &d->xpos;
+    case MJA_FIELD_XQUAT:         return &d->xquat;
+    case MJA_FIELD_SUBTREE_COM:   return &d->subtree_com;
+    case MJA_FIELD_CINERT:        return &d->cinert;
+    case MJA_FIELD_CVEL:          return &d->cvel;
+    case MJA_FIELD_QFRC_ACTUATOR: return &d->qfrc_actuator;
+    case MJA_FIELD_CFRC_EXT:      return &d->cfrc_ext;
+    case MJA_FIELD_SENSORDATA:    return &d->sensordata;
+    case MJA_FIELD_GEOM_XPOS:     return &d->geom_xpos;
+    case MJA_FIELD_GEOM_XMAT:     return &d->geom_xmat;
+    default:                      return NULL;
+    }
+}
+
+static int batched_field_dim(const mjModel* m, int field) {
+    switch (field) {
+    case MJA_FIELD_QPOS:          return m->nq;
+    case MJA_FIELD_QVEL:          return m->nv;
+    case MJA_FIELD_CTRL:          return m->nu;
+    case MJA_FIELD_XPOS:          return m->nbody * 3;
+    case MJA_FIELD_XQUAT:         return m->nbody * 4;
+    case MJA_FIELD_SUBTREE_COM:   return m->nbody * 3;
+    case MJA_FIELD_CINERT:        return m->nbody * 10;
+    case MJA_FIELD_CVEL:          return m->nbody * 6;
+    case MJA_FIELD_QFRC_ACTUATOR: return m->nv;
+    case MJA_FIELD_CFRC_EXT:      return m->nbody * 6;
+    case MJA_FIELD_SENSORDATA:    return m->nsensordata;
+    case MJA_FIELD_GEOM_XPOS:     return m->ngeom * 3;
+    case MJA_FIELD_GEOM_XMAT:     return m->ngeom * 9;
+    default:                      return 0;
+    }
+}
+
+static void batched_free_buffers(MjAccessBatchedSim* sim) {
+    if (sim->slab_arena) {
+        free(sim->slab_arena);
+        sim->slab_arena = NULL;
+    } else {
+        for (int f = 0; f < MJA_FIELD_COUNT; f++) free(sim->bufs[f]);
+    }
+    memset(sim->bufs, 0, sizeof(sim->bufs));
+}
+
+static void batched_obs_norm_free(MjAccessBatchedSim* sim) {
+    free(sim->obs_parts);
+    free(sim->obs_norm_arena);
+    sim->obs_parts = NULL;
+    sim->obs_norm_arena = NULL;
+    memset(&sim->obs_stats, 0, sizeof(sim->obs_stats));
+    sim->obs_shift = sim->obs_scale = NULL;
+    sim->obs_norm = 0;
+}
+
+// Carve one 64-byte aligned [num_envs * dim] slab per field out of a single
+// allocation, move each env's current values into its row and repoint mjData.
+static int batched_make_slabs(MjAccessBatchedSim* sim) {
+    size_t ne = (size_t)sim->num_envs;
+    size_t offsets[MJA_FIELD_COUNT];
+    size_t total = 0;
+    for (int f = 0; f < MJA_FIELD_COUNT; f++) {
+        offsets[f] = total;
+        total += (ne * sim->dims[f] * sizeof(double) + 63) & ~(size_t)63;
+    }
+    sim->slab_arena = malloc(total + 64);
+    if (!sim->slab_arena) return -1;
+    char* base = (char*)(((uintptr_t)sim->slab_arena + 63) & ~(uintptr_t)63);
+
+    for (int f = 0; f < MJA_FIELD_COUNT; f++) {
+        int dim = sim->dims[f];
+        sim->bufs[f] = (double*)(base + offsets[f]);
+        for (size_t i = 0; i < ne; i++) {
+            mjtNum** field = batched_field_ptr(sim->datas[i], f);
+            double* row = sim->bufs[f] + i * dim;
+            if (dim > 0) memcpy(row, *field, dim * sizeof(double));
+            *field = row;
+        }
+    }
+    sim->contiguous = 1;
+    return 0;
+}
+
+// Address of the mjModel pointer that backs a randomizable parameter.
+static mjtNum** param_field_ptr(mjModel* m, int param) {
+    switch (param) {
+    case MJA_PARAM_BODY_MASS:        return &m->body_mass;
+    case MJA_PARAM_GEOM_FRICTION:    return &m->geom_friction;
+    case MJA_PARAM_DOF_DAMPING:      return &m->dof_damping;
+    case MJA_PARAM_ACTUATOR_GAINPRM: return &m->actuator_gainprm;
+    default:                         return NULL;
+    }
+}
+
+// Components per object, and objects per env row.
+static int param_width(int param) {
+    switch (param) {
+    case MJA_PARAM_GEOM_FRICTION:    return 3;
+    case MJA_PARAM_ACTUATOR_GAINPRM: return mjNGAIN;
+    default:                         return 1;
+    }
+}
+
+static int param_count(const mjModel* m, int param) {
+    switch (param) {
+    case MJA_PARAM_BODY_MASS:        return m->nbody;
+    case MJA_PARAM_GEOM_FRICTION:    return m->ngeom;
+    case MJA_PARAM_DOF_DAMPING:      return m->nv;
+    case MJA_PARAM_ACTUATOR_GAINPRM: return m->nu;
+    default:                         return 0;
+    }
+}
+
+static void batched_params_free(MjAccessBatchedSim* sim) {
+    for (int p = 0; p < MJA_PARAM_COUNT; p++) {
+        free(sim->params[p]);
+        sim->params[p] = NULL;
+    }
+    free(sim->subtreemass);
+    free(sim->env_models);
+    sim->subtreemass = NULL;
+    free(sim->rand_terms);
+    sim->env_models = NULL;
+    sim->rand_terms = NULL;
+    sim->rand_nterms = sim->rand_cap = 0;
+    sim->params_on = 0;
+}
+
+// body_subtreemass is summed from body_mass when the model is compiled, and
+// mj_comPos divides by it, so a randomized mass row needs its own sums.
+static void batched_sum_subtreemass(MjAccessBatchedSim* sim, int env) {
+    const mjModel* m = sim->model_ref;
+    const double* mass = sim->params[MJA_PARAM_BODY_MASS] + (size_t)env * m->nbody;
+    double* sub = sim->subtreemass + (size_t)env * m->nbody;
+    memcpy(sub, mass, m->nbody * sizeof(double));
+    for (int b = m->nbody - 1; b > 0; b--) sub[m->body_parentid[b]] += sub[b];
+}
+
+// Refresh the per-worker model copies from the shared model before a job, so
+// option or parameter changes made between jobs are picked up.
+static void batched_sync_models(MjAccessBatchedSim* sim) {
+    if (!sim->params_on) return;
+    for (int w = 0; w < sim->pool->num_threads; w++)
+        sim->env_models[w] = *sim->model_ref;
+    // Callers may keep the mass table and write it at any time, so once it has
+    // been handed out the sums are redone per job (nbody adds per env).
+    if (sim->subtreemass_stale) {
+        for (int i = 0; i < sim->num_envs; i++) batched_sum_subtreemass(sim, i);
+    }
+}
+
+// The model a worker steps env `env` with: the shared model, or the worker's
+// copy with each randomized array pointing at the env's row.
+static mjModel* batched_env_model(const MjAccessBatchedSim* sim, int env, int worker) {
+    if (!sim->params_on) return sim->model_ref;
+    mjModel* m = &sim->env_models[worker];
+    for (int p = 0; p < MJA_PARAM_COUNT; p++) {
+        if (sim->params[p])
+            *param_field_ptr(m, p) = sim->params[p] + (size_t)env * sim->param_dim[p];
+    }
+    if (sim->subtreemass)
+        m->body_subtreemass = sim->subtreemass + (size_t)env * sim->model_ref->nbody;
+    return m;
+}
+
+// mj_resetData clears mjData's own buffer, which no longer backs the
+// redirected fields, so clear the slab rows before resetting.
+static void batched_reset_env(MjAccessBatchedSim* sim, int env) {
+    mjData* d = sim->datas[env];
+    if (sim->contiguous) {
+        for (int f = 0; f < MJA_FIELD_COUNT; f++) {
+            if (sim->dims[f] > 0)
+                memset(*batched_field_ptr(d, f), 0, sim->dims[f] * sizeof(double));
+        }
+    }
+    mj_resetData(sim->model_ref, d);
+    if (sim->rec) recorder_new_episode(sim->rec, env);
+}
+
+// splitmix64: one independent stream per env, so snapshot picks do not
+// depend on which worker handled the env.
+static uint64_t batched_rng_next(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static void batched_seed_rng(MjAccessBatchedSim* sim, uint64_t seed) {
+    for (int i = 0; i < sim->num_envs; i++) {
+        uint64_t s = seed ^ ((uint64_t)i * 0xD1B54A32D192ED03ull);
+        sim->rng[i] = batched_rng_next(&s);
+        sim->rand_rng[i] = batched_rng_next(&s);
+    }
+}
+
+static double batched_rng_uniform(uint64_t* state) {
+    return (double)(batched_rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double rand_sample(const MjAccessRandTerm* t, uint64_t* state) {
+    double u = batched_rng_uniform(state);
+    switch (t->dist) {
+    case MJA_DIST_LOG_UNIFORM:
+        return exp(log(t->a) + u * (log(t->b) - log(t->a)));
+    case MJA_DIST_GAUSSIAN: {
+        double v = batched_rng_uniform(state);
+        return t->a + t->b * sqrt(-2.0 * log(1.0 - u)) * cos(2.0 * mjPI * v);
+    }
+    default:
+        return t->a + u * (t->b - t->a);
+    }
+}
+
+// Redraw one env's parameter rows: start from the shared model's values and
+// apply the terms in order.
+static void batched_resample_env(MjAccessBatchedSim* sim, int env) {
+    for (int p = 0; p < MJA_PARAM_COUNT; p++) {
+        if (!sim->params[p]) continue;
+        memcpy(sim->params[p] + (size_t)env * sim->param_dim[p],
+               *param_field_ptr(sim->model_ref, p), sim->param_dim[p] * sizeof(double));
+    }
+    uint64_t* state = &sim->rand_rng[env];
+    for (int k = 0; k < sim->rand_nterms; k++) {
+        const MjAccessRandTerm* t = &sim->rand_terms[k];
+        int w = param_width(t->param);
+        int count = sim->param_dim[t->param] / w;
+        double* row = sim->params[t->param] + (size_t)env * sim->param_dim[t->param];
+        int o0 = t->obj < 0 ? 0 : t->obj, o1 = t->obj < 0 ? count : t->obj + 1;
+        int c0 = t->component < 0 ? 0 : t->component;
+        int c1 = t->component < 0 ? w : t->component + 1;
+        double shared = t->shared ? rand_sample(t, state) : 0;
+        for (int o = o0; o < o1; o++) {
+            for (int c = c0; c < c1; c++) {
+                double x = t->shared ? shared : rand_sample(t, state);
+                double* v = row + o * w + c;
+                switch (t->op) {
+                case MJA_RAND_ADD: *v += x; break;
+                case MJA_RAND_SET: *v = x;  break;
+                default:           *v *= x; break;
+                }
+            }
+        }
+    }
+    if (sim->subtreemass) batched_sum_subtreemass(sim, env);
+}
+
+// Reset one env to a pooled snapshot (snap < 0: random pick) or, with an
+// empty pool, to the model default; then recompute derived quantities.
+static void batched_restart_env(MjAccessBatchedSim* sim, int env, int snap, int worker) {
+    mjData* d = sim->datas[env];
+    if (sim->rand_on_reset && sim->rand_nterms) batched_resample_env(sim, env);
+    mjModel* m = batched_env_model(sim, env, worker);
+    batched_reset_env(sim, env);
+    if (sim->snap_count > 0) {
+        if (snap < 0 || snap >= sim->snap_count)
+            snap = (int)(batched_rng_next(&sim->rng[env]) % (uint64_t)sim->snap_count);
+        mj_setState(m, d, sim->snaps + (size_t)snap * sim->snap_size, sim->snap_spec);
+    }
+    mj_forward(m, d);
+    sim->reset_flags[env] = 1;
+}
+
+// Bad-state warnings are cleared before each step in detection mode, so any
+// count here was raised by that step (MuJoCo has already reset the env).
+static int batched_bad_state(const mjModel* m, mjData* d) {
+    if (d->warning[mjWARN_BADQPOS].number || d->warning[mjWARN_BADQVEL].number ||
+        d->warning[mjWARN_BADQACC].number)
+        return 1;
+    for (int j = 0; j < m->nq; j++) if (mju_isBad(d->qpos[j])) return 1;
+    for (int j = 0; j < m->nv; j++) if (mju_isBad(d->qvel[j])) return 1;
+    return 0;
+}
+
+static void batched_clear_bad_state(mjData* d) {
+    d->warning[mjWARN_BADQPOS].number = 0;
+    d->warning[mjWARN_BADQVEL].number = 0;
+    d->warning[mjWARN_BADQACC].number = 0;
+}
+
+// Block until the in-flight async step (if any) has finished.
+static void batched_async_join(MjAccessBatchedSim* sim) {
+#ifdef MJA_HAVE_THREADS
+    if (!atomic_load_explicit(&sim->async_busy, memory_order_acquire)) return;
+    pthread_mutex_lock(&sim->async_mutex);
+    while (atomic_load_explicit(&sim->async_busy, memory_order_acquire))
+        pthread_cond_wait(&sim->async_cv, &sim->async_mutex);
+    pthread_mutex_unlock(&sim->async_mutex);
+#else
+    (void)sim;
+#endif
+}
+
+static void batched_async_stop(MjAccessBatchedSim* sim) {
+#ifdef MJA_HAVE_THREADS
+    if (!sim->async_started) return;
+    pthread_mutex_lock(&sim->async_mutex);
+    sim->async_quit = 1;
+    pthread_cond_broadcast(&sim->async_cv);
+    pthread_mutex_unlock(&sim->async_mutex);
+    pthread_join(sim->async_thread, NULL);
+    pthread_cond_destroy(&sim->async_cv);
+    pthread_mutex_destroy(&sim->async_mutex);
+    sim->async_started = 0;
+#else
+    (void)sim;
+#endif
+}
+
+// Create a sim on its own worker pool, or on `pool` when one is shared.
+static MjAccessBatchedSim* batched_create(MjAccessModel* model, const MjAccessBatchedConfig* config,
+                                          MjaPool* pool) {
+    if (!model || !model->mj || !config || config->num_envs <= 0) return NULL;
+    mjModel* mj = model->mj;
+    int ne = config->num_envs;
+
+    MjAccessBatchedSim* sim = (MjAccessBatchedSim*)calloc(1, sizeof(MjAccessBatchedSim));
+    sim->model_ref = mj;
+    sim->num_envs = ne;
+    sim->datas = (mjData**)calloc(ne, sizeof(mjData*));
+
+    for (int i = 0; i < ne; i++) {
+        sim->datas[i] = mj_makeData(mj);
+        if (!sim->datas[i]) {
+            mjaccess_batched_free(sim);
+            return NULL;
+        }
+    }
+
+    if (config->solver_iterations > 0)
+        mj->opt.iterations = config->solver_iterations;
+
+    if (pool) {
+        sim->pool = pool;
+    } else {
+        int nt = config->num_threads > 0 ? config->num_threads : mja_online_cpus();
+        if (nt > ne) nt = ne;
+        sim->pool = pool_create(nt, config->chunk_size, config->pin_threads, config->cpu_offset);
+        sim->owns_pool = 1;
+    }
+    if (!sim->pool) {
+        mjaccess_batched_free(sim);
+        return NULL;
+    }
+
+    for (int f = 0; f < MJA_FIELD_COUNT; f++)
+        sim->dims[f] = batched_field_dim(mj, f);
+
+    sim->snap_spec   = mjSTATE_INTEGRATION;
+    sim->snap_size   = mj_stateSize(mj, sim->snap_spec);
+    sim->rng         = (uint64_t*)malloc(ne * sizeof(uint64_t));
+    sim->rand_rng    = (uint64_t*)malloc(ne * sizeof(uint64_t));
+    sim->done        = (int*)calloc(ne, sizeof(int));
+    sim->done_index  = (int*)malloc(ne * sizeof(int));
+    sim->reset_flags = (int*)calloc(ne, sizeof(int));
+    sim->active_envs = (int*)malloc(ne * sizeof(int));
+    if (!sim->rng || !sim->rand_rng || !sim->done || !sim->done_index || !sim->reset_flags ||
+        !sim->active_envs) {
+        mjaccess_batched_free(sim);
+        return NULL;
+    }
+    for (int i = 0; i < ne; i++) sim->active_envs[i] = i;
+    sim->active_count = ne;
+    batched_seed_rng(sim, 0);
+
+    if (config->contiguous_state) {
+        if (batched_make_slabs(sim) != 0) {
+            mjaccess_batched_free(sim);
+            return NULL;
+        }
+    } else {
+        // Pre-allocate gather buffers
+        for (int f = 0; f < MJA_FIELD_COUNT; f++)
+            sim->bufs[f] = (double*)malloc((size_t)ne * sim->dims[f] * sizeof(double));
+    }
+
+    sim->owner = model;
+    model->dependents++;
     return sim;
 }
 
+MJA_API MjAccessBatchedSim* mjaccess_batched_create(MjAccessModel* model,
+                                                    const MjAccessBatchedConfig* config) {
+    return batched_create(model, config, NULL);
+}
+
 MJA_API void mjaccess_batched_free(MjAccessBatchedSim* sim) {
     if (!sim) return;
+    if (sim->owner) sim->owner->dependents--;
+    batched_async_stop(sim);
+    if (sim->rec) recorder_close(sim->rec);
+    fd_free(sim->fd);
+    free(sim->contact_filter.geom_side);
+    free(sim->contacts);
+    free(sim->contact_counts);
+    free(sim->scatter);
+    free(sim->scatter_ints);
+    free(sim->scatter_values);
+    free(sim->scatter_seen);
+    if (sim->owns_pool) pool_destroy(sim->pool);
     if (sim->datas) {
         for (int i = 0; i < sim->num_envs; i++) {
             if (sim->datas[i]) mj_deleteData(sim->datas[i]);
@@ -437,74 +3236,2436 @@ MJA_API void mjaccess_batched_free(MjAccessBatchedSim* sim) {
         free(sim->datas);
     }
     batched_free_buffers(sim);
+    free(sim->snaps);
+    free(sim->rng);
+    free(sim->rand_rng);
+    batched_params_free(sim);
+    free(sim->done);
+    free(sim->done_index);
+    free(sim->reset_flags);
+    free(sim->active);
+    free(sim->active_envs);
+    free(sim->obs_runs);
+    free(sim->obs_buf);
+    batched_obs_norm_free(sim);
+    free(sim->rew_ret);
+    free(sim->async_ctrl);
+    free(sim->render_batches);
+    free(sim->render_geoms);
+    free(sim->render_scale);
+    if (sim->prof) {
+        free(sim->prof);
+        free(sim->prof_seen);
+        profile_clock_release();
+    }
     free(sim);
 }
 
-MJA_API void mjaccess_batched_step(MjAccessBatchedSim* sim, const double* ctrl) {
-    if (!sim || !ctrl) return;
-    mjModel* m = sim->model_ref;
-    int ne = sim->num_envs;
-    int nu = m->nu;
-
-#ifdef __APPLE__
-    dispatch_apply((size_t)ne,
-        dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0),
-        ^(size_t i) {
-            mjData* d = sim->datas[i];
-            memcpy(d->ctrl, ctrl + i * nu, nu * sizeof(double));
-            mj_step(m, d);
-        }
-    );
-#else
-    for (int i = 0; i < ne; i++) {
-        mjData* d = sim->datas[i];
-        memcpy(d->ctrl, ctrl + i * nu, nu * sizeof(double));
-        mj_step(m, d);
+// Vectorized double -> float narrowing.
+static void mja_cvt_f64_f32(float* dst, const double* src, int n) {
+    int i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+#elif defined(__SSE2__) || defined(_M_X64)
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4) {
+        float32x2_t lo = vcvt_f32_f64(vld1q_f64(src + i));
+        float32x2_t hi = vcvt_f32_f64(vld1q_f64(src + i + 2));
+        vst1q_f32(dst + i, vcombine_f32(lo, hi));
+    }
+#endif
+    for (; i < n; i++) dst[i] = (float)src[i];
+}
+
+static const double* obs_source_ptr(const mjData* d, int src) {
+    switch (src) {
+    case MJA_OBS_SRC_QPOS:        return d->qpos;
+    case MJA_OBS_SRC_QVEL:        return d->qvel;
+    case MJA_OBS_SRC_CTRL:        return d->ctrl;
+    case MJA_OBS_SRC_XPOS:        return d->xpos;
+    case MJA_OBS_SRC_XQUAT:       return d->xquat;
+    case MJA_OBS_SRC_CVEL:        return d->cvel;
+    case MJA_OBS_SRC_SUBTREE_COM: return d->subtree_com;
+    case MJA_OBS_SRC_CFRC_EXT:    return d->cfrc_ext;
+    case MJA_OBS_SRC_SITE_XPOS:   return d->site_xpos;
+    case MJA_OBS_SRC_GEOM_XPOS:   return d->geom_xpos;
+    case MJA_OBS_SRC_SENSORDATA:  return d->sensordata;
+    default:                      return NULL;
+    }
+}
+
+static void batched_write_obs(const MjAccessBatchedSim* sim, int env) {
+    const mjData* d = sim->datas[env];
+    float* row = sim->obs_out + (size_t)env * sim->obs_dim;
+    for (int r = 0; r < sim->obs_nruns; r++) {
+        const MjaObsRun* run = &sim->obs_runs[r];
+        mja_cvt_f64_f32(row + run->dst_off, obs_source_ptr(d, run->src) + run->src_off, run->len);
+    }
+}
+
+// Fold one float row into a partial: mean += d / n, m2 += d * (x - mean').
+static void moments_push(MjaMoments* s, const float* x, int dim) {
+    double* mean = s->mean;
+    double* m2 = s->m2;
+    double inv = 1.0 / (s->count += 1.0);
+    int j = 0;
+#if defined(__AVX__)
+    __m256d vinv = _mm256_set1_pd(inv);
+    for (; j + 4 <= dim; j += 4) {
+        __m256d v  = _mm256_cvtps_pd(_mm_loadu_ps(x + j));
+        __m256d mu = _mm256_loadu_pd(mean + j);
+        __m256d d  = _mm256_sub_pd(v, mu);
+        mu = _mm256_add_pd(mu, _mm256_mul_pd(d, vinv));
+        _mm256_storeu_pd(mean + j, mu);
+        _mm256_storeu_pd(m2 + j, _mm256_add_pd(_mm256_loadu_pd(m2 + j),
+                                               _mm256_mul_pd(d, _mm256_sub_pd(v, mu))));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128d vinv = _mm_set1_pd(inv);
+    for (; j + 2 <= dim; j += 2) {
+        __m128d v  = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)(x + j))));
+        __m128d mu = _mm_loadu_pd(mean + j);
+        __m128d d  = _mm_sub_pd(v, mu);
+        mu = _mm_add_pd(mu, _mm_mul_pd(d, vinv));
+        _mm_storeu_pd(mean + j, mu);
+        _mm_storeu_pd(m2 + j, _mm_add_pd(_mm_loadu_pd(m2 + j), _mm_mul_pd(d, _mm_sub_pd(v, mu))));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    float64x2_t vinv = vdupq_n_f64(inv);
+    for (; j + 2 <= dim; j += 2) {
+        float64x2_t v  = vcvt_f64_f32(vld1_f32(x + j));
+        float64x2_t mu = vld1q_f64(mean + j);
+        float64x2_t d  = vsubq_f64(v, mu);
+        mu = vfmaq_f64(mu, d, vinv);
+        vst1q_f64(mean + j, mu);
+        vst1q_f64(m2 + j, vfmaq_f64(vld1q_f64(m2 + j), d, vsubq_f64(v, mu)));
+    }
+#endif
+    for (; j < dim; j++) {
+        double d = x[j] - mean[j];
+        mean[j] += d * inv;
+        m2[j] += d * (x[j] - mean[j]);
+    }
+}
+
+// Merge partial b into a and clear b.
+static void moments_merge(MjaMoments* a, MjaMoments* b, int dim) {
+    if (b->count == 0) return;
+    double n = a->count + b->count;
+    double wb = b->count / n;
+    double cross = a->count * wb;
+    for (int j = 0; j < dim; j++) {
+        double d = b->mean[j] - a->mean[j];
+        a->mean[j] += d * wb;
+        a->m2[j] += b->m2[j] + d * d * cross;
+    }
+    a->count = n;
+    b->count = 0;
+    memset(b->mean, 0, dim * sizeof(double));
+    memset(b->m2, 0, dim * sizeof(double));
+}
+
+// x = clamp((x - shift) * scale, -clip, clip)
+static void norm_apply(float* x, const float* shift, const float* scale, float clip, int dim) {
+    int j = 0;
+#if defined(__AVX__)
+    __m256 hi8 = _mm256_set1_ps(clip), lo8 = _mm256_set1_ps(-clip);
+    for (; j + 8 <= dim; j += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(x + j), _mm256_loadu_ps(shift + j)),
+                                 _mm256_loadu_ps(scale + j));
+        _mm256_storeu_ps(x + j, _mm256_min_ps(_mm256_max_ps(v, lo8), hi8));
+    }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128 hi = _mm_set1_ps(clip), lo = _mm_set1_ps(-clip);
+    for (; j + 4 <= dim; j += 4) {
+        __m128 v = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + j), _mm_loadu_ps(shift + j)),
+                              _mm_loadu_ps(scale + j));
+        _mm_storeu_ps(x + j, _mm_min_ps(_mm_max_ps(v, lo), hi));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    float32x4_t hi = vdupq_n_f32(clip), lo = vdupq_n_f32(-clip);
+    for (; j + 4 <= dim; j += 4) {
+        float32x4_t v = vmulq_f32(vsubq_f32(vld1q_f32(x + j), vld1q_f32(shift + j)),
+                                  vld1q_f32(scale + j));
+        vst1q_f32(x + j, vminq_f32(vmaxq_f32(v, lo), hi));
+    }
+#endif
+    for (; j < dim; j++) {
+        float v = (x[j] - shift[j]) * scale[j];
+        x[j] = v < -clip ? -clip : v > clip ? clip : v;
+    }
+}
+
+// Rows are normalized with the statistics as of the previous job and folded
+// into the worker's partial in the same pass, so no second sweep is needed.
+static void batched_norm_obs(const MjAccessBatchedSim* sim, int env, int worker, int update) {
+    float* row = sim->obs_out + (size_t)env * sim->obs_dim;
+    if (update && !sim->norm_frozen) moments_push(&sim->obs_parts[worker], row, sim->obs_dim);
+    norm_apply(row, sim->obs_shift, sim->obs_scale, sim->obs_clip, sim->obs_dim);
+}
+
+static void obs_norm_update_scale(MjAccessBatchedSim* sim) {
+    const MjaMoments* s = &sim->obs_stats;
+    for (int j = 0; j < sim->obs_dim; j++) {
+        if (s->count > 0) {
+            sim->obs_shift[j] = (float)s->mean[j];
+            sim->obs_scale[j] = (float)(1.0 / sqrt(s->m2[j] / s->count + sim->obs_eps));
+        } else {
+            sim->obs_shift[j] = 0.0f;
+            sim->obs_scale[j] = 1.0f;
+        }
+    }
+}
+
+// Called on the caller thread once the workers of a job have joined.
+static void batched_obs_norm_merge(MjAccessBatchedSim* sim) {
+    if (!sim->obs_norm || sim->norm_frozen) return;
+    for (int w = 0; w < sim->pool->num_threads; w++)
+        moments_merge(&sim->obs_stats, &sim->obs_parts[w], sim->obs_dim);
+    obs_norm_update_scale(sim);
+}
+
+// Copy the bound output fields and the observation row of one env while its
+// mjData is still in cache. update folds the row into the normalization
+// statistics; caller-requested resets skip it.
+static void batched_write_outputs(const MjAccessBatchedSim* sim, int env, int worker, int update) {
+    if (sim->obs_nruns && sim->obs_out) {
+        batched_write_obs(sim, env);
+        if (sim->obs_norm) batched_norm_obs(sim, env, worker, update);
+    }
+    if (sim->contact_cap) {
+        int cap = sim->contact_cap;
+        int n = contact_export(&sim->contact_filter, batched_env_model(sim, env, worker),
+                               sim->datas[env], sim->contacts + (size_t)env * cap, cap);
+        sim->contact_counts[env] = n < cap ? n : cap;
+    }
+    unsigned mask = sim->output_mask;
+    if (!mask) return;
+    mjData* d = sim->datas[env];
+    for (int f = 0; mask; f++, mask >>= 1) {
+        if (!(mask & 1u)) continue;
+        int dim = sim->dims[f];
+        double* dst = sim->outputs[f] + (size_t)env * dim;
+        const double* src = *batched_field_ptr(d, f);
+        if (dst != src) memcpy(dst, src, dim * sizeof(double));
+    }
+}
+
+// Copy the recorded fields of one env into the claimed ring slot. Restarted
+// envs begin a new episode at step 0; stepped envs advance their step and
+// inactive envs repeat it.
+static void batched_record_env(const MjAccessBatchedSim* sim, int env, int advance) {
+    MjaRecorder* r = sim->rec;
+    if (!r->cur) return;
+    if (advance && !sim->reset_flags[env]) r->episode_step[env]++;
+    unsigned char* row = r->cur + (size_t)env * r->info.row_bytes;
+    memcpy(row, &r->episode[env], sizeof(int32_t));
+    memcpy(row + sizeof(int32_t), &r->episode_step[env], sizeof(int32_t));
+    mjData* d = sim->datas[env];
+    for (int f = 0; f < MJA_FIELD_COUNT; f++) {
+        if (r->field_off[f] < 0) continue;
+        const double* src = *batched_field_ptr(d, f);
+        if (r->info.elem_size == 4)
+            mja_cvt_f64_f32((float*)(row + r->field_off[f]), src, sim->dims[f]);
+        else
+            memcpy(row + r->field_off[f], src, sim->dims[f] * sizeof(double));
+    }
+}
+
+typedef struct {
+    MjAccessBatchedSim* sim;
+    const double*       ctrl;
+    int                 n_substeps;
+    int                 schedule;  // ctrl is [num_envs][n_substeps][nu]
+    int                 first;     // job index 0 is env `first`
+    const int*          envs;      // job index -> env, NULL = first + index
+} BatchedStepJob;
+
+// Each env stays on one worker for all of its substeps. Envs flagged done
+// are restarted instead of stepped; with bad-state detection an env whose
+// substep diverges is restarted and skips its remaining substeps.
+static void batched_step_env(const BatchedStepJob* job, int i, int worker) {
+    MjAccessBatchedSim* sim = job->sim;
+    int nu = sim->model_ref->nu;
+    int ns = job->n_substeps;
+    int detect = sim->detect_bad_state;
+    mjData* d = sim->datas[i];
+    mjModel* m = batched_env_model(sim, i, worker);
+    sim->reset_flags[i] = 0;
+    if (sim->done_pending && sim->done[i]) {
+        sim->done[i] = 0;
+        batched_restart_env(sim, i, sim->done_index[i], worker);
+        batched_write_outputs(sim, i, worker, 1);
+        if (sim->rec) batched_record_env(sim, i, 1);
+        return;
+    }
+    MjaProfileAcc* prof = sim->prof ? &sim->prof[worker] : NULL;
+    long long t0 = prof ? mja_now_ns() : 0;
+    const double* src = job->schedule ? job->ctrl + (size_t)i * ns * nu
+                                      : job->ctrl + (size_t)i * nu;
+    if (!job->schedule && d->ctrl != src) memcpy(d->ctrl, src, nu * sizeof(double));
+    int k = 0;
+    while (k < ns) {
+        if (job->schedule) memcpy(d->ctrl, src + (size_t)k * nu, nu * sizeof(double));
+        if (detect) batched_clear_bad_state(d);
+        mj_step(m, d);
+        k++;
+        if (detect && batched_bad_state(m, d)) {
+            batched_restart_env(sim, i, -1, worker);
+            break;
+        }
+    }
+    if (!prof) {
+        batched_write_outputs(sim, i, worker, 1);
+        if (sim->rec) batched_record_env(sim, i, 1);
+        return;
+    }
+    long long t1 = mja_now_ns();
+    batched_write_outputs(sim, i, worker, 1);
+    if (sim->rec) batched_record_env(sim, i, 1);
+    long long t2 = mja_now_ns();
+    MjAccessProfile* p = &prof->p;
+    profile_harvest(p, d, sim->prof_seen + (size_t)i * mjNTIMER);
+    p->env_steps += k;
+    p->step_ms += (t1 - t0) * 1e-6;
+    p->gather_ms += (t2 - t1) * 1e-6;
+    p->step_hist[profile_bin((t1 - t0) / k)] += k;
+    prof->busy_ms += (t2 - t0) * 1e-6;
+}
+
+static void batched_step_task(void* ctx, int begin, int end, int worker) {
+    const BatchedStepJob* job = (const BatchedStepJob*)ctx;
+    if (job->envs) {
+        for (int k = begin; k < end; k++) batched_step_env(job, job->envs[k], worker);
+        return;
+    }
+    for (int i = begin + job->first; i < end + job->first; i++)
+        batched_step_env(job, i, worker);
+}
+
+// First position in the active list holding an env >= `env`.
+static int batched_active_lower(const MjAccessBatchedSim* sim, int env) {
+    int lo = 0, hi = sim->active_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (sim->active_envs[mid] < env) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Inactive envs in [first, first + count) are not stepped: clear their
+// restart and done flags and, when recording, repeat their current row.
+static void batched_idle_envs(MjAccessBatchedSim* sim, int first, int count) {
+    for (int i = first; i < first + count; i++) {
+        if (sim->active[i]) continue;
+        sim->reset_flags[i] = 0;
+        sim->done[i] = 0;
+        if (sim->rec) batched_record_env(sim, i, 0);
+    }
+}
+
+// With a partial mask the job walks the run of the active list inside its
+// env range, so idle envs take no worker time.
+static void batched_run_step(MjAccessBatchedSim* sim, BatchedStepJob* job, int count) {
+    batched_sync_models(sim);
+    if (sim->rec) recorder_acquire(sim->rec, job->first, count);
+    if (sim->active) {
+        batched_idle_envs(sim, job->first, count);
+        int lo = batched_active_lower(sim, job->first);
+        int hi = batched_active_lower(sim, job->first + count);
+        job->envs = sim->active_envs + lo;
+        count = hi - lo;
+    }
+    long long t0 = sim->prof ? mja_now_ns() : 0;
+    pool_run(sim->pool, count, batched_step_task, job);
+    if (sim->prof) {
+        sim->prof_wall_ms += (mja_now_ns() - t0) * 1e-6;
+        sim->prof_jobs++;
+    }
+    if (sim->rec) recorder_publish(sim->rec);
+    batched_obs_norm_merge(sim);
+}
+
+MJA_API void mjaccess_batched_step(MjAccessBatchedSim* sim, const double* ctrl) {
+    mjaccess_batched_step_n(sim, ctrl, 1);
+}
+
+MJA_API void mjaccess_batched_step_n(MjAccessBatchedSim* sim, const double* ctrl,
+                                     int n_substeps) {
+    if (!sim || !ctrl || n_substeps <= 0) return;
+    batched_async_join(sim);
+    batched_scatter_flush(sim);
+    BatchedStepJob job = { sim, ctrl, n_substeps, 0, 0, NULL };
+    batched_run_step(sim, &job, sim->num_envs);
+    sim->done_pending = 0;
+}
+
+MJA_API void mjaccess_batched_step_schedule(MjAccessBatchedSim* sim, const double* ctrl_schedule,
+                                            int n_substeps) {
+    if (!sim || !ctrl_schedule || n_substeps <= 0) return;
+    batched_async_join(sim);
+    batched_scatter_flush(sim);
+    BatchedStepJob job = { sim, ctrl_schedule, n_substeps, 1, 0, NULL };
+    batched_run_step(sim, &job, sim->num_envs);
+    sim->done_pending = 0;
+}
+
+#ifdef MJA_HAVE_THREADS
+static void* batched_async_main(void* arg) {
+    MjAccessBatchedSim* sim = (MjAccessBatchedSim*)arg;
+    pthread_mutex_lock(&sim->async_mutex);
+    for (;;) {
+        while (!sim->async_pending && !sim->async_quit)
+            pthread_cond_wait(&sim->async_cv, &sim->async_mutex);
+        if (sim->async_quit) break;
+        sim->async_pending = 0;
+        pthread_mutex_unlock(&sim->async_mutex);
+
+        BatchedStepJob job = { sim, sim->async_ctrl, sim->async_substeps, 0, sim->async_first,
+                               NULL };
+        batched_run_step(sim, &job, sim->async_count);
+
+        pthread_mutex_lock(&sim->async_mutex);
+        atomic_store_explicit(&sim->async_busy, 0, memory_order_release);
+        pthread_cond_broadcast(&sim->async_cv);
+    }
+    pthread_mutex_unlock(&sim->async_mutex);
+    return NULL;
+}
+
+static int batched_async_start(MjAccessBatchedSim* sim) {
+    if (sim->async_started) return 0;
+    pthread_mutex_init(&sim->async_mutex, NULL);
+    pthread_cond_init(&sim->async_cv, NULL);
+    if (pthread_create(&sim->async_thread, NULL, batched_async_main, sim) != 0) {
+        pthread_cond_destroy(&sim->async_cv);
+        pthread_mutex_destroy(&sim->async_mutex);
+        return -1;
+    }
+    sim->async_started = 1;
+    return 0;
+}
+#endif
+
+// ctrl is staged, so the caller may refill its buffer as soon as this returns.
+MJA_API int mjaccess_batched_step_async(MjAccessBatchedSim* sim, const double* ctrl,
+                                        int n_substeps, int env_begin, int env_count) {
+    if (!sim || !ctrl || n_substeps <= 0 || env_begin < 0 || env_count <= 0 ||
+        env_begin + env_count > sim->num_envs || !sim->owns_pool)
+        return -1;
+    batched_async_join(sim);
+    batched_scatter_flush(sim);
+    int nu = sim->model_ref->nu;
+    if (!sim->async_ctrl) {
+        sim->async_ctrl = (double*)malloc(((size_t)sim->num_envs * nu + 1) * sizeof(double));
+        if (!sim->async_ctrl) return -1;
+    }
+    memcpy(sim->async_ctrl + (size_t)env_begin * nu, ctrl, (size_t)env_count * nu * sizeof(double));
+    sim->async_first = env_begin;
+    sim->async_count = env_count;
+    sim->async_substeps = n_substeps;
+#ifdef MJA_HAVE_THREADS
+    if (batched_async_start(sim) != 0) return -1;
+    pthread_mutex_lock(&sim->async_mutex);
+    atomic_store_explicit(&sim->async_busy, 1, memory_order_relaxed);
+    sim->async_pending = 1;
+    pthread_cond_broadcast(&sim->async_cv);
+    pthread_mutex_unlock(&sim->async_mutex);
+#else
+    BatchedStepJob job = { sim, sim->async_ctrl, n_substeps, 0, env_begin, NULL };
+    batched_run_step(sim, &job, env_count);
+#endif
+    return 0;
+}
+
+MJA_API void mjaccess_batched_wait(MjAccessBatchedSim* sim) {
+    if (sim) batched_async_join(sim);
+}
+
+MJA_API int mjaccess_batched_is_busy(const MjAccessBatchedSim* sim) {
+    return sim ? atomic_load_explicit(&sim->async_busy, memory_order_acquire) : 0;
+}
+
+typedef struct {
+    MjAccessBatchedSim* sim;
+    const int*          mask;
+} BatchedResetJob;
+
+// Like batched_restart_env, but always to the model default.
+static void batched_reset_task(void* ctx, int begin, int end, int worker) {
+    const BatchedResetJob* job = (const BatchedResetJob*)ctx;
+    MjAccessBatchedSim* sim = job->sim;
+    for (int i = begin; i < end; i++) {
+        sim->reset_flags[i] = job->mask[i] != 0;
+        if (!job->mask[i]) continue;
+        if (sim->rand_on_reset && sim->rand_nterms) batched_resample_env(sim, i);
+        mjModel* m = batched_env_model(sim, i, worker);
+        batched_reset_env(sim, i);
+        mj_forward(m, sim->datas[i]);
+        batched_write_outputs(sim, i, worker, 0);
+    }
+}
+
+MJA_API void mjaccess_batched_reset(MjAccessBatchedSim* sim, const int* reset_mask) {
+    if (!sim || !reset_mask) return;
+    batched_async_join(sim);
+    batched_scatter_flush(sim);
+    BatchedResetJob job = { sim, reset_mask };
+    batched_sync_models(sim);
+    pool_run(sim->pool, sim->num_envs, batched_reset_task, &job);
+    batched_obs_norm_merge(sim);
+}
+
+// ── Snapshot pool and auto-reset ─────────────────────────────
+
+static int batched_snap_reserve(MjAccessBatchedSim* sim, int extra) {
+    int need = sim->snap_count + extra;
+    if (need <= sim->snap_capacity) return 0;
+    int cap = sim->snap_capacity ? sim->snap_capacity : 16;
+    while (cap < need) cap *= 2;
+    double* snaps = (double*)realloc(sim->snaps, (size_t)cap * sim->snap_size * sizeof(double));
+    if (!snaps) return -1;
+    sim->snaps = snaps;
+    sim->snap_capacity = cap;
+    return 0;
+}
+
+MJA_API int mjaccess_batched_snapshot_set_spec(MjAccessBatchedSim* sim, unsigned spec) {
+    if (!sim || spec == 0) return -1;
+    batched_async_join(sim);
+    sim->snap_spec = spec;
+    sim->snap_size = mj_stateSize(sim->model_ref, spec);
+    sim->snap_count = 0;
+    sim->snap_capacity = 0;
+    free(sim->snaps);
+    sim->snaps = NULL;
+    return sim->snap_size;
+}
+
+MJA_API int mjaccess_batched_snapshot_size(const MjAccessBatchedSim* sim) {
+    return sim ? sim->snap_size : 0;
+}
+
+MJA_API int mjaccess_batched_snapshot_count(const MjAccessBatchedSim* sim) {
+    return sim ? sim->snap_count : 0;
+}
+
+MJA_API int mjaccess_batched_snapshot_capture(MjAccessBatchedSim* sim, int env_idx) {
+    if (!sim || env_idx < 0 || env_idx >= sim->num_envs) return -1;
+    batched_async_join(sim);
+    if (batched_snap_reserve(sim, 1) != 0) return -1;
+    double* dst = sim->snaps + (size_t)sim->snap_count * sim->snap_size;
+    mj_getState(sim->model_ref, sim->datas[env_idx], dst, sim->snap_spec);
+    return sim->snap_count++;
+}
+
+MJA_API int mjaccess_batched_snapshot_add(MjAccessBatchedSim* sim, const double* states,
+                                          int n_states) {
+    if (!sim || !states || n_states <= 0) return -1;
+    batched_async_join(sim);
+    if (batched_snap_reserve(sim, n_states) != 0) return -1;
+    memcpy(sim->snaps + (size_t)sim->snap_count * sim->snap_size, states,
+           (size_t)n_states * sim->snap_size * sizeof(double));
+    int first = sim->snap_count;
+    sim->snap_count += n_states;
+    return first;
+}
+
+MJA_API void mjaccess_batched_snapshot_clear(MjAccessBatchedSim* sim) {
+    if (!sim) return;
+    batched_async_join(sim);
+    sim->snap_count = 0;
+}
+
+MJA_API void mjaccess_batched_set_auto_reset(MjAccessBatchedSim* sim,
+                                             const MjAccessAutoResetConfig* config) {
+    if (!sim || !config) return;
+    batched_async_join(sim);
+    sim->detect_bad_state = config->detect_bad_state;
+    batched_seed_rng(sim, config->seed);
+}
+
+MJA_API void mjaccess_batched_set_done(MjAccessBatchedSim* sim, const int* done_mask,
+                                       const int* snapshot_index) {
+    if (!sim || !done_mask) return;
+    batched_async_join(sim);
+    int ne = sim->num_envs;
+    memcpy(sim->done, done_mask, ne * sizeof(int));
+    if (snapshot_index) {
+        memcpy(sim->done_index, snapshot_index, ne * sizeof(int));
+    } else {
+        for (int i = 0; i < ne; i++) sim->done_index[i] = -1;
+    }
+    sim->done_pending = 1;
+}
+
+typedef struct {
+    MjAccessBatchedSim* sim;
+    const int*          mask;
+    const int*          index;
+} BatchedRestartJob;
+
+static void batched_restart_task(void* ctx, int begin, int end, int worker) {
+    const BatchedRestartJob* job = (const BatchedRestartJob*)ctx;
+    for (int i = begin; i < end; i++) {
+        job->sim->reset_flags[i] = job->mask[i] != 0;
+        if (!job->mask[i]) continue;
+        batched_restart_env(job->sim, i, job->index ? job->index[i] : -1, worker);
+        batched_write_outputs(job->sim, i, worker, 0);
+    }
+}
+
+MJA_API void mjaccess_batched_reset_to_snapshots(MjAccessBatchedSim* sim, const int* reset_mask,
+                                                 const int* snapshot_index) {
+    if (!sim || !reset_mask) return;
+    batched_async_join(sim);
+    batched_scatter_flush(sim);
+    BatchedRestartJob job = { sim, reset_mask, snapshot_index };
+    batched_sync_models(sim);
+    pool_run(sim->pool, sim->num_envs, batched_restart_task, &job);
+    batched_obs_norm_merge(sim);
+}
+
+MJA_API const int* mjaccess_batched_get_reset_flags(const MjAccessBatchedSim* sim, int* n_out) {
+    if (!sim) { if (n_out) *n_out = 0; return NULL; }
+    if (n_out) *n_out = sim->num_envs;
+    return sim->reset_flags;
+}
+
+// ── Observation plan ─────────────────────────────────────────
+
+static int obs_term_objtype(int term) {
+    switch (term) {
+    case MJA_OBS_JOINT_QPOS:
+    case MJA_OBS_JOINT_QVEL:        return mjOBJ_JOINT;
+    case MJA_OBS_ACTUATOR_CTRL:     return mjOBJ_ACTUATOR;
+    case MJA_OBS_BODY_XPOS:
+    case MJA_OBS_BODY_XQUAT:
+    case MJA_OBS_BODY_CVEL:
+    case MJA_OBS_BODY_SUBTREE_COM:
+    case MJA_OBS_BODY_CFRC_EXT:     return mjOBJ_BODY;
+    case MJA_OBS_SITE_XPOS:         return mjOBJ_SITE;
+    case MJA_OBS_GEOM_XPOS:         return mjOBJ_GEOM;
+    case MJA_OBS_SENSOR:            return mjOBJ_SENSOR;
+    default:                        return mjOBJ_UNKNOWN;
+    }
+}
+
+// Resolve a term on object `id` to (source array, offset, length).
+static int obs_resolve(const mjModel* m, int term, int id, MjaObsRun* run) {
+    int n;
+    switch (obs_term_objtype(term)) {
+    case mjOBJ_JOINT:    n = m->njnt;    break;
+    case mjOBJ_ACTUATOR: n = m->nu;      break;
+    case mjOBJ_BODY:     n = m->nbody;   break;
+    case mjOBJ_SITE:     n = m->nsite;   break;
+    case mjOBJ_GEOM:     n = m->ngeom;   break;
+    case mjOBJ_SENSOR:   n = m->nsensor; break;
+    default:             return -1;
+    }
+    if (id < 0 || id >= n) return -1;
+
+    switch (term) {
+    case MJA_OBS_JOINT_QPOS: {
+        int type = m->jnt_type[id];
+        run->src = MJA_OBS_SRC_QPOS;
+        run->src_off = m->jnt_qposadr[id];
+        run->len = type == mjJNT_FREE ? 7 : type == mjJNT_BALL ? 4 : 1;
+        break;
+    }
+    case MJA_OBS_JOINT_QVEL: {
+        int type = m->jnt_type[id];
+        run->src = MJA_OBS_SRC_QVEL;
+        run->src_off = m->jnt_dofadr[id];
+        run->len = type == mjJNT_FREE ? 6 : type == mjJNT_BALL ? 3 : 1;
+        break;
+    }
+    case MJA_OBS_ACTUATOR_CTRL:
+        run->src = MJA_OBS_SRC_CTRL;        run->src_off = id;      run->len = 1;  break;
+    case MJA_OBS_BODY_XPOS:
+        run->src = MJA_OBS_SRC_XPOS;        run->src_off = 3 * id;  run->len = 3;  break;
+    case MJA_OBS_BODY_XQUAT:
+        run->src = MJA_OBS_SRC_XQUAT;       run->src_off = 4 * id;  run->len = 4;  break;
+    case MJA_OBS_BODY_CVEL:
+        run->src = MJA_OBS_SRC_CVEL;        run->src_off = 6 * id;  run->len = 6;  break;
+    case MJA_OBS_BODY_SUBTREE_COM:
+        run->src = MJA_OBS_SRC_SUBTREE_COM; run->src_off = 3 * id;  run->len = 3;  break;
+    case MJA_OBS_BODY_CFRC_EXT:
+        run->src = MJA_OBS_SRC_CFRC_EXT;    run->src_off = 6 * id;  run->len = 6;  break;
+    case MJA_OBS_SITE_XPOS:
+        run->src = MJA_OBS_SRC_SITE_XPOS;   run->src_off = 3 * id;  run->len = 3;  break;
+    case MJA_OBS_GEOM_XPOS:
+        run->src = MJA_OBS_SRC_GEOM_XPOS;   run->src_off = 3 * id;  run->len = 3;  break;
+    case MJA_OBS_SENSOR:
+        run->src = MJA_OBS_SRC_SENSORDATA;
+        run->src_off = m->sensor_adr[id];
+        run->len = m->sensor_dim[id];
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+MJA_API void mjaccess_batched_obs_clear(MjAccessBatchedSim* sim) {
+    if (!sim) return;
+    batched_async_join(sim);
+    batched_obs_norm_free(sim);
+    sim->obs_nruns = 0;
+    sim->obs_dim = 0;
+    sim->obs_out = NULL;
+    free(sim->obs_buf);
+    sim->obs_buf = NULL;
+}
+
+// Append one term to the plan, merging it into the previous run when both
+// read adjacent memory of the same array.
+MJA_API int mjaccess_batched_obs_add(MjAccessBatchedSim* sim, int term, int obj_id) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    MjaObsRun run;
+    if (obs_resolve(sim->model_ref, term, obj_id, &run) != 0 || run.len <= 0) return -1;
+
+    float* buf = (float*)calloc((size_t)sim->num_envs * (sim->obs_dim + run.len), sizeof(float));
+    if (!buf) return -1;
+    if (sim->obs_nruns == sim->obs_cap) {
+        int cap = sim->obs_cap ? sim->obs_cap * 2 : 16;
+        MjaObsRun* runs = (MjaObsRun*)realloc(sim->obs_runs, cap * sizeof(MjaObsRun));
+        if (!runs) { free(buf); return -1; }
+        sim->obs_runs = runs;
+        sim->obs_cap = cap;
+    }
+
+    run.dst_off = sim->obs_dim;
+    MjaObsRun* last = sim->obs_nruns ? &sim->obs_runs[sim->obs_nruns - 1] : NULL;
+    if (last && last->src == run.src && last->src_off + last->len == run.src_off) {
+        last->len += run.len;
+    } else {
+        sim->obs_runs[sim->obs_nruns++] = run;
+    }
+    sim->obs_dim += run.len;
+
+    // a bound caller buffer was sized for the old width: fall back to internal
+    sim->obs_out = buf;
+    free(sim->obs_buf);
+    sim->obs_buf = buf;
+    batched_obs_norm_free(sim);
+    return run.len;
+}
+
+MJA_API int mjaccess_batched_obs_add_named(MjAccessBatchedSim* sim, int term, const char* name) {
+    if (!sim || !name) return -1;
+    int objtype = obs_term_objtype(term);
+    if (objtype == mjOBJ_UNKNOWN) return -1;
+    int id = mj_name2id(sim->model_ref, objtype, name);
+    return id < 0 ? -1 : mjaccess_batched_obs_add(sim, term, id);
+}
+
+MJA_API int mjaccess_batched_obs_dim(const MjAccessBatchedSim* sim) {
+    return sim ? sim->obs_dim : 0;
+}
+
+MJA_API int mjaccess_batched_bind_obs(MjAccessBatchedSim* sim, float* dst, int n) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    if (!dst) {
+        sim->obs_out = sim->obs_buf;
+        return 0;
+    }
+    if (n < sim->num_envs * sim->obs_dim) return -1;
+    sim->obs_out = dst;
+    return 0;
+}
+
+MJA_API const float* mjaccess_batched_get_obs(const MjAccessBatchedSim* sim, int* n_out) {
+    if (!sim || !sim->obs_out) { if (n_out) *n_out = 0; return NULL; }
+    if (n_out) *n_out = sim->num_envs * sim->obs_dim;
+    return sim->obs_out;
+}
+
+static void batched_obs_task(void* ctx, int begin, int end, int worker) {
+    const MjAccessBatchedSim* sim = (const MjAccessBatchedSim*)ctx;
+    for (int i = begin; i < end; i++) {
+        batched_write_obs(sim, i);
+        if (sim->obs_norm) batched_norm_obs(sim, i, worker, 0);
+    }
+}
+
+MJA_API void mjaccess_batched_obs_refresh(MjAccessBatchedSim* sim) {
+    if (!sim || !sim->obs_nruns || !sim->obs_out) return;
+    batched_async_join(sim);
+    pool_run(sim->pool, sim->num_envs, batched_obs_task, sim);
+}
+
+// ── Running normalization ────────────────────────────────────
+
+MJA_API int mjaccess_batched_obs_norm_enable(MjAccessBatchedSim* sim,
+                                             const MjAccessNormConfig* config) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    batched_obs_norm_free(sim);
+    if (!config) return 0;
+    int dim = sim->obs_dim;
+    int nt = sim->pool->num_threads;
+    if (dim <= 0) return -1;
+
+    // totals, then one 64-byte aligned mean/m2 block per worker, then shift/scale
+    size_t stride = ((size_t)dim + 7) & ~(size_t)7;
+    size_t n_doubles = 2 * stride * (size_t)(nt + 1);
+    double* arena = (double*)calloc(n_doubles + 2 * stride + 8, sizeof(double));
+    MjaMoments* parts = (MjaMoments*)calloc(nt, sizeof(MjaMoments));
+    if (!arena || !parts) {
+        free(arena);
+        free(parts);
+        return -1;
+    }
+    double* base = (double*)(((uintptr_t)arena + 63) & ~(uintptr_t)63);
+    sim->obs_norm_arena = arena;
+    sim->obs_parts = parts;
+    sim->obs_stats.mean = base;
+    sim->obs_stats.m2 = base + stride;
+    for (int w = 0; w < nt; w++) {
+        parts[w].mean = base + 2 * stride * (size_t)(w + 1);
+        parts[w].m2 = parts[w].mean + stride;
+    }
+    sim->obs_shift = (float*)(base + n_doubles);
+    sim->obs_scale = (float*)(base + n_doubles + stride);
+    sim->obs_clip = config->clip > 0 ? config->clip : FLT_MAX;
+    sim->obs_eps = config->epsilon > 0 ? config->epsilon : 1e-8;
+    obs_norm_update_scale(sim);
+    sim->obs_norm = 1;
+    return 0;
+}
+
+MJA_API int mjaccess_batched_obs_norm_get(const MjAccessBatchedSim* sim, double* mean,
+                                          double* var, double* count) {
+    if (!sim || !sim->obs_norm) return 0;
+    const MjaMoments* s = &sim->obs_stats;
+    for (int j = 0; j < sim->obs_dim; j++) {
+        if (mean) mean[j] = s->mean[j];
+        if (var) var[j] = s->count > 0 ? s->m2[j] / s->count : 0.0;
+    }
+    if (count) *count = s->count;
+    return sim->obs_dim;
+}
+
+MJA_API int mjaccess_batched_obs_norm_set(MjAccessBatchedSim* sim, const double* mean,
+                                          const double* var, double count, int dim) {
+    if (!sim || !sim->obs_norm || !mean || !var || dim != sim->obs_dim || count < 0) return -1;
+    batched_async_join(sim);
+    MjaMoments* s = &sim->obs_stats;
+    for (int j = 0; j < dim; j++) {
+        s->mean[j] = mean[j];
+        s->m2[j] = var[j] * count;
+    }
+    s->count = count;
+    obs_norm_update_scale(sim);
+    return 0;
+}
+
+MJA_API int mjaccess_batched_reward_norm_enable(MjAccessBatchedSim* sim,
+                                                const MjAccessNormConfig* config) {
+    if (!sim) return -1;
+    free(sim->rew_ret);
+    sim->rew_ret = NULL;
+    sim->rew_count = sim->rew_mean = sim->rew_m2 = 0;
+    if (!config) return 0;
+    sim->rew_ret = (double*)calloc(sim->num_envs, sizeof(double));
+    if (!sim->rew_ret) return -1;
+    sim->rew_gamma = config->gamma > 0 ? config->gamma : 0.99f;
+    sim->rew_clip = config->clip > 0 ? config->clip : FLT_MAX;
+    sim->rew_eps = config->epsilon > 0 ? config->epsilon : 1e-8;
+    return 0;
+}
+
+// One scalar per env, so this runs on the caller: fold the discounted returns
+// into the running variance, scale rewards by 1/std and restart the returns
+// of finished episodes.
+MJA_API void mjaccess_batched_normalize_rewards(MjAccessBatchedSim* sim, float* rewards,
+                                                const int* dones) {
+    if (!sim || !sim->rew_ret || !rewards) return;
+    int ne = sim->num_envs;
+    double* ret = sim->rew_ret;
+    if (!sim->norm_frozen) {
+        double bmean = 0, bm2 = 0;
+        for (int i = 0; i < ne; i++) {
+            ret[i] = ret[i] * sim->rew_gamma + rewards[i];
+            double d = ret[i] - bmean;
+            bmean += d / (i + 1);
+            bm2 += d * (ret[i] - bmean);
+        }
+        double n = sim->rew_count + ne;
+        double d = bmean - sim->rew_mean;
+        sim->rew_mean += d * ne / n;
+        sim->rew_m2 += bm2 + d * d * sim->rew_count * ne / n;
+        sim->rew_count = n;
+    }
+    float scale = sim->rew_count > 0
+        ? (float)(1.0 / sqrt(sim->rew_m2 / sim->rew_count + sim->rew_eps)) : 1.0f;
+    float clip = sim->rew_clip;
+    for (int i = 0; i < ne; i++) {
+        float v = rewards[i] * scale;
+        rewards[i] = v < -clip ? -clip : v > clip ? clip : v;
+        if (dones && dones[i]) ret[i] = 0;
+    }
+}
+
+MJA_API void mjaccess_batched_reward_norm_get(const MjAccessBatchedSim* sim, double* stats3) {
+    if (!sim || !stats3) return;
+    stats3[0] = sim->rew_mean;
+    stats3[1] = sim->rew_count > 0 ? sim->rew_m2 / sim->rew_count : 0.0;
+    stats3[2] = sim->rew_count;
+}
+
+MJA_API void mjaccess_batched_reward_norm_set(MjAccessBatchedSim* sim, const double* stats3) {
+    if (!sim || !stats3 || stats3[2] < 0) return;
+    sim->rew_mean = stats3[0];
+    sim->rew_m2 = stats3[1] * stats3[2];
+    sim->rew_count = stats3[2];
+}
+
+MJA_API void mjaccess_batched_norm_freeze(MjAccessBatchedSim* sim, int frozen) {
+    if (!sim) return;
+    batched_async_join(sim);
+    sim->norm_frozen = frozen;
+}
+
+MJA_API void mjaccess_batched_norm_reset(MjAccessBatchedSim* sim) {
+    if (!sim) return;
+    batched_async_join(sim);
+    if (sim->obs_norm) {
+        sim->obs_stats.count = 0;
+        memset(sim->obs_stats.mean, 0, sim->obs_dim * sizeof(double));
+        memset(sim->obs_stats.m2, 0, sim->obs_dim * sizeof(double));
+        obs_norm_update_scale(sim);
+    }
+    sim->rew_count = sim->rew_mean = sim->rew_m2 = 0;
+    if (sim->rew_ret) memset(sim->rew_ret, 0, sim->num_envs * sizeof(double));
+}
+
+// ── Domain randomization ─────────────────────────────────────
+
+MJA_API int mjaccess_batched_param_enable(MjAccessBatchedSim* sim, int param) {
+    if (!sim || param < 0 || param >= MJA_PARAM_COUNT) return -1;
+    batched_async_join(sim);
+    int dim = param_count(sim->model_ref, param) * param_width(param);
+    if (sim->params[param]) return dim;
+    if (!sim->env_models) {
+        sim->env_models = (mjModel*)malloc(sim->pool->num_threads * sizeof(mjModel));
+        if (!sim->env_models) return -1;
+    }
+    double* rows = (double*)malloc(((size_t)sim->num_envs * dim + 1) * sizeof(double));
+    if (!rows) return -1;
+    if (param == MJA_PARAM_BODY_MASS) {
+        sim->subtreemass = (double*)malloc(((size_t)sim->num_envs * dim + 1) * sizeof(double));
+        if (!sim->subtreemass) {
+            free(rows);
+            return -1;
+        }
+        for (int i = 0; i < sim->num_envs; i++)
+            memcpy(sim->subtreemass + (size_t)i * dim, sim->model_ref->body_subtreemass,
+                   dim * sizeof(double));
+    }
+    const double* src = *param_field_ptr(sim->model_ref, param);
+    for (int i = 0; i < sim->num_envs; i++)
+        memcpy(rows + (size_t)i * dim, src, dim * sizeof(double));
+    sim->params[param] = rows;
+    sim->param_dim[param] = dim;
+    sim->params_on = 1;
+    return dim;
+}
+
+MJA_API void mjaccess_batched_param_disable(MjAccessBatchedSim* sim, int param) {
+    if (!sim || param < 0 || param >= MJA_PARAM_COUNT || !sim->params[param]) return;
+    batched_async_join(sim);
+    free(sim->params[param]);
+    sim->params[param] = NULL;
+    sim->param_dim[param] = 0;
+    if (param == MJA_PARAM_BODY_MASS) {
+        free(sim->subtreemass);
+        sim->subtreemass = NULL;
+        sim->subtreemass_stale = 0;
+    }
+    int kept = 0;
+    for (int k = 0; k < sim->rand_nterms; k++) {
+        if (sim->rand_terms[k].param != param) sim->rand_terms[kept++] = sim->rand_terms[k];
+    }
+    sim->rand_nterms = kept;
+    sim->params_on = 0;
+    for (int p = 0; p < MJA_PARAM_COUNT; p++) sim->params_on |= sim->params[p] != NULL;
+}
+
+MJA_API double* mjaccess_batched_param_table(MjAccessBatchedSim* sim, int param, int* n_out) {
+    if (n_out) *n_out = 0;
+    if (!sim || param < 0 || param >= MJA_PARAM_COUNT || !sim->params[param]) return NULL;
+    batched_async_join(sim);
+    if (param == MJA_PARAM_BODY_MASS) sim->subtreemass_stale = 1;
+    if (n_out) *n_out = sim->num_envs * sim->param_dim[param];
+    return sim->params[param];
+}
+
+MJA_API int mjaccess_batched_rand_add(MjAccessBatchedSim* sim, const MjAccessRandTerm* term) {
+    if (!sim || !term || term->param < 0 || term->param >= MJA_PARAM_COUNT) return -1;
+    int w = param_width(term->param);
+    if (term->obj >= param_count(sim->model_ref, term->param) || term->component >= w) return -1;
+    if (term->dist == MJA_DIST_LOG_UNIFORM && (term->a <= 0 || term->b <= 0)) return -1;
+    batched_async_join(sim);
+    if (mjaccess_batched_param_enable(sim, term->param) < 0) return -1;
+    if (sim->rand_nterms == sim->rand_cap) {
+        int cap = sim->rand_cap ? sim->rand_cap * 2 : 8;
+        MjAccessRandTerm* terms = (MjAccessRandTerm*)realloc(sim->rand_terms,
+                                                             cap * sizeof(MjAccessRandTerm));
+        if (!terms) return -1;
+        sim->rand_terms = terms;
+        sim->rand_cap = cap;
+    }
+    sim->rand_terms[sim->rand_nterms] = *term;
+    return sim->rand_nterms++;
+}
+
+MJA_API void mjaccess_batched_rand_clear(MjAccessBatchedSim* sim) {
+    if (!sim) return;
+    batched_async_join(sim);
+    sim->rand_nterms = 0;
+}
+
+MJA_API void mjaccess_batched_rand_on_reset(MjAccessBatchedSim* sim, int enabled) {
+    if (!sim) return;
+    batched_async_join(sim);
+    sim->rand_on_reset = enabled;
+}
+
+typedef struct {
+    MjAccessBatchedSim* sim;
+    const int*          mask;
+} BatchedResampleJob;
+
+static void batched_resample_task(void* ctx, int begin, int end, int worker) {
+    const BatchedResampleJob* job = (const BatchedResampleJob*)ctx;
+    (void)worker;
+    for (int i = begin; i < end; i++) {
+        if (!job->mask || job->mask[i]) batched_resample_env(job->sim, i);
+    }
+}
+
+MJA_API void mjaccess_batched_randomize(MjAccessBatchedSim* sim, const int* env_mask) {
+    if (!sim || !sim->params_on) return;
+    batched_async_join(sim);
+    BatchedResampleJob job = { sim, env_mask };
+    pool_run(sim->pool, sim->num_envs, batched_resample_task, &job);
+}
+
+// ── Batched profiling ────────────────────────────────────────
+
+MJA_API int mjaccess_batched_profile_enable(MjAccessBatchedSim* sim, int enabled) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    if (!enabled == !sim->prof) return 0;
+    if (!enabled) {
+        free(sim->prof);
+        free(sim->prof_seen);
+        sim->prof = NULL;
+        sim->prof_seen = NULL;
+        profile_clock_release();
+        return 0;
+    }
+    sim->prof = (MjaProfileAcc*)calloc(sim->pool->num_threads, sizeof(MjaProfileAcc));
+    sim->prof_seen = (mjTimerStat*)malloc((size_t)sim->num_envs * mjNTIMER * sizeof(mjTimerStat));
+    if (!sim->prof || !sim->prof_seen) {
+        free(sim->prof);
+        free(sim->prof_seen);
+        sim->prof = NULL;
+        sim->prof_seen = NULL;
+        return -1;
+    }
+    sim->prof_jobs = 0;
+    sim->prof_wall_ms = 0;
+    for (int i = 0; i < sim->num_envs; i++)
+        memcpy(sim->prof_seen + (size_t)i * mjNTIMER, sim->datas[i]->timer,
+               sizeof(sim->datas[i]->timer));
+    profile_clock_acquire();
+    return 0;
+}
+
+MJA_API void mjaccess_batched_get_profile(MjAccessBatchedSim* sim, MjAccessProfile* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!sim || !sim->prof) return;
+    batched_async_join(sim);
+    for (int w = 0; w < sim->pool->num_threads; w++) {
+        const MjAccessProfile* p = &sim->prof[w].p;
+        out->env_steps += p->env_steps;
+        out->step_ms += p->step_ms;
+        out->gather_ms += p->gather_ms;
+        for (int k = 0; k < MJA_PROFILE_STAGES; k++) {
+            out->stage_ms[k] += p->stage_ms[k];
+            out->stage_calls[k] += p->stage_calls[k];
+        }
+        out->contacts += p->contacts;
+        out->constraints += p->constraints;
+        out->solver_iters += p->solver_iters;
+        if (p->max_contacts > out->max_contacts) out->max_contacts = p->max_contacts;
+        if (p->max_constraints > out->max_constraints) out->max_constraints = p->max_constraints;
+        for (int b = 0; b < MJA_PROFILE_BINS; b++) out->step_hist[b] += p->step_hist[b];
+    }
+    out->jobs = sim->prof_jobs;
+    out->wall_ms = sim->prof_wall_ms;
+}
+
+MJA_API int mjaccess_batched_get_worker_profile(MjAccessBatchedSim* sim, double* busy_ms,
+                                                double* idle_ms, int n) {
+    if (!sim) return 0;
+    int nt = sim->pool->num_threads;
+    if (!sim->prof) return nt;
+    batched_async_join(sim);
+    for (int w = 0; w < nt && w < n; w++) {
+        double busy = sim->prof[w].busy_ms;
+        double idle = sim->prof_wall_ms - busy;
+        if (busy_ms) busy_ms[w] = busy;
+        if (idle_ms) idle_ms[w] = idle > 0 ? idle : 0;
+    }
+    return nt;
+}
+
+MJA_API void mjaccess_batched_profile_reset(MjAccessBatchedSim* sim) {
+    if (!sim || !sim->prof) return;
+    batched_async_join(sim);
+    memset(sim->prof, 0, sim->pool->num_threads * sizeof(MjaProfileAcc));
+    sim->prof_jobs = 0;
+    sim->prof_wall_ms = 0;
+}
+
+MJA_API int mjaccess_batched_num_threads(const MjAccessBatchedSim* sim) {
+    return (sim && sim->pool) ? sim->pool->num_threads : 0;
+}
+
+MJA_API int mjaccess_batched_bind_output(MjAccessBatchedSim* sim, int field,
+                                         double* dst, int n) {
+    if (!sim || field < 0 || field >= MJA_FIELD_COUNT) return -1;
+    batched_async_join(sim);
+    if (!dst) {
+        sim->outputs[field] = NULL;
+        sim->output_mask &= ~(1u << field);
+        return 0;
     }
-#endif
+    if (n < sim->num_envs * sim->dims[field]) return -1;
+    sim->outputs[field] = dst;
+    sim->output_mask |= 1u << field;
+    return 0;
 }
 
-MJA_API void mjaccess_batched_reset(MjAccessBatchedSim* sim, const int* reset_mask) {
-    if (!sim || !reset_mask) return;
-    mjModel* m = sim->model_ref;
-    for (int i = 0; i < sim->num_envs; i++) {
-        if (reset_mask[i]) mj_resetData(m, sim->datas[i]);
+MJA_API void mjaccess_batched_clear_outputs(MjAccessBatchedSim* sim) {
+    if (!sim) return;
+    batched_async_join(sim);
+    memset(sim->outputs, 0, sizeof(sim->outputs));
+    sim->output_mask = 0;
+}
+
+MJA_API unsigned mjaccess_batched_output_mask(const MjAccessBatchedSim* sim) {
+    return sim ? sim->output_mask : 0;
+}
+
+MJA_API int mjaccess_batched_is_contiguous(const MjAccessBatchedSim* sim) {
+    return sim ? sim->contiguous : 0;
+}
+
+// Gather a field from all envs into a contiguous buffer (a no-op for slabs)
+MJA_API const double* mjaccess_batched_get_field(const MjAccessBatchedSim* sim, int field,
+                                                 int* n_out) {
+    if (!sim || field < 0 || field >= MJA_FIELD_COUNT) { if (n_out) *n_out = 0; return NULL; }
+    int ne = sim->num_envs;
+    int per_env = sim->dims[field];
+    double* buf = sim->bufs[field];
+    if (!sim->contiguous) {
+        batched_async_join((MjAccessBatchedSim*)sim);
+        for (int i = 0; i < ne; i++)
+            memcpy(buf + (size_t)i * per_env, *batched_field_ptr(sim->datas[i], field),
+                   per_env * sizeof(double));
     }
+    if (n_out) *n_out = ne * per_env;
+    return buf;
 }
 
-// Gather a field from all envs into a contiguous buffer
-#define BATCHED_GATHER(name, field, per_env_expr, buf_field) \
+#define BATCHED_GETTER(name, field) \
 MJA_API const double* mjaccess_batched_get_##name(const MjAccessBatchedSim* sim, int* n_out) { \
-    if (!sim) { if (n_out) *n_out = 0; return NULL; } \
-    int ne = sim->num_envs; \
-    int per_env = (int)(per_env_expr); \
-    int total = ne * per_env; \
-    double* buf = sim->buf_field; \
-    for (int i = 0; i < ne; i++) \
-        memcpy(buf + i * per_env, sim->datas[i]->field, per_env * sizeof(double)); \
-    if (n_out) *n_out = total; \
-    return buf; \
-}
-
-BATCHED_GATHER(qpos,            qpos,            sim->model_ref->nq,          qpos_buf)
-BATCHED_GATHER(qvel,            qvel,            sim->model_ref->nv,          qvel_buf)
-BATCHED_GATHER(xpos,            xpos,            sim->model_ref->nbody * 3,   xpos_buf)
-BATCHED_GATHER(subtree_com,     subtree_com,     sim->model_ref->nbody * 3,   subtree_com_buf)
-BATCHED_GATHER(cinert,          cinert,          sim->model_ref->nbody * 10,  cinert_buf)
-BATCHED_GATHER(cvel,            cvel,            sim->model_ref->nbody * 6,   cvel_buf)
-BATCHED_GATHER(qfrc_actuator,   qfrc_actuator,   sim->model_ref->nv,          qfrc_actuator_buf)
-BATCHED_GATHER(cfrc_ext,        cfrc_ext,        sim->model_ref->nbody * 6,   cfrc_ext_buf)
-
-#undef BATCHED_GATHER
+    return mjaccess_batched_get_field(sim, field, n_out); \
+}
+
+BATCHED_GETTER(qpos,            MJA_FIELD_QPOS)
+BATCHED_GETTER(qvel,            MJA_FIELD_QVEL)
+BATCHED_GETTER(ctrl,            MJA_FIELD_CTRL)
+BATCHED_GETTER(xpos,            MJA_FIELD_XPOS)
+BATCHED_GETTER(xquat,           MJA_FIELD_XQUAT)
+BATCHED_GETTER(subtree_com,     MJA_FIELD_SUBTREE_COM)
+BATCHED_GETTER(cinert,          MJA_FIELD_CINERT)
+BATCHED_GETTER(cvel,            MJA_FIELD_CVEL)
+BATCHED_GETTER(qfrc_actuator,   MJA_FIELD_QFRC_ACTUATOR)
+BATCHED_GETTER(cfrc_ext,        MJA_FIELD_CFRC_EXT)
+BATCHED_GETTER(sensordata,      MJA_FIELD_SENSORDATA)
+BATCHED_GETTER(geom_xpos,       MJA_FIELD_GEOM_XPOS)
+BATCHED_GETTER(geom_xmat,       MJA_FIELD_GEOM_XMAT)
+
+#undef BATCHED_GETTER
 
 MJA_API void mjaccess_batched_set_env_qpos(MjAccessBatchedSim* sim, int env_idx,
                                            const double* qpos, int nq) {
     if (!sim || !qpos || env_idx < 0 || env_idx >= sim->num_envs) return;
+    batched_async_join(sim);
     memcpy(sim->datas[env_idx]->qpos, qpos, nq * sizeof(double));
 }
 
 MJA_API void mjaccess_batched_set_env_qvel(MjAccessBatchedSim* sim, int env_idx,
                                            const double* qvel, int nv) {
     if (!sim || !qvel || env_idx < 0 || env_idx >= sim->num_envs) return;
+    batched_async_join(sim);
     memcpy(sim->datas[env_idx]->qvel, qvel, nv * sizeof(double));
 }
+
+// ── Scatter writes ───────────────────────────────────────────
+
+// Grows buf to hold need elements; returns the (possibly moved) buffer, or
+// NULL with buf and *cap untouched.
+static void* scatter_grow(void* buf, int* cap, int need, size_t elem) {
+    if (need <= *cap) return buf;
+    int c = *cap ? *cap : 64;
+    while (c < need) c *= 2;
+    void* p = realloc(buf, (size_t)c * elem);
+    if (p) *cap = c;
+    return p;
+}
+
+MJA_API int mjaccess_batched_scatter(MjAccessBatchedSim* sim, int field, const int* envs,
+                                     int n_envs, const int* elems, int n_elems,
+                                     const double* values) {
+    if (!sim || !envs || n_envs <= 0 || !values) return -1;
+    batched_async_join(sim);
+    mjtNum* base;
+    int size = cmd_array(sim->model_ref, sim->datas[0], field, &base);
+    int n = elems ? n_elems : size;
+    if (size < 0 || n <= 0) return -1;
+    for (int j = 0; elems && j < n; j++)
+        if (elems[j] < 0 || elems[j] >= size) return -1;
+    // one env twice in a call would be written by two workers at once
+    if (!sim->scatter_seen &&
+        !(sim->scatter_seen = (unsigned char*)calloc(sim->num_envs, 1)))
+        return -1;
+    int k = 0;
+    for (; k < n_envs; k++) {
+        int e = envs[k];
+        if (e < 0 || e >= sim->num_envs || sim->scatter_seen[e]) break;
+        sim->scatter_seen[e] = 1;
+    }
+    for (int i = 0; i < k; i++) sim->scatter_seen[envs[i]] = 0;
+    if (k < n_envs) return -1;
+
+    int nints = sim->scatter_nints + n_envs + (elems ? n : 0);
+    int nvalues = sim->scatter_nvalues + n_envs * n;
+    void* p;
+    if (!(p = scatter_grow(sim->scatter, &sim->scatter_cap, sim->scatter_n + 1,
+                           sizeof(MjaScatter))))
+        return -1;
+    sim->scatter = (MjaScatter*)p;
+    if (!(p = scatter_grow(sim->scatter_ints, &sim->scatter_ints_cap, nints, sizeof(int))))
+        return -1;
+    sim->scatter_ints = (int*)p;
+    if (!(p = scatter_grow(sim->scatter_values, &sim->scatter_values_cap, nvalues,
+                           sizeof(double))))
+        return -1;
+    sim->scatter_values = (double*)p;
+
+    MjaScatter* c = &sim->scatter[sim->scatter_n++];
+    c->field = field;
+    c->n_envs = n_envs;
+    c->n = n;
+    c->envs_off = sim->scatter_nints;
+    c->elems_off = elems ? sim->scatter_nints + n_envs : -1;
+    c->values_off = sim->scatter_nvalues;
+    memcpy(sim->scatter_ints + c->envs_off, envs, n_envs * sizeof(int));
+    if (elems) memcpy(sim->scatter_ints + c->elems_off, elems, n * sizeof(int));
+    memcpy(sim->scatter_values + c->values_off, values, (size_t)n_envs * n * sizeof(double));
+    sim->scatter_nints = nints;
+    sim->scatter_nvalues = nvalues;
+    return 0;
+}
+
+typedef struct {
+    MjAccessBatchedSim* sim;
+    const MjaScatter*   call;
+} ScatterJob;
+
+static void scatter_task(void* ctx, int begin, int end, int worker) {
+    (void)worker;
+    const ScatterJob* job = (const ScatterJob*)ctx;
+    const MjAccessBatchedSim* sim = job->sim;
+    const MjaScatter* c = job->call;
+    const int* envs = sim->scatter_ints + c->envs_off;
+    const int* elems = c->elems_off >= 0 ? sim->scatter_ints + c->elems_off : NULL;
+    for (int k = begin; k < end; k++) {
+        mjtNum* base = NULL;
+        if (cmd_array(sim->model_ref, sim->datas[envs[k]], c->field, &base) < 0) continue;
+        const double* v = sim->scatter_values + c->values_off + (size_t)k * c->n;
+        if (!elems) {
+            memcpy(base, v, c->n * sizeof(double));
+            continue;
+        }
+        for (int j = 0; j < c->n; j++) base[elems[j]] = v[j];
+    }
+}
+
+// Calls apply in order, each one's envs in parallel. Callers have joined any
+// async job, so every env is free.
+static void batched_scatter_flush(MjAccessBatchedSim* sim) {
+    for (int i = 0; i < sim->scatter_n; i++) {
+        ScatterJob job = { sim, &sim->scatter[i] };
+        pool_run(sim->pool, sim->scatter[i].n_envs, scatter_task, &job);
+    }
+    sim->scatter_n = 0;
+    sim->scatter_nints = 0;
+    sim->scatter_nvalues = 0;
+}
+
+// ── Active envs ──────────────────────────────────────────────
+
+static int batched_compact_active(MjAccessBatchedSim* sim) {
+    int n = 0;
+    for (int i = 0; i < sim->num_envs; i++)
+        if (sim->active[i]) sim->active_envs[n++] = i;
+    sim->active_count = n;
+    return n;
+}
+
+MJA_API int mjaccess_batched_set_active(MjAccessBatchedSim* sim, const int* active_mask) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    int ne = sim->num_envs;
+    if (!active_mask) {
+        free(sim->active);
+        sim->active = NULL;
+        for (int i = 0; i < ne; i++) sim->active_envs[i] = i;
+        sim->active_count = ne;
+        return ne;
+    }
+    if (!sim->active) {
+        sim->active = (unsigned char*)malloc(ne);
+        if (!sim->active) return -1;
+    }
+    for (int i = 0; i < ne; i++) sim->active[i] = active_mask[i] != 0;
+    return batched_compact_active(sim);
+}
+
+MJA_API int mjaccess_batched_set_env_active(MjAccessBatchedSim* sim, int env_idx, int active) {
+    if (!sim || env_idx < 0 || env_idx >= sim->num_envs) return -1;
+    batched_async_join(sim);
+    if (!sim->active) {
+        if (active) return sim->active_count;
+        sim->active = (unsigned char*)malloc(sim->num_envs);
+        if (!sim->active) return -1;
+        memset(sim->active, 1, sim->num_envs);
+    }
+    sim->active[env_idx] = active != 0;
+    return batched_compact_active(sim);
+}
+
+MJA_API const int* mjaccess_batched_get_active(const MjAccessBatchedSim* sim, int* n_out) {
+    if (!sim) { if (n_out) *n_out = 0; return NULL; }
+    if (n_out) *n_out = sim->active_count;
+    return sim->active_envs;
+}
+
+MJA_API int mjaccess_batched_gather_active(MjAccessBatchedSim* sim, int field, double* dst, int n) {
+    if (!sim || !dst || field < 0 || field >= MJA_FIELD_COUNT) return -1;
+    int dim = sim->dims[field];
+    if (n < sim->active_count * dim) return -1;
+    batched_async_join(sim);
+    for (int k = 0; k < sim->active_count; k++)
+        memcpy(dst + (size_t)k * dim, *batched_field_ptr(sim->datas[sim->active_envs[k]], field),
+               dim * sizeof(double));
+    return sim->active_count;
+}
+
+MJA_API int mjaccess_batched_gather_obs_active(MjAccessBatchedSim* sim, float* dst, int n) {
+    if (!sim || !dst || !sim->obs_out) return -1;
+    int dim = sim->obs_dim;
+    if (n < sim->active_count * dim) return -1;
+    batched_async_join(sim);
+    for (int k = 0; k < sim->active_count; k++)
+        memcpy(dst + (size_t)k * dim, sim->obs_out + (size_t)sim->active_envs[k] * dim,
+               dim * sizeof(float));
+    return sim->active_count;
+}
+
+// ── Batched recording ────────────────────────────────────────
+
+MJA_API int mjaccess_batched_record_start(MjAccessBatchedSim* sim, const char* path,
+                                          const MjAccessRecordConfig* config) {
+    if (!sim || !path) return -1;
+    batched_async_join(sim);
+    if (sim->rec) return -1;
+    MjAccessRecordConfig cfg = { 0, 0, 0, 0 };
+    if (config) cfg = *config;
+    unsigned mask = cfg.field_mask ? cfg.field_mask
+                                   : (1u << MJA_FIELD_QPOS) | (1u << MJA_FIELD_QVEL) |
+                                     (1u << MJA_FIELD_CTRL) | (1u << MJA_FIELD_SENSORDATA);
+    mask &= (1u << MJA_FIELD_COUNT) - 1;
+    sim->rec = recorder_open(path, sim->num_envs, sim->dims, mask, &cfg);
+    return sim->rec ? 0 : -1;
+}
+
+MJA_API int mjaccess_batched_record_stop(MjAccessBatchedSim* sim) {
+    if (!sim || !sim->rec) return -1;
+    batched_async_join(sim);
+    int rc = recorder_close(sim->rec);
+    sim->rec = NULL;
+    return rc;
+}
+
+MJA_API void mjaccess_batched_record_stats(const MjAccessBatchedSim* sim,
+                                           MjAccessRecordStats* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!sim || !sim->rec) return;
+    MjaRecorder* r = sim->rec;
+    out->frames = r->frames;
+    out->dropped = r->dropped;
+    out->bytes_raw = atomic_load_explicit(&r->bytes_raw, memory_order_relaxed);
+    out->bytes_written = atomic_load_explicit(&r->bytes_written, memory_order_relaxed);
+    out->stall_ms = r->stall_ms;
+    out->io_error = atomic_load_explicit(&r->io_error, memory_order_relaxed);
+}
+
+MJA_API MjAccessRecordReader* mjaccess_record_open(const char* path, MjAccessRecordInfo* info) {
+    if (!path) return NULL;
+    MjAccessRecordReader* rd = (MjAccessRecordReader*)calloc(1, sizeof(MjAccessRecordReader));
+    if (!rd) return NULL;
+    char magic[8];
+    rd->file = fopen(path, "rb");
+    if (!rd->file || fread(magic, 1, 8, rd->file) != 8 || memcmp(magic, MJA_RECORD_MAGIC, 8) != 0 ||
+        fread(&rd->info, sizeof(rd->info), 1, rd->file) != 1 || rd->info.version != 2 ||
+        rd->info.num_envs <= 0 || rd->info.row_bytes <= 0 ||
+        (rd->info.elem_size != 4 && rd->info.elem_size != 8)) {
+        mjaccess_record_close(rd);
+        return NULL;
+    }
+    size_t n = (size_t)rd->info.num_envs * rd->info.row_bytes;
+    rd->prev = (unsigned char*)calloc(n, 1);
+    rd->buf = (unsigned char*)malloc(n);
+    rd->tmp = (unsigned char*)malloc(n);
+    rd->packed = (unsigned char*)malloc(zrle_bound(n));
+    if (!rd->prev || !rd->buf || !rd->tmp || !rd->packed) {
+        mjaccess_record_close(rd);
+        return NULL;
+    }
+    if (info) *info = rd->info;
+    return rd;
+}
+
+MJA_API int mjaccess_record_next(MjAccessRecordReader* rd, void* rows, long long* frame,
+                                 int* env_first, int* env_count) {
+    if (!rd || !rows) return -1;
+    if (rd->chunk_left == 0) {
+        MjaRecChunk chunk;
+        size_t got = fread(&chunk, 1, sizeof(chunk), rd->file);
+        if (got == 0 && feof(rd->file)) return 0;
+        if (got != sizeof(chunk) || chunk.magic != MJA_RECORD_CHUNK || chunk.n_frames == 0)
+            return -1;
+        rd->chunk_left = (int)chunk.n_frames;
+    }
+    MjaRecFrame hdr;
+    if (fread(&hdr, sizeof(hdr), 1, rd->file) != 1) return -1;
+    size_t rb = (size_t)rd->info.row_bytes;
+    size_t n = (size_t)hdr.env_count * rb;
+    if (hdr.env_first < 0 || hdr.env_count < 0 ||
+        hdr.env_first + hdr.env_count > rd->info.num_envs || hdr.size > zrle_bound(n) ||
+        fread(rd->packed, 1, hdr.size, rd->file) != hdr.size)
+        return -1;
+    if (rd->info.flags & MJA_RECORD_COMPRESS) {
+        if (zrle_decode(rd->packed, hdr.size, rd->tmp, n) != 0) return -1;
+        rec_unshuffle(rd->buf, rd->tmp, n, rd->info.elem_size);
+    } else {
+        if (hdr.size != n) return -1;
+        memcpy(rd->buf, rd->packed, n);
+    }
+    if (rd->info.flags & MJA_RECORD_DELTA) {
+        unsigned char* prev = rd->prev + hdr.env_first * rb;
+        for (size_t i = 0; i < n; i++) prev[i] = rd->buf[i] ^= prev[i];
+    }
+    memcpy((unsigned char*)rows + hdr.env_first * rb, rd->buf, n);
+    rd->chunk_left--;
+    if (frame) *frame = hdr.frame;
+    if (env_first) *env_first = hdr.env_first;
+    if (env_count) *env_count = hdr.env_count;
+    return 1;
+}
+
+MJA_API void mjaccess_record_close(MjAccessRecordReader* rd) {
+    if (!rd) return;
+    if (rd->file) fclose(rd->file);
+    free(rd->prev);
+    free(rd->buf);
+    free(rd->tmp);
+    free(rd->packed);
+    free(rd);
+}
+
+// ── Batched contacts ─────────────────────────────────────────
+
+MJA_API int mjaccess_batched_contact_filter(MjAccessBatchedSim* sim, int side, int objtype,
+                                            const int* ids, int n) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    return contact_filter_set(&sim->contact_filter, sim->model_ref, side, objtype, ids, n);
+}
+
+MJA_API int mjaccess_batched_contact_capacity(MjAccessBatchedSim* sim, int capacity) {
+    if (!sim || capacity < 0) return -1;
+    batched_async_join(sim);
+    free(sim->contacts);
+    free(sim->contact_counts);
+    sim->contacts = NULL;
+    sim->contact_counts = NULL;
+    sim->contact_cap = 0;
+    if (capacity == 0) return 0;
+    size_t ne = (size_t)sim->num_envs;
+    sim->contacts = (MjAccessContact*)calloc(ne * capacity, sizeof(MjAccessContact));
+    sim->contact_counts = (int*)calloc(ne, sizeof(int));
+    if (!sim->contacts || !sim->contact_counts) {
+        free(sim->contacts);
+        free(sim->contact_counts);
+        sim->contacts = NULL;
+        sim->contact_counts = NULL;
+        return -1;
+    }
+    sim->contact_cap = capacity;
+    // current state, so the buffers are valid before the first step
+    for (int i = 0; i < sim->num_envs; i++) {
+        int n = contact_export(&sim->contact_filter, sim->model_ref, sim->datas[i],
+                               sim->contacts + (size_t)i * capacity, capacity);
+        sim->contact_counts[i] = n < capacity ? n : capacity;
+    }
+    return 0;
+}
+
+MJA_API const MjAccessContact* mjaccess_batched_get_contacts(const MjAccessBatchedSim* sim,
+                                                             const int** counts, int* capacity) {
+    if (counts) *counts = sim ? sim->contact_counts : NULL;
+    if (capacity) *capacity = sim ? sim->contact_cap : 0;
+    return sim ? sim->contacts : NULL;
+}
+
+// ── Batched rendering ────────────────────────────────────────
+
+// Scale that maps Unity's built-in primitive mesh for a geom type onto the
+// geom, in Unity axes (MuJoCo x, z, y). Plane: 10 x 10 quad, infinite planes
+// drawn 100 m wide. Sphere: diameter 1. Capsule: height 2, diameter 1.
+// Cylinder: height 2, diameter 1. Cube: side 1. Everything else is unscaled.
+static void render_geom_scale(float* s, int type, const mjtNum* size) {
+    switch (type) {
+    case mjGEOM_PLANE:
+        s[0] = size[0] > 0 ? (float)(size[0] * 0.2) : 10.0f;
+        s[1] = 1.0f;
+        s[2] = size[1] > 0 ? (float)(size[1] * 0.2) : 10.0f;
+        break;
+    case mjGEOM_SPHERE:
+        s[0] = s[1] = s[2] = (float)(2 * size[0]);
+        break;
+    case mjGEOM_CAPSULE:
+        s[0] = s[2] = (float)(2 * size[0]);
+        s[1] = (float)(size[1] + size[0]);
+        break;
+    case mjGEOM_CYLINDER:
+        s[0] = s[2] = (float)(2 * size[0]);
+        s[1] = (float)size[1];
+        break;
+    case mjGEOM_ELLIPSOID:
+    case mjGEOM_BOX:
+        s[0] = (float)(2 * size[0]);
+        s[1] = (float)(2 * size[2]);
+        s[2] = (float)(2 * size[1]);
+        break;
+    default:
+        s[0] = s[1] = s[2] = 1.0f;
+        break;
+    }
+}
+
+static int render_batch_key(const mjModel* m, int g) {
+    int type = m->geom_type[g];
+    return (type == mjGEOM_MESH || type == mjGEOM_HFIELD) ? m->geom_dataid[g] : -1;
+}
+
+MJA_API int mjaccess_batched_render_setup(MjAccessBatchedSim* sim, unsigned group_mask) {
+    if (!sim) return -1;
+    batched_async_join(sim);
+    const mjModel* m = sim->model_ref;
+    int ng = m->ngeom;
+    int* geoms = (int*)malloc((ng + 1) * sizeof(int));
+    int* batch_of = (int*)malloc((ng + 1) * sizeof(int));
+    MjAccessRenderBatch* batches = (MjAccessRenderBatch*)malloc((ng + 1) * sizeof(MjAccessRenderBatch));
+    float* scale = (float*)malloc((ng * 3 + 1) * sizeof(float));
+    if (!geoms || !batch_of || !batches || !scale) {
+        free(geoms);
+        free(batch_of);
+        free(batches);
+        free(scale);
+        return -1;
+    }
+
+    // Batches in order of first appearance.
+    int nb = 0, total = 0;
+    for (int g = 0; g < ng; g++) {
+        batch_of[g] = -1;
+        int group = m->geom_group[g];
+        if (group_mask && (group < 0 || group >= 32 || !(group_mask & (1u << group)))) continue;
+        if (m->geom_rgba[4 * g + 3] == 0) continue;
+        int type = m->geom_type[g], key = render_batch_key(m, g);
+        int b = 0;
+        while (b < nb && (batches[b].type != type || batches[b].dataid != key)) b++;
+        if (b == nb) {
+            batches[nb].type = type;
+            batches[nb].dataid = key;
+            batches[nb].count = 0;
+            nb++;
+        }
+        batches[b].count++;
+        batch_of[g] = b;
+        total++;
+    }
+    for (int b = 0, first = 0; b < nb; b++) {
+        batches[b].first = first;
+        first += batches[b].count;
+        batches[b].count = 0;
+    }
+    for (int g = 0; g < ng; g++) {
+        int b = batch_of[g];
+        if (b < 0) continue;
+        int k = batches[b].first + batches[b].count++;
+        geoms[k] = g;
+        render_geom_scale(scale + 3 * k, m->geom_type[g], m->geom_size + 3 * g);
+    }
+    free(batch_of);
+
+    free(sim->render_batches);
+    free(sim->render_geoms);
+    free(sim->render_scale);
+    sim->render_batches = batches;
+    sim->render_nbatches = nb;
+    sim->render_geoms = geoms;
+    sim->render_scale = scale;
+    sim->render_total = total;
+    return nb;
+}
+
+MJA_API int mjaccess_batched_render_batches(const MjAccessBatchedSim* sim,
+                                            MjAccessRenderBatch* out, int n) {
+    if (!sim) return 0;
+    int nb = sim->render_nbatches;
+    if (out) memcpy(out, sim->render_batches, (n < nb ? n : nb) * sizeof(MjAccessRenderBatch));
+    return nb;
+}
+
+MJA_API int mjaccess_batched_render_geoms(const MjAccessBatchedSim* sim, int* out, int n) {
+    if (!sim) return 0;
+    int total = sim->render_total;
+    if (out) memcpy(out, sim->render_geoms, (n < total ? n : total) * sizeof(int));
+    return total;
+}
+
+typedef struct {
+    MjAccessBatchedSim* sim;
+    const int*          envs;
+    int                 n_envs;
+    int                 columns;
+    float               spacing[2];
+    float               origin[3];
+    float*              out;
+} RenderJob;
+
+// One env slot: its matrices in every batch. Unity axes are MuJoCo's with y
+// and z swapped, so the Unity rotation is R[p(i)][p(j)] with p = (0, 2, 1).
+static void render_task(void* ctx, int begin, int end, int worker) {
+    (void)worker;
+    const RenderJob* job = (const RenderJob*)ctx;
+    const MjAccessBatchedSim* sim = job->sim;
+    static const int p[3] = { 0, 2, 1 };
+    for (int k = begin; k < end; k++) {
+        int env = job->envs ? job->envs[k] : k;
+        const mjData* d = sim->datas[env];
+        float off[3] = {
+            job->origin[0] + (k % job->columns) * job->spacing[0],
+            job->origin[1],
+            job->origin[2] + (k / job->columns) * job->spacing[1],
+        };
+        for (int b = 0; b < sim->render_nbatches; b++) {
+            const MjAccessRenderBatch* batch = &sim->render_batches[b];
+            float* dst = job->out + ((size_t)batch->first * job->n_envs +
+                                     (size_t)k * batch->count) * 16;
+            for (int j = 0; j < batch->count; j++, dst += 16) {
+                int i = batch->first + j;
+                int g = sim->render_geoms[i];
+                const float* s = sim->render_scale + 3 * i;
+                const mjtNum* pos = d->geom_xpos + 3 * g;
+                const mjtNum* mat = d->geom_xmat + 9 * g;
+                for (int c = 0; c < 3; c++) {
+                    for (int r = 0; r < 3; r++)
+                        dst[4 * c + r] = (float)mat[3 * p[r] + p[c]] * s[c];
+                    dst[4 * c + 3] = 0.0f;
+                    dst[12 + c] = (float)pos[p[c]] + off[c];
+                }
+                dst[15] = 1.0f;
+            }
+        }
+    }
+}
+
+MJA_API int mjaccess_batched_render_matrices(MjAccessBatchedSim* sim, const int* envs,
+                                             int n_envs, const MjAccessRenderGrid* grid,
+                                             float* out, int n) {
+    if (!sim || n_envs < 0 || (!envs && n_envs > sim->num_envs)) return -1;
+    long long count = (long long)sim->render_total * n_envs;
+    if (count > n || (count > 0 && !out)) return -1;
+    for (int k = 0; envs && k < n_envs; k++) {
+        if (envs[k] < 0 || envs[k] >= sim->num_envs) return -1;
+    }
+    batched_async_join(sim);
+    if (count == 0) return 0;
+
+    RenderJob job;
+    memset(&job, 0, sizeof(job));
+    job.sim = sim;
+    job.envs = envs;
+    job.n_envs = n_envs;
+    job.out = out;
+    job.columns = 1;
+    if (grid) {
+        job.columns = grid->columns > 0 ? grid->columns : (int)ceil(sqrt((double)n_envs));
+        memcpy(job.spacing, grid->spacing, sizeof(job.spacing));
+        memcpy(job.origin, grid->origin, sizeof(job.origin));
+    }
+    pool_run(sim->pool, n_envs, render_task, &job);
+    return (int)count;
+}
+
+// ── Derivatives ──────────────────────────────────────────────
+
+// Per-worker scratch: an mjData to step and the outputs of its last two
+// evaluations. Rows of an evaluation: next qpos, qvel, act, then sensordata.
+typedef struct {
+    mjData* d;
+    mjtNum* unit;   // [nv] zeros, one entry set while nudging qpos
+    mjtNum* dq;     // [nv]
+    mjtNum* plus;   // [ny]
+    mjtNum* minus;  // [ny]
+} MjaFdScratch;
+
+struct MjaFd {
+    MjaPool*      pool;
+    int           owns_pool;
+    int           nscratch;
+    MjaFdScratch* scratch;  // [nscratch]
+    const mjModel* model;   // model the scratch was made for
+    int           state_size;
+    int           ny;
+    int           nenv;
+    mjtNum*       base;     // [nenv * state_size] mjSTATE_INTEGRATION per env
+    mjtNum*       nominal;  // [nenv * ny] unperturbed step per env
+};
+
+static void fd_free_scratch(MjaFd* fd) {
+    for (int w = 0; w < fd->nscratch; w++) {
+        MjaFdScratch* s = &fd->scratch[w];
+        if (s->d) mj_deleteData(s->d);
+        free(s->unit);
+        free(s->dq);
+        free(s->plus);
+        free(s->minus);
+    }
+    free(fd->scratch);
+    free(fd->base);
+    free(fd->nominal);
+    fd->scratch = NULL;
+    fd->base = fd->nominal = NULL;
+    fd->nscratch = fd->nenv = 0;
+}
+
+static void fd_free(MjaFd* fd) {
+    if (!fd) return;
+    fd_free_scratch(fd);
+    if (fd->owns_pool) pool_destroy(fd->pool);
+    free(fd);
+}
+
+// (Re)build the scratch for a new model or env count. Recompiling or
+// reloading a model drops the scratch of the data using it, and batched
+// sims block both, so the model pointer identifies its sizes.
+static int fd_prepare(MjaFd* fd, const mjModel* m, int nenv) {
+    if (fd->scratch && fd->nenv == nenv && fd->model == m) return 0;
+    fd_free_scratch(fd);
+    fd->state_size = mj_stateSize(m, mjSTATE_INTEGRATION);
+    fd->ny = m->nq + m->nv + m->na + m->nsensordata;
+    fd->nscratch = fd->pool->num_threads;
+    fd->nenv = nenv;
+    fd->scratch = (MjaFdScratch*)calloc(fd->nscratch, sizeof(MjaFdScratch));
+    fd->base = (mjtNum*)malloc(((size_t)nenv * fd->state_size + 1) * sizeof(mjtNum));
+    fd->nominal = (mjtNum*)malloc(((size_t)nenv * fd->ny + 1) * sizeof(mjtNum));
+    int ok = fd->scratch && fd->base && fd->nominal;
+    for (int w = 0; ok && w < fd->nscratch; w++) {
+        MjaFdScratch* s = &fd->scratch[w];
+        s->d = mj_makeData(m);
+        s->unit = (mjtNum*)calloc(m->nv + 1, sizeof(mjtNum));
+        s->dq = (mjtNum*)malloc((m->nv + 1) * sizeof(mjtNum));
+        s->plus = (mjtNum*)malloc((fd->ny + 1) * sizeof(mjtNum));
+        s->minus = (mjtNum*)malloc((fd->ny + 1) * sizeof(mjtNum));
+        ok = s->d && s->unit && s->dq && s->plus && s->minus;
+    }
+    if (!ok) {
+        fd_free_scratch(fd);
+        return -1;
+    }
+    fd->model = m;
+    return 0;
+}
+
+typedef struct {
+    MjaFd*              fd;
+    MjAccessBatchedSim* sim;    // NULL = single data
+    const mjModel*      m;      // model of a single data
+    mjData* const*      src;    // [nenv] states to linearize
+    int                 nx;     // 2 * nv + na
+    int                 ncol;   // nx + nu
+    mjtNum              eps;
+    int                 centered;
+    double*             A;
+    double*             B;
+    double*             C;
+    double*             D;
+} FdJob;
+
+static const mjModel* fd_model(const FdJob* job, int env, int worker) {
+    return job->sim ? batched_env_model(job->sim, env, worker) : job->m;
+}
+
+// One step of the scratch from env's base state with column col nudged by
+// delta (col < 0 = no nudge); the step's outputs go to y.
+static void fd_eval(const FdJob* job, const mjModel* m, MjaFdScratch* s, int env, int col,
+                    mjtNum delta, mjtNum* y) {
+    mjData* d = s->d;
+    mj_setState(m, d, job->fd->base + (size_t)env * job->fd->state_size, mjSTATE_INTEGRATION);
+    if (col >= 0 && col < m->nv) {
+        s->unit[col] = 1;
+        mj_integratePos(m, d->qpos, s->unit, delta);
+        s->unit[col] = 0;
+    } else if (col >= 0 && col < 2 * m->nv) {
+        d->qvel[col - m->nv] += delta;
+    } else if (col >= 0 && col < job->nx) {
+        d->act[col - 2 * m->nv] += delta;
+    } else if (col >= 0) {
+        d->ctrl[col - job->nx] += delta;
+    }
+    mj_step(m, d);
+    mju_copy(y, d->qpos, m->nq);
+    mju_copy(y + m->nq, d->qvel, m->nv);
+    mju_copy(y + m->nq + m->nv, d->act, m->na);
+    mju_copy(y + m->nq + m->nv + m->na, d->sensordata, m->nsensordata);
+}
+
+static void fd_nominal_task(void* ctx, int begin, int end, int worker) {
+    const FdJob* job = (const FdJob*)ctx;
+    MjaFd* fd = job->fd;
+    for (int env = begin; env < end; env++) {
+        const mjModel* m = fd_model(job, env, worker);
+        mj_getState(m, job->src[env], fd->base + (size_t)env * fd->state_size,
+                    mjSTATE_INTEGRATION);
+        fd_eval(job, m, &fd->scratch[worker], env, -1, 0, fd->nominal + (size_t)env * fd->ny);
+    }
+}
+
+// Task t = one column of one env: (plus - minus) * scale, where plus and
+// minus are steps nudged by +eps / -eps or the nominal step. Limited controls
+// are only nudged inside their range, as mjd_transitionFD does.
+static void fd_column_task(void* ctx, int begin, int end, int worker) {
+    const FdJob* job = (const FdJob*)ctx;
+    MjaFd* fd = job->fd;
+    MjaFdScratch* s = &fd->scratch[worker];
+    for (int t = begin; t < end; t++) {
+        int env = t / job->ncol, col = t % job->ncol;
+        int is_ctrl = col >= job->nx;
+        if (is_ctrl ? (!job->B && !job->D) : (!job->A && !job->C)) continue;
+        const mjModel* m = fd_model(job, env, worker);
+        const mjtNum* nominal = fd->nominal + (size_t)env * fd->ny;
+        mjtNum eps = job->eps;
+        int up = 1, down = 1;
+        if (is_ctrl && m->actuator_ctrllimited[col - job->nx]) {
+            int u = col - job->nx;
+            mjtNum ctrl = job->src[env]->ctrl[u];
+            up = ctrl + eps <= m->actuator_ctrlrange[2 * u + 1];
+            down = ctrl - eps >= m->actuator_ctrlrange[2 * u];
+        }
+        const mjtNum *plus = s->plus, *minus = s->minus;
+        mjtNum scale;
+        if (job->centered && up && down) {
+            fd_eval(job, m, s, env, col, eps, s->plus);
+            fd_eval(job, m, s, env, col, -eps, s->minus);
+            scale = 0.5 / eps;
+        } else if (up) {
+            fd_eval(job, m, s, env, col, eps, s->plus);
+            minus = nominal;
+            scale = 1 / eps;
+        } else {
+            plus = nominal;
+            fd_eval(job, m, s, env, col, -eps, s->minus);
+            scale = 1 / eps;
+        }
+
+        int nv = m->nv, na = m->na, ns = m->nsensordata, nu = m->nu;
+        int nx = job->nx, c = is_ctrl ? col - nx : col;
+        double* X = is_ctrl ? job->B : job->A;  // state rows
+        double* Y = is_ctrl ? job->D : job->C;  // sensor rows
+        int stride = is_ctrl ? nu : nx;
+        if (X) {
+            X += (size_t)env * nx * stride;
+            mj_differentiatePos(m, s->dq, 1, minus, plus);
+            for (int r = 0; r < nv; r++) X[r * stride + c] = s->dq[r] * scale;
+            const mjtNum *vp = plus + m->nq, *vm = minus + m->nq;
+            for (int r = 0; r < nv + na; r++) X[(nv + r) * stride + c] = (vp[r] - vm[r]) * scale;
+        }
+        if (Y) {
+            Y += (size_t)env * ns * stride;
+            const mjtNum *sp = plus + m->nq + nv + na, *sm = minus + m->nq + nv + na;
+            for (int r = 0; r < ns; r++) Y[r * stride + c] = (sp[r] - sm[r]) * scale;
+        }
+    }
+}
+
+static void fd_run(FdJob* job, int nenv) {
+    pool_run(job->fd->pool, nenv, fd_nominal_task, job);
+    pool_run(job->fd->pool, nenv * job->ncol, fd_column_task, job);
+}
+
+MJA_API int mjaccess_transition_fd_threads(MjAccessData* data, int num_threads) {
+    if (!data) return -1;
+    int nt = num_threads > 0 ? num_threads : mja_online_cpus();
+    if (data->fd && data->fd->pool->num_threads == nt) return nt;
+    fd_free(data->fd);
+    data->fd = (MjaFd*)calloc(1, sizeof(MjaFd));
+    if (data->fd) data->fd->pool = pool_create(nt, 0, 0, 0);
+    if (!data->fd || !data->fd->pool) {
+        free(data->fd);
+        data->fd = NULL;
+        return -1;
+    }
+    data->fd->owns_pool = 1;
+    return data->fd->pool->num_threads;
+}
+
+MJA_API int mjaccess_transition_fd(MjAccessModel* model, MjAccessData* data, double eps,
+                                   int centered, double* A, double* B, double* C, double* D) {
+    if (!model || !model->mj || !data || !data->mj || eps <= 0) return -1;
+    if (!data->fd && mjaccess_transition_fd_threads(data, 0) < 0) return -1;
+    const mjModel* m = model->mj;
+    MjaFd* fd = data->fd;
+    if (fd_prepare(fd, m, 1) != 0) return -1;
+    if (fd->pool->num_threads == 1) {
+        // mjd_transitionFD restores the state but not the derived quantities,
+        // so linearize a copy.
+        mj_copyData(fd->scratch[0].d, m, data->mj);
+        mjd_transitionFD(m, fd->scratch[0].d, eps, (mjtByte)(centered != 0), A, B, C, D);
+        return 0;
+    }
+    FdJob job;
+    memset(&job, 0, sizeof(job));
+    job.fd = fd;
+    job.m = m;
+    job.src = &data->mj;
+    job.nx = 2 * m->nv + m->na;
+    job.ncol = job.nx + m->nu;
+    job.eps = eps;
+    job.centered = centered;
+    job.A = A;
+    job.B = B;
+    job.C = C;
+    job.D = D;
+    fd_run(&job, 1);
+    return 0;
+}
+
+MJA_API int mjaccess_batched_transition_fd(MjAccessBatchedSim* sim, double eps, int centered,
+                                           double* A, double* B, double* C, double* D) {
+    if (!sim || eps <= 0) return -1;
+    batched_async_join(sim);
+    const mjModel* m = sim->model_ref;
+    if (!sim->fd) {
+        sim->fd = (MjaFd*)calloc(1, sizeof(MjaFd));
+        if (!sim->fd) return -1;
+        sim->fd->pool = sim->pool;
+    }
+    if (fd_prepare(sim->fd, m, sim->num_envs) != 0) return -1;
+    batched_sync_models(sim);
+    FdJob job;
+    memset(&job, 0, sizeof(job));
+    job.fd = sim->fd;
+    job.sim = sim;
+    job.m = m;
+    job.src = sim->datas;
+    job.nx = 2 * m->nv + m->na;
+    job.ncol = job.nx + m->nu;
+    job.eps = eps;
+    job.centered = centered;
+    job.A = A;
+    job.B = B;
+    job.C = C;
+    job.D = D;
+    fd_run(&job, sim->num_envs);
+    return 0;
+}
+
+// ── Rollouts ─────────────────────────────────────────────────
+
+MJA_API int mjaccess_state_size(const MjAccessModel* model, unsigned spec) {
+    return (model && model->mj) ? mj_stateSize(model->mj, spec) : 0;
+}
+
+MJA_API int mjaccess_get_state(const MjAccessData* data, unsigned spec, double* state) {
+    if (!data || !data->mj || !state) return -1;
+    mj_getState(data->model_ref, data->mj, state, spec);
+    return mj_stateSize(data->model_ref, spec);
+}
+
+MJA_API int mjaccess_set_state(MjAccessData* data, unsigned spec, const double* state) {
+    if (!data || !data->mj || !state) return -1;
+    mj_setState(data->model_ref, data->mj, state, spec);
+    return mj_stateSize(data->model_ref, spec);
+}
+
+struct MjAccessRollout {
+    MjAccessModel* model; // non-owning; followed across recompiles and reloads
+    mjModel*  model_ref;  // model->mj when the scratch was made
+    unsigned  generation; // model->generation when the scratch was made
+    MjaPool*  pool;
+    mjData**  scratch;    // [num_threads]
+    mjtNum*   dq;         // [num_threads * nv] tangent-space qpos error
+    unsigned  start_spec;
+    unsigned  out_spec;
+    int       start_size;
+    int       out_size;
+    // quadratic cost, NULL = off; each weight array NULL = term off
+    double*   cost_arena;
+    double*   qpos_ref;   // [nq]
+    double*   qpos_w;     // [nv]
+    double*   qvel_ref;   // [nv]
+    double*   qvel_w;     // [nv]
+    double*   ctrl_ref;   // [nu]
+    double*   ctrl_w;     // [nu]
+    double*   sensor_ref; // [nsensordata]
+    double*   sensor_w;   // [nsensordata]
+    double    terminal;
+};
+
+static void rollout_free_scratch(MjAccessRollout* ro) {
+    if (ro->scratch) {
+        for (int w = 0; w < ro->pool->num_threads; w++) {
+            if (ro->scratch[w]) mj_deleteData(ro->scratch[w]);
+        }
+    }
+    free(ro->scratch);
+    free(ro->dq);
+    ro->scratch = NULL;
+    ro->dq = NULL;
+}
+
+static void rollout_clear_cost(MjAccessRollout* ro) {
+    free(ro->cost_arena);
+    ro->cost_arena = NULL;
+    ro->qpos_ref = ro->qpos_w = ro->qvel_ref = ro->qvel_w = NULL;
+    ro->ctrl_ref = ro->ctrl_w = ro->sensor_ref = ro->sensor_w = NULL;
+    ro->terminal = 0;
+}
+
+// Per-worker scratch for the model as it is now. After a recompile or
+// reload it is rebuilt and the cost, whose arrays may no longer match, dropped.
+static int rollout_prepare(MjAccessRollout* ro) {
+    mjModel* m = ro->model->mj;
+    if (ro->scratch && ro->model_ref == m && ro->generation == ro->model->generation) return 0;
+    rollout_free_scratch(ro);
+    rollout_clear_cost(ro);
+    int nt = ro->pool->num_threads;
+    ro->scratch = (mjData**)calloc(nt, sizeof(mjData*));
+    ro->dq = (mjtNum*)malloc(((size_t)nt * m->nv + 1) * sizeof(mjtNum));
+    ro->model_ref = m;
+    ro->generation = ro->model->generation;
+    int ok = ro->scratch && ro->dq;
+    for (int w = 0; ok && w < nt; w++) ok = (ro->scratch[w] = mj_makeData(m)) != NULL;
+    if (!ok) {
+        rollout_free_scratch(ro);
+        return -1;
+    }
+    ro->start_size = mj_stateSize(m, ro->start_spec);
+    ro->out_size = mj_stateSize(m, ro->out_spec);
+    return 0;
+}
+
+MJA_API MjAccessRollout* mjaccess_rollout_create(MjAccessModel* model,
+                                                 const MjAccessRolloutConfig* config) {
+    if (!model || !model->mj) return NULL;
+    MjAccessRolloutConfig cfg = { 0, 0, 0 };
+    if (config) cfg = *config;
+    MjAccessRollout* ro = (MjAccessRollout*)calloc(1, sizeof(MjAccessRollout));
+    if (!ro) return NULL;
+    ro->model = model;
+    ro->start_spec = cfg.start_spec ? cfg.start_spec : mjSTATE_INTEGRATION;
+    ro->out_spec = cfg.out_spec ? cfg.out_spec : mjSTATE_FULLPHYSICS;
+    ro->pool = pool_create(cfg.num_threads > 0 ? cfg.num_threads : mja_online_cpus(), 1, 0, 0);
+    if (!ro->pool || rollout_prepare(ro) != 0) {
+        mjaccess_rollout_free(ro);
+        return NULL;
+    }
+    return ro;
+}
+
+MJA_API void mjaccess_rollout_free(MjAccessRollout* ro) {
+    if (!ro) return;
+    if (ro->pool) rollout_free_scratch(ro);
+    rollout_clear_cost(ro);
+    pool_destroy(ro->pool);
+    free(ro);
+}
+
+MJA_API int mjaccess_rollout_num_threads(const MjAccessRollout* ro) {
+    return ro ? ro->pool->num_threads : 0;
+}
+
+MJA_API int mjaccess_rollout_state_size(MjAccessRollout* ro, int* out_size) {
+    if (!ro || rollout_prepare(ro) != 0) return 0;
+    if (out_size) *out_size = ro->out_size;
+    return ro->start_size;
+}
+
+MJA_API int mjaccess_rollout_set_cost(MjAccessRollout* ro, const MjAccessRolloutCost* cost) {
+    if (!ro || rollout_prepare(ro) != 0) return -1;
+    rollout_clear_cost(ro);
+    if (!cost) return 0;
+    const mjModel* m = ro->model_ref;
+    int nq = m->nq, nv = m->nv, nu = m->nu, ns = m->nsensordata;
+    ro->cost_arena = (double*)calloc((size_t)nq + 3 * nv + 2 * nu + 2 * ns + 1, sizeof(double));
+    if (!ro->cost_arena) return -1;
+    double* p = ro->cost_arena;
+    ro->qpos_ref = p;    p += nq;
+    ro->qvel_ref = p;    p += nv;
+    ro->ctrl_ref = p;    p += nu;
+    ro->sensor_ref = p;  p += ns;
+    memcpy(ro->qpos_ref, cost->qpos_ref ? cost->qpos_ref : m->qpos0, nq * sizeof(double));
+    if (cost->qvel_ref) memcpy(ro->qvel_ref, cost->qvel_ref, nv * sizeof(double));
+    if (cost->ctrl_ref) memcpy(ro->ctrl_ref, cost->ctrl_ref, nu * sizeof(double));
+    if (cost->sensor_ref) memcpy(ro->sensor_ref, cost->sensor_ref, ns * sizeof(double));
+    // weights share the tail; a missing one stays NULL
+    if (cost->qpos_weight) { ro->qpos_w = p;  p += nv;  memcpy(ro->qpos_w, cost->qpos_weight, nv * sizeof(double)); }
+    if (cost->qvel_weight) { ro->qvel_w = p;  p += nv;  memcpy(ro->qvel_w, cost->qvel_weight, nv * sizeof(double)); }
+    if (cost->ctrl_weight) { ro->ctrl_w = p;  p += nu;  memcpy(ro->ctrl_w, cost->ctrl_weight, nu * sizeof(double)); }
+    if (cost->sensor_weight) { ro->sensor_w = p;  p += ns;  memcpy(ro->sensor_w, cost->sensor_weight, ns * sizeof(double)); }
+    ro->terminal = cost->terminal;
+    return 0;
+}
+
+static double rollout_wsq(const double* w, const double* ref, const mjtNum* x, int n) {
+    double c = 0;
+    for (int i = 0; i < n; i++) {
+        double e = x[i] - ref[i];
+        c += w[i] * e * e;
+    }
+    return c;
+}
+
+// State and sensor terms of the cost at d's current state.
+static double rollout_state_cost(const MjAccessRollout* ro, const mjModel* m, const mjData* d,
+                                 mjtNum* dq) {
+    double c = 0;
+    if (ro->qpos_w) {
+        mj_differentiatePos(m, dq, 1, ro->qpos_ref, d->qpos);
+        for (int i = 0; i < m->nv; i++) c += ro->qpos_w[i] * dq[i] * dq[i];
+    }
+    if (ro->qvel_w) c += rollout_wsq(ro->qvel_w, ro->qvel_ref, d->qvel, m->nv);
+    if (ro->sensor_w) c += rollout_wsq(ro->sensor_w, ro->sensor_ref, d->sensordata, m->nsensordata);
+    return c;
+}
+
+typedef struct {
+    MjAccessRollout* ro;
+    const double*    start;
+    int              horizon;
+    const double*    ctrl;
+    double*          out_states;
+    double*          out_sensors;
+    double*          out_costs;
+} RolloutJob;
+
+// Rollout k from start to finish on one worker. A step that trips MuJoCo's
+// bad-acceleration reset gives the rollout an infinite cost.
+static void rollout_task(void* ctx, int begin, int end, int worker) {
+    const RolloutJob* job = (const RolloutJob*)ctx;
+    MjAccessRollout* ro = job->ro;
+    const mjModel* m = ro->model_ref;
+    mjData* d = ro->scratch[worker];
+    mjtNum* dq = ro->dq + (size_t)worker * m->nv;
+    int nu = m->nu, ns = m->nsensordata, H = job->horizon;
+    for (int k = begin; k < end; k++) {
+        mj_resetData(m, d);
+        mj_setState(m, d, job->start, ro->start_spec);
+        int bad0 = d->warning[mjWARN_BADQACC].number;
+        double cost = 0;
+        for (int t = 0; t < H; t++) {
+            size_t row = (size_t)k * H + t;
+            mju_copy(d->ctrl, job->ctrl + row * nu, nu);
+            mj_step(m, d);
+            if (job->out_states) mj_getState(m, d, job->out_states + row * ro->out_size, ro->out_spec);
+            if (job->out_sensors) mju_copy(job->out_sensors + row * ns, d->sensordata, ns);
+            if (job->out_costs && ro->cost_arena) {
+                double c = rollout_state_cost(ro, m, d, dq);
+                if (t == H - 1) c *= 1 + ro->terminal;
+                if (ro->ctrl_w) c += rollout_wsq(ro->ctrl_w, ro->ctrl_ref, d->ctrl, nu);
+                cost += c;
+            }
+        }
+        if (job->out_costs)
+            job->out_costs[k] = d->warning[mjWARN_BADQACC].number != bad0 ? HUGE_VAL : cost;
+    }
+}
+
+MJA_API int mjaccess_rollout(MjAccessRollout* ro, const double* start_state, int nroll,
+                             int horizon, const double* ctrl, double* out_states,
+                             double* out_sensors, double* out_costs) {
+    if (!ro || !start_state || nroll < 0 || horizon <= 0 || rollout_prepare(ro) != 0 ||
+        (!ctrl && ro->model_ref->nu > 0))
+        return -1;
+    RolloutJob job = { ro, start_state, horizon, ctrl, out_states, out_sensors, out_costs };
+    pool_run(ro->pool, nroll, rollout_task, &job);
+    return 0;
+}
+
+// ── Multi-model batched sim ──────────────────────────────────
+//
+// Groups of envs from different models share one worker pool and are stepped
+// in a single dispatch. Each step lays the envs out by descending measured
+// cost and cuts the sequence into per-worker ranges of equal estimated cost;
+// work stealing absorbs what the estimate misses.
+
+MJA_API MjAccessMultiSim* mjaccess_multi_create(const MjAccessBatchedConfig* config) {
+    if (!config) return NULL;
+    MjAccessMultiSim* ms = (MjAccessMultiSim*)calloc(1, sizeof(MjAccessMultiSim));
+    if (!ms) return NULL;
+    int nt = config->num_threads > 0 ? config->num_threads : mja_online_cpus();
+    ms->pool = pool_create(nt, config->chunk_size, config->pin_threads, config->cpu_offset);
+    ms->env_first = (int*)calloc(1, sizeof(int));
+    ms->ctrl_first = (int*)calloc(1, sizeof(int));
+    if (!ms->pool || !ms->env_first || !ms->ctrl_first) {
+        mjaccess_multi_free(ms);
+        return NULL;
+    }
+    ms->bounds = (int*)calloc(ms->pool->num_threads + 1, sizeof(int));
+    if (!ms->bounds) {
+        mjaccess_multi_free(ms);
+        return NULL;
+    }
+    return ms;
+}
+
+MJA_API void mjaccess_multi_free(MjAccessMultiSim* ms) {
+    if (!ms) return;
+    for (int g = 0; g < ms->ngroups; g++) mjaccess_batched_free(ms->groups[g]);
+    pool_destroy(ms->pool);
+    free(ms->groups);
+    free(ms->env_first);
+    free(ms->ctrl_first);
+    free(ms->cost_ns);
+    free(ms->acc);
+    free(ms->sorted);
+    free(ms->env_group);
+    free(ms->order);
+    free(ms->bounds);
+    free(ms);
+}
+
+// Grow every per-group array to hold `ng` groups and `total` envs.
+static int multi_reserve(MjAccessMultiSim* ms, int ng, int total) {
+    int nt = ms->pool->num_threads;
+    int stride = (ng + 3) & ~3;  // 4 groups x {ns, count} = one cache line
+    void* p;
+    if (!(p = realloc(ms->groups, ng * sizeof(*ms->groups)))) return -1;
+    ms->groups = (MjAccessBatchedSim**)p;
+    if (!(p = realloc(ms->env_first, (ng + 1) * sizeof(int)))) return -1;
+    ms->env_first = (int*)p;
+    if (!(p = realloc(ms->ctrl_first, (ng + 1) * sizeof(int)))) return -1;
+    ms->ctrl_first = (int*)p;
+    if (!(p = realloc(ms->cost_ns, ng * sizeof(double)))) return -1;
+    ms->cost_ns = (double*)p;
+    if (!(p = realloc(ms->sorted, ng * sizeof(int)))) return -1;
+    ms->sorted = (int*)p;
+    if (!(p = realloc(ms->env_group, total * sizeof(int)))) return -1;
+    ms->env_group = (int*)p;
+    if (!(p = realloc(ms->order, total * sizeof(int)))) return -1;
+    ms->order = (int*)p;
+    if (!(p = calloc((size_t)nt * stride * 2, sizeof(double)))) return -1;
+    free(ms->acc);
+    ms->acc = (double*)p;
+    ms->acc_stride = stride;
+    return 0;
+}
+
+MJA_API int mjaccess_multi_add_group(MjAccessMultiSim* ms, MjAccessModel* model,
+                                     const MjAccessBatchedConfig* config) {
+    if (!ms || !config || config->num_envs <= 0) return -1;
+    int ng = ms->ngroups;
+    int first = ms->env_first[ng];
+    if (multi_reserve(ms, ng + 1, first + config->num_envs) != 0) return -1;
+    MjAccessBatchedSim* sim = batched_create(model, config, ms->pool);
+    if (!sim) return -1;
+    ms->groups[ng] = sim;
+    ms->cost_ns[ng] = 0;
+    ms->env_first[ng + 1] = first + sim->num_envs;
+    ms->ctrl_first[ng + 1] = ms->ctrl_first[ng] + sim->num_envs * sim->model_ref->nu;
+    for (int i = 0; i < sim->num_envs; i++) ms->env_group[first + i] = ng;
+    ms->ngroups = ng + 1;
+    return ng;
+}
+
+MJA_API int mjaccess_multi_num_groups(const MjAccessMultiSim* ms) {
+    return ms ? ms->ngroups : 0;
+}
+
+MJA_API int mjaccess_multi_num_threads(const MjAccessMultiSim* ms) {
+    return ms ? ms->pool->num_threads : 0;
+}
+
+MJA_API MjAccessBatchedSim* mjaccess_multi_group(MjAccessMultiSim* ms, int group) {
+    if (!ms || group < 0 || group >= ms->ngroups) return NULL;
+    return ms->groups[group];
+}
+
+MJA_API int mjaccess_multi_ctrl_offset(const MjAccessMultiSim* ms, int group) {
+    if (!ms || group < 0 || group > ms->ngroups) return -1;
+    return ms->ctrl_first[group];
+}
+
+MJA_API double mjaccess_multi_group_cost(const MjAccessMultiSim* ms, int group) {
+    if (!ms || group < 0 || group >= ms->ngroups) return 0;
+    return ms->cost_ns[group];
+}
+
+// Order envs by descending group cost (unmeasured groups get the mean of the
+// measured ones) and cut the order at multiples of total_cost / num_threads.
+static void multi_plan(MjAccessMultiSim* ms) {
+    int ng = ms->ngroups;
+    int nt = ms->pool->num_threads;
+    double known = 0;
+    int nknown = 0;
+    for (int g = 0; g < ng; g++) {
+        if (ms->cost_ns[g] > 0) { known += ms->cost_ns[g]; nknown++; }
+    }
+    double fallback = nknown ? known / nknown : 1.0;
+    double total_cost = 0;
+    for (int g = 0; g < ng; g++) {
+        double c = ms->cost_ns[g] > 0 ? ms->cost_ns[g] : fallback;
+        total_cost += c * ms->groups[g]->num_envs;
+        int k = g;
+        while (k > 0) {
+            int h = ms->sorted[k - 1];
+            double ch = ms->cost_ns[h] > 0 ? ms->cost_ns[h] : fallback;
+            if (ch >= c) break;
+            ms->sorted[k] = h;
+            k--;
+        }
+        ms->sorted[k] = g;
+    }
+
+    int k = 0;
+    int w = 1;
+    double acc = 0;
+    ms->bounds[0] = 0;
+    for (int s = 0; s < ng; s++) {
+        int g = ms->sorted[s];
+        double c = ms->cost_ns[g] > 0 ? ms->cost_ns[g] : fallback;
+        for (int i = ms->env_first[g]; i < ms->env_first[g + 1]; i++) {
+            ms->order[k++] = i;
+            acc += c;
+            while (w < nt && acc >= total_cost * w / nt) ms->bounds[w++] = k;
+        }
+    }
+    while (w <= nt) ms->bounds[w++] = k;
+}
+
+typedef struct {
+    MjAccessMultiSim* ms;
+    BatchedStepJob*   jobs;  // [ngroups]
+} MultiStepJob;
+
+static void multi_step_task(void* ctx, int begin, int end, int worker) {
+    const MultiStepJob* job = (const MultiStepJob*)ctx;
+    MjAccessMultiSim* ms = job->ms;
+    double* acc = ms->acc + (size_t)worker * ms->acc_stride * 2;
+    for (int k = begin; k < end; k++) {
+        int idx = ms->order[k];
+        int g = ms->env_group[idx];
+        int env = idx - ms->env_first[g];
+        const unsigned char* active = job->jobs[g].sim->active;
+        if (active && !active[env]) continue;
+        long long t0 = mja_now_ns();
+        batched_step_env(&job->jobs[g], env, worker);
+        acc[g * 2] += (double)(mja_now_ns() - t0);
+        acc[g * 2 + 1] += 1;
+    }
+}
+
+// Fold the per-worker timings of the last job into the smoothed costs.
+static void multi_update_costs(MjAccessMultiSim* ms, int n_substeps) {
+    int nt = ms->pool->num_threads;
+    for (int g = 0; g < ms->ngroups; g++) {
+        double ns = 0, n = 0;
+        for (int w = 0; w < nt; w++) {
+            double* acc = ms->acc + ((size_t)w * ms->acc_stride + g) * 2;
+            ns += acc[0];
+            n += acc[1];
+            acc[0] = acc[1] = 0;
+        }
+        if (n <= 0) continue;
+        double c = ns / (n * n_substeps);
+        ms->cost_ns[g] = ms->cost_ns[g] > 0 ? 0.75 * ms->cost_ns[g] + 0.25 * c : c;
+    }
+}
+
+MJA_API void mjaccess_multi_step(MjAccessMultiSim* ms, const double* ctrl, int n_substeps) {
+    if (!ms || !ctrl || n_substeps <= 0 || ms->ngroups == 0) return;
+    BatchedStepJob* jobs = (BatchedStepJob*)malloc(ms->ngroups * sizeof(BatchedStepJob));
+    if (!jobs) return;
+    for (int g = 0; g < ms->ngroups; g++) {
+        MjAccessBatchedSim* sim = ms->groups[g];
+        BatchedStepJob job = { sim, ctrl + ms->ctrl_first[g], n_substeps, 0, 0, NULL };
+        jobs[g] = job;
+        batched_scatter_flush(sim);
+        batched_sync_models(sim);
+        if (sim->rec) recorder_acquire(sim->rec, 0, sim->num_envs);
+        if (sim->active) batched_idle_envs(sim, 0, sim->num_envs);
+    }
+    multi_plan(ms);
+    MultiStepJob job = { ms, jobs };
+    long long t0 = mja_now_ns();
+    pool_run_split(ms->pool, ms->env_first[ms->ngroups], ms->bounds, multi_step_task, &job);
+    double wall_ms = (mja_now_ns() - t0) * 1e-6;
+    multi_update_costs(ms, n_substeps);
+    for (int g = 0; g < ms->ngroups; g++) {
+        MjAccessBatchedSim* sim = ms->groups[g];
+        if (sim->rec) recorder_publish(sim->rec);
+        batched_obs_norm_merge(sim);
+        sim->done_pending = 0;
+        if (sim->prof) {
+            sim->prof_wall_ms += wall_ms;
+            sim->prof_jobs++;
+        }
+    }
+    free(jobs);
+}
@@ -3,7 +3,7 @@
 //
 // Thin C accessor shim over MuJoCo's mjModel/mjData structs.
 // Returns native double* pointers directly -- zero conversion overhead.
-// Batched simulation uses GCD dispatch_apply for parallel stepping.
+// Batched simulation steps envs on a persistent worker pool (pthreads).
 
 #ifndef MJACCESS_H
 #define MJACCESS_H
@@ -21,22 +21,237 @@ extern "C" {
 typedef struct MjAccessModel MjAccessModel;
 typedef struct MjAccessData MjAccessData;
 typedef struct MjAccessBatchedSim MjAccessBatchedSim;
+typedef struct MjAccessMultiSim MjAccessMultiSim;
+typedef struct MjAccessRecordReader MjAccessRecordReader;
+typedef struct MjAccessTrajectory MjAccessTrajectory;
+typedef struct MjAccessTrajWriter MjAccessTrajWriter;
+typedef struct MjAccessRollout MjAccessRollout;
+typedef struct MjAccessTerrain MjAccessTerrain;
+typedef struct MjAccessPhysicsThread MjAccessPhysicsThread;
 
 typedef struct {
     int nq, nv, nu, nbody, njnt, ngeom, nsite, nmocap;
     int ntendon, nsensor, nsensordata, neq;
+    int na;
 } MjAccessModelInfo;
 
+// Per-env fields held by a batched sim ([num_envs * dim] each).
+typedef enum {
+    MJA_FIELD_QPOS = 0,
+    MJA_FIELD_QVEL,
+    MJA_FIELD_CTRL,
+    MJA_FIELD_XPOS,
+    MJA_FIELD_XQUAT,
+    MJA_FIELD_SUBTREE_COM,
+    MJA_FIELD_CINERT,
+    MJA_FIELD_CVEL,
+    MJA_FIELD_QFRC_ACTUATOR,
+    MJA_FIELD_CFRC_EXT,
+    MJA_FIELD_SENSORDATA,
+    MJA_FIELD_GEOM_XPOS,
+    MJA_FIELD_GEOM_XMAT,
+    MJA_FIELD_COUNT
+} MjAccessField;
+
 typedef struct {
     int num_envs;
     int solver_iterations;  // 0 = model default
+    int num_threads;        // 0 = one per online CPU, 1 = step on the caller thread
+    int chunk_size;         // envs per work-stealing chunk, 0 = auto
+    int pin_threads;        // nonzero = pin worker i to CPU (cpu_offset + i); Linux/Android only
+    int cpu_offset;
+    int contiguous_state;   // nonzero = MjAccessField arrays live in shared slabs (zero-copy getters)
 } MjAccessBatchedConfig;
 
+// Observation terms: each reads one object's slice of an mjData array.
+typedef enum {
+    MJA_OBS_JOINT_QPOS = 0,     // joint: 7 free, 4 ball, 1 hinge/slide
+    MJA_OBS_JOINT_QVEL,         // joint: 6 free, 3 ball, 1 hinge/slide
+    MJA_OBS_ACTUATOR_CTRL,      // actuator: 1
+    MJA_OBS_BODY_XPOS,          // body: 3
+    MJA_OBS_BODY_XQUAT,         // body: 4
+    MJA_OBS_BODY_CVEL,          // body: 6
+    MJA_OBS_BODY_SUBTREE_COM,   // body: 3
+    MJA_OBS_BODY_CFRC_EXT,      // body: 6
+    MJA_OBS_SITE_XPOS,          // site: 3
+    MJA_OBS_GEOM_XPOS,          // geom: 3
+    MJA_OBS_SENSOR              // sensor: sensor_dim
+} MjAccessObsTerm;
+
+typedef struct {
+    unsigned long long seed;  // snapshot selection RNG (one stream per env)
+    int detect_bad_state;     // restart envs whose step hit NaN/inf or BADQPOS/BADQVEL/BADQACC
+} MjAccessAutoResetConfig;
+
+typedef struct {
+    float clip;     // normalized values are clamped to [-clip, clip], 0 = no clipping
+    float epsilon;  // added to the variance, 0 = 1e-8
+    float gamma;    // rewards: discount of the running return, 0 = 0.99
+} MjAccessNormConfig;
+
+// Spec attributes for mjaccess_spec_set_attr.
+typedef enum {
+    MJA_SPEC_POS = 0,   // body/geom/site: 3
+    MJA_SPEC_QUAT,      // body/geom/site: 4
+    MJA_SPEC_SIZE,      // geom/site: 3
+    MJA_SPEC_MASS,      // body/geom: 1
+    MJA_SPEC_FRICTION,  // geom: 3
+    MJA_SPEC_RGBA       // geom/site: 4
+} MjAccessSpecAttr;
+
+// Model arrays that can be overridden per env in a batched sim.
+typedef enum {
+    MJA_PARAM_BODY_MASS = 0,     // nbody x 1
+    MJA_PARAM_GEOM_FRICTION,     // ngeom x 3
+    MJA_PARAM_DOF_DAMPING,       // nv x 1
+    MJA_PARAM_ACTUATOR_GAINPRM,  // nu x mjNGAIN (10)
+    MJA_PARAM_COUNT
+} MjAccessParam;
+
+typedef enum {
+    MJA_DIST_UNIFORM = 0,   // [a, b]
+    MJA_DIST_LOG_UNIFORM,   // [a, b], a and b > 0
+    MJA_DIST_GAUSSIAN       // mean a, stddev b
+} MjAccessDist;
+
+typedef enum {
+    MJA_RAND_SCALE = 0,  // value *= sample
+    MJA_RAND_ADD,        // value += sample
+    MJA_RAND_SET         // value = sample
+} MjAccessRandOp;
+
+// One randomization term: draws from `dist` and applies `op` to the selected
+// elements of an env's parameter row.
+typedef struct {
+    int    param;      // MjAccessParam
+    int    obj;        // object id (body/geom/dof/actuator), -1 = all
+    int    component;  // column within the object, -1 = all
+    int    dist;       // MjAccessDist
+    int    op;         // MjAccessRandOp
+    int    shared;     // nonzero = one draw for every selected element
+    double a, b;
+} MjAccessRandTerm;
+
+// Step profile. stage_* follow mjtTimer (mjTIMER_STEP, mjTIMER_FORWARD, ...)
+// and are filled from mjData timers while profiling installs mjcb_time.
+// step_hist counts env steps by duration: bin 0 < 1 us, bin k in [2^(k-1), 2^k) us.
+#define MJA_PROFILE_STAGES 16
+#define MJA_PROFILE_BINS   24
+
+typedef struct {
+    long long jobs;         // batched step dispatches
+    long long env_steps;    // mj_step calls
+    double    wall_ms;      // caller time inside those dispatches
+    double    step_ms;      // summed over envs and workers
+    double    gather_ms;    // output and observation writes
+    double    stage_ms[MJA_PROFILE_STAGES];
+    long long stage_calls[MJA_PROFILE_STAGES];
+    long long contacts;     // sums of d->ncon, d->nefc and solver iterations after each step
+    long long constraints;
+    long long solver_iters;
+    int       max_contacts;
+    int       max_constraints;
+    long long step_hist[MJA_PROFILE_BINS];
+} MjAccessProfile;
+
+// Trajectory recording. Files start with the 8-byte magic "MJAREC\0\0" and an
+// MjAccessRecordInfo, followed by chunks: {uint32 'MJCK', uint32 n_frames,
+// uint64 payload bytes} and n_frames frames of {int64 frame, int32 env_first,
+// int32 env_count, uint32 size, uint32 reserved} + size payload bytes. A
+// decoded frame holds env_count rows of row_bytes: int32 episode, int32 step
+// within the episode, then the recorded fields in MjAccessField order.
+typedef enum {
+    MJA_RECORD_FLOAT32  = 1,  // store fields as float instead of double
+    MJA_RECORD_DELTA    = 2,  // XOR each row with the env's previous recorded row
+    MJA_RECORD_COMPRESS = 4,  // byte-shuffle + zero-run coding per frame
+    MJA_RECORD_DROP     = 8   // drop frames instead of stalling when the writer falls behind
+} MjAccessRecordFlags;
+
+typedef struct {
+    unsigned field_mask;    // bits of MjAccessField, 0 = qpos | qvel | ctrl | sensordata
+    int      ring_frames;   // frames buffered ahead of the writer, 0 = 16
+    int      chunk_frames;  // max frames per file chunk, 0 = 8
+    int      flags;         // MjAccessRecordFlags
+} MjAccessRecordConfig;
+
+typedef struct {
+    int      version;
+    int      num_envs;
+    unsigned field_mask;
+    int      flags;
+    int      elem_size;     // 8 = double, 4 = float
+    int      row_bytes;
+    int      dims[MJA_FIELD_COUNT];  // per-env length of every field, recorded or not
+} MjAccessRecordInfo;
+
+typedef struct {
+    long long frames;         // step jobs offered to the recorder
+    long long dropped;        // frames skipped under MJA_RECORD_DROP
+    long long bytes_raw;      // row bytes handed to the writer
+    long long bytes_written;  // file bytes, headers included
+    double    stall_ms;       // time the stepping thread waited on the writer
+    int       io_error;       // nonzero once a write failed
+} MjAccessRecordStats;
+
+typedef struct {
+    long long hits;
+    long long misses;
+    long long stores;
+    double    compile_ms;  // total time in the XML compiler
+    double    load_ms;     // total time loading cached binaries
+} MjAccessModelCacheStats;
+
 // ── Model lifecycle ──────────────────────────────────────────
 MJA_API MjAccessModel* mjaccess_load_model(const char* xml_path);
 MJA_API MjAccessModel* mjaccess_load_model_from_string(const char* xml_string);
 MJA_API void            mjaccess_free_model(MjAccessModel* model);
 
+// Compiled-model cache. With a directory set, both loaders look up a binary
+// model keyed by a hash of the XML text (and path) before compiling, and
+// store the compiled result on a miss. NULL or "" disables the cache.
+// Assets loaded by file name are not hashed: clear the directory after
+// editing them. Entries are never evicted. The directory and stats cover the whole process. A cache hit
+// parses no XML, so save_last_xml refuses models loaded from the cache.
+MJA_API int  mjaccess_model_cache_set_dir(const char* dir);
+MJA_API void mjaccess_model_cache_get_stats(MjAccessModelCacheStats* out);
+MJA_API void mjaccess_model_cache_reset_stats(void);
+
+// ── Incremental scene edits ──────────────────────────────────
+// Editable models keep their mjSpec. Edits change the spec only (names are
+// MJCF element names, obj_type is mjtObj); spec_recompile rebuilds the model
+// and data in place with mj_recompile, keeping the state of surviving
+// elements. set_attr writes the first n values of the attribute.
+// model_reload swaps in a model compiled from new MJCF (editable models get
+// a new spec), mapping joint qpos/qvel by name from old_qpos/old_qvel (NULL:
+// the data's current state). reload_mapped pairs joints explicitly instead:
+// joint_names[i] in the new model takes the state of old joint id
+// old_joint_ids[i], and unlisted joints start at qpos0 (old_joint_ids NULL:
+// map by name as reload does); use it when the MJCF generator does not keep
+// names stable. All three drop the data's finite-difference scratch and
+// contact filter. Handles made from the model:
+//   - batched sims, multi-sim groups and terrains keep pointers into it, so
+//     recompile and reload fail (-1) until they are freed;
+//   - rollouts follow the model and rebuild on their next call;
+//   - other data made from the model become invalid after a reload;
+//   - a physics thread must be stopped first.
+// All return 0 on success, -1 on error.
+MJA_API MjAccessModel* mjaccess_load_model_editable(const char* xml_string);
+MJA_API int mjaccess_model_is_editable(const MjAccessModel* model);
+MJA_API int mjaccess_spec_delete(MjAccessModel* model, int obj_type, const char* name);
+MJA_API int mjaccess_spec_add_body(MjAccessModel* model, const char* parent, const char* name,
+                                   const double* pos3, const double* quat4);
+MJA_API int mjaccess_spec_add_geom(MjAccessModel* model, const char* body, const char* name,
+                                   int geom_type, const double* size3, const double* pos3);
+MJA_API int mjaccess_spec_set_attr(MjAccessModel* model, int obj_type, const char* name,
+                                   int attr, const double* values, int n);
+MJA_API int mjaccess_spec_recompile(MjAccessModel* model, MjAccessData* data);
+MJA_API int mjaccess_model_reload(MjAccessModel* model, MjAccessData* data, const char* xml_string,
+                                  const double* old_qpos, const double* old_qvel);
+MJA_API int mjaccess_model_reload_mapped(MjAccessModel* model, MjAccessData* data,
+                                         const char* xml_string, const double* old_qpos,
+                                         const double* old_qvel, const char* const* joint_names,
+                                         const int* old_joint_ids, int n_joints);
+
 // ── Model accessors ──────────────────────────────────────────
 MJA_API MjAccessModelInfo mjaccess_model_info(const MjAccessModel* model);
 MJA_API double  mjaccess_model_opt_timestep(const MjAccessModel* model);
@@ -61,6 +276,10 @@ MJA_API const double* mjaccess_model_geom_pos(const MjAccessModel* model, int* n
 MJA_API const double* mjaccess_model_geom_quat(const MjAccessModel* model, int* n_out);
 MJA_API void mjaccess_model_set_hfield_data(MjAccessModel* model, int offset,
                                             const float* values, int n);
+// Strided dirty-rectangle write: rows x cols values, `stride` floats apart
+// (0 = cols), into rows [row, row + rows) and cols [col, col + cols).
+MJA_API int mjaccess_model_set_hfield_rect(MjAccessModel* model, int hfield_id, int row, int col,
+                                           int rows, int cols, const float* values, int stride);
 
 // ── Data lifecycle ───────────────────────────────────────────
 MJA_API MjAccessData* mjaccess_make_data(MjAccessModel* model);
@@ -69,6 +288,7 @@ MJA_API void           mjaccess_reset_data(MjAccessModel* model, MjAccessData* d
 
 // ── Simulation ───────────────────────────────────────────────
 MJA_API void mjaccess_step(MjAccessModel* model, MjAccessData* data);
+MJA_API void mjaccess_step_n(MjAccessModel* model, MjAccessData* data, int n_substeps);
 MJA_API void mjaccess_forward(MjAccessModel* model, MjAccessData* data);
 MJA_API void mjaccess_step1(MjAccessModel* model, MjAccessData* data);
 MJA_API void mjaccess_step2(MjAccessModel* model, MjAccessData* data);
@@ -123,6 +343,16 @@ MJA_API const int* mjaccess_get_wrap_obj(const MjAccessData* data, int* n_out);
 // Warnings
 MJA_API int mjaccess_get_warning_count(const MjAccessData* data, int index);
 
+// Profiling. profile_timers makes sure a process-wide mjcb_time clock is
+// installed so MuJoCo fills its per-stage timers: a clock the application set
+// is kept, otherwise one is installed and removed again when the last user
+// (profile_timers or a profiling batched sim) lets go.
+// get_profile reports one data's stage timers since the last reset_profile or
+// mj_resetData, and the contact/constraint counts of its current state.
+MJA_API void mjaccess_profile_timers(int enabled);
+MJA_API void mjaccess_get_profile(const MjAccessData* data, MjAccessProfile* out);
+MJA_API void mjaccess_reset_profile(MjAccessData* data);
+
 // Model I/O
 MJA_API int mjaccess_save_last_xml(const MjAccessModel* model, const char* path,
                                    char* error_buf, int error_buf_size);
@@ -132,22 +362,456 @@ MJA_API void mjaccess_object_velocity(const MjAccessModel* model, const MjAccess
                                       int objtype, int objid, int flg_local, double* result6);
 MJA_API void mjaccess_load_plugin_library(const char* path);
 
+// ── Bulk transforms ──────────────────────────────────────────
+// Unity-space pose of a MuJoCo frame, laid out as a Unity Vector3 + Quaternion:
+// position (x, z, y) and rotation (x, z, y, -w) of the MuJoCo values.
+typedef struct {
+    float pos[3];
+    float rot[4];
+} MjAccessPose;
+
+// bind_transforms stores a list of frames (objtypes mjOBJ_BODY, mjOBJ_XBODY,
+// mjOBJ_GEOM or mjOBJ_SITE) with optional Unity-space local offsets
+// (n * 7 floats, pose layout, NULL = none) composed on the right of each
+// frame. export_transforms writes the poses of all bound frames in one call
+// and returns the count, or -1 if out holds fewer than n poses. Invalid ids
+// are rejected by bind (-1) and exported as identity after a model reload.
+MJA_API int mjaccess_bind_transforms(MjAccessData* data, const int* objtypes, const int* ids,
+                                     const float* offsets, int n);
+MJA_API int mjaccess_export_transforms(const MjAccessData* data, MjAccessPose* out, int n);
+
+// ── Contacts ─────────────────────────────────────────────────
+// One contact in the MuJoCo world frame. frame rows are the normal (pointing
+// from geom[0] to geom[1]) and two tangents; force is mj_contactForce in that
+// frame (normal, two tangential, then torsional and rolling for condim > 3).
+typedef struct {
+    int    geom[2];
+    int    body[2];
+    double dist;
+    double pos[3];
+    double frame[9];
+    double force[6];
+} MjAccessContact;
+
+// contact_filter replaces one side (0 or 1) of the data's filter with geoms
+// (objtype mjOBJ_GEOM) or every geom of bodies (mjOBJ_BODY); n = 0 lets the
+// side match every geom. A contact passes when one geom is in side 0 and the
+// other in side 1, so registering the feet on side 0 and the floor on side 1
+// keeps foot-floor contacts only. export_contacts writes up to capacity
+// contacts and returns how many passed, or -1 on error.
+MJA_API int mjaccess_contact_filter(MjAccessData* data, int side, int objtype, const int* ids,
+                                    int n);
+MJA_API int mjaccess_export_contacts(const MjAccessData* data, MjAccessContact* out,
+                                     int capacity);
+
+// ── Kinematic playback ───────────────────────────────────────
+// Trajectory files hold fixed-stride qpos frames: a 64-byte header
+// ("MJATRAJ\0", version, nq, frame count, index offset), nframes * nq doubles
+// from byte 64, then a seek index of nframes frame times. open memory-maps the
+// file, so opening is O(1) in its size and frames are read in place.
+// locate maps a time to a fractional frame (O(1) for evenly spaced frames,
+// binary search otherwise). apply writes frame `frame` into data->qpos,
+// interpolating between neighbouring frames for fractional values (quaternions
+// of free and ball joints are renormalized), sets data->time and runs
+// mj_kinematics only. Returns -1 if nq does not match the model.
+MJA_API MjAccessTrajectory* mjaccess_traj_open(const char* path);
+MJA_API void          mjaccess_traj_close(MjAccessTrajectory* traj);
+MJA_API long long     mjaccess_traj_num_frames(const MjAccessTrajectory* traj);
+MJA_API int           mjaccess_traj_nq(const MjAccessTrajectory* traj);
+MJA_API double        mjaccess_traj_time(const MjAccessTrajectory* traj, long long frame);
+MJA_API const double* mjaccess_traj_frame(const MjAccessTrajectory* traj, long long frame);
+MJA_API double        mjaccess_traj_locate(const MjAccessTrajectory* traj, double time);
+MJA_API int           mjaccess_traj_apply(const MjAccessTrajectory* traj, MjAccessModel* model,
+                                          MjAccessData* data, double frame);
+
+// Trajectory writer: frames are appended as they come and the seek index is
+// written by close (returns -1 if any write failed). export_traj converts the
+// qpos of one env of a batched recording, frame k at time k * dt.
+MJA_API MjAccessTrajWriter* mjaccess_traj_writer_open(const char* path, int nq);
+MJA_API int mjaccess_traj_writer_add(MjAccessTrajWriter* writer, double time, const double* qpos);
+MJA_API int mjaccess_traj_writer_close(MjAccessTrajWriter* writer);
+MJA_API int mjaccess_record_export_traj(const char* record_path, int env, const char* traj_path,
+                                        double dt);
+
+// ── Derivatives ──────────────────────────────────────────────
+// Finite-difference transition Jacobians with the layout of mjd_transitionFD:
+// A = dx'/dx (nx x nx, nx = 2 * nv + na, qpos in tangent space), B = dx'/du
+// (nx x nu), C = dy/dx (nsensordata x nx) and D = dy/du (nsensordata x nu),
+// row-major, any of them NULL. Every column costs one step (two if centered)
+// from the current state; columns are spread over a worker pool and each
+// worker steps its own scratch mjData, so data is left untouched. Limited
+// controls are only nudged inside their range. transition_fd_threads sizes
+// the data's pool (0 = one per online CPU) and returns the worker count; with
+// one worker transition_fd calls mjd_transitionFD itself. The batched variant
+// linearizes every env in one job over (env, column) pairs, writing num_envs
+// env-major blocks to each buffer. Return 0, or -1 on error.
+MJA_API int mjaccess_transition_fd_threads(MjAccessData* data, int num_threads);
+MJA_API int mjaccess_transition_fd(MjAccessModel* model, MjAccessData* data, double eps,
+                                   int centered, double* A, double* B, double* C, double* D);
+MJA_API int mjaccess_batched_transition_fd(MjAccessBatchedSim* sim, double eps, int centered,
+                                           double* A, double* B, double* C, double* D);
+
+// ── Rollouts ─────────────────────────────────────────────────
+// mj_getState / mj_setState on a data; both return the state size.
+MJA_API int mjaccess_state_size(const MjAccessModel* model, unsigned spec);
+MJA_API int mjaccess_get_state(const MjAccessData* data, unsigned spec, double* state);
+MJA_API int mjaccess_set_state(MjAccessData* data, unsigned spec, const double* state);
+
+typedef struct {
+    unsigned start_spec;   // mjSTATE_* layout of start states, 0 = mjSTATE_INTEGRATION
+    unsigned out_spec;     // layout of recorded states, 0 = mjSTATE_FULLPHYSICS
+    int      num_threads;  // 0 = one per online CPU
+} MjAccessRolloutConfig;
+
+// Diagonal quadratic cost, summed over the states reached by each step:
+// qpos error is taken in tangent space (mj_differentiatePos), terminal scales
+// the state and sensor terms of the last step by (1 + terminal). NULL refs
+// mean qpos0 / zero; NULL weights turn a term off.
+typedef struct {
+    const double* qpos_ref;       // [nq]
+    const double* qpos_weight;    // [nv]
+    const double* qvel_ref;       // [nv]
+    const double* qvel_weight;    // [nv]
+    const double* ctrl_ref;       // [nu]
+    const double* ctrl_weight;    // [nu]
+    const double* sensor_ref;     // [nsensordata]
+    const double* sensor_weight;  // [nsensordata]
+    double        terminal;
+} MjAccessRolloutCost;
+
+// Sampling-based MPC rollouts. rollout branches one start state into nroll
+// control sequences (ctrl [nroll][horizon][nu]); each rollout runs start to
+// finish on one pool worker with that worker's scratch mjData, so there is
+// one fork/join per call. Outputs are optional: out_states
+// [nroll][horizon][out size], out_sensors [nroll][horizon][nsensordata] and
+// out_costs [nroll] (0 without a cost; a rollout that tripped MuJoCo's
+// bad-acceleration reset costs HUGE_VAL). A rollout follows its model through
+// spec_recompile and model_reload: the next call rebuilds the scratch for the
+// new model and clears the cost. state_size returns the start state size and
+// writes the out size.
+MJA_API MjAccessRollout* mjaccess_rollout_create(MjAccessModel* model,
+                                                 const MjAccessRolloutConfig* config);
+MJA_API void mjaccess_rollout_free(MjAccessRollout* ro);
+MJA_API int  mjaccess_rollout_num_threads(const MjAccessRollout* ro);
+MJA_API int  mjaccess_rollout_state_size(MjAccessRollout* ro, int* out_size);
+MJA_API int  mjaccess_rollout_set_cost(MjAccessRollout* ro, const MjAccessRolloutCost* cost);
+MJA_API int  mjaccess_rollout(MjAccessRollout* ro, const double* start_state, int nroll,
+                              int horizon, const double* ctrl, double* out_states,
+                              double* out_sensors, double* out_costs);
+
+// ── Terrain paging ───────────────────────────────────────────
+// Keeps a large world heightmap (row = y, col = x, in hfield data units) and
+// pages a window of it into one hfield. The window is the hfield's own
+// nrow x ncol at its own spacing; recentering moves it in whole tiles,
+// shifts the overlap in place, copies only the newly exposed strips, and
+// moves the geom so the terrain stays put in world space. The geom must be
+// unrotated and sit on the world body or on a body welded to it; that body
+// must be an unrotated child of the world and is moved instead, keeping the
+// geom's offset inside it (create fails otherwise). The hfield is
+// model-wide: recenter between steps, never while a sim is stepping it.
+typedef struct {
+    int    hfield_id;
+    int    geom_id;      // -1 = the first geom using hfield_id
+    int    rows, cols;   // world heightmap size in cells, at least the hfield's
+    double origin[2];    // world x, y of cell (0, 0)
+    int    tile;         // recenter granularity in cells, 0 = 16
+    int    track_body;   // body followed by terrain_update, -1 = none
+} MjAccessTerrainConfig;
+
+// path NULL keeps a zeroed world in memory; otherwise rows * cols raw
+// float32 are mapped copy-on-write from the file, so writes never reach it.
+MJA_API MjAccessTerrain* mjaccess_terrain_create(MjAccessModel* model,
+                                                 const MjAccessTerrainConfig* config,
+                                                 const char* path);
+MJA_API void   mjaccess_terrain_free(MjAccessTerrain* terrain);
+// The world map, for bulk fills; call refresh afterwards if the window is live.
+MJA_API float* mjaccess_terrain_world(MjAccessTerrain* terrain, int* rows, int* cols);
+// Window origin in world cells, -1 until the first center.
+MJA_API void   mjaccess_terrain_window(const MjAccessTerrain* terrain, int* row, int* col);
+// Center the window on world (x, y), or on the tracked body's xpos. Return the
+// cells copied into the hfield (0 = unchanged), or -1 on error.
+MJA_API int    mjaccess_terrain_center(MjAccessTerrain* terrain, double x, double y);
+MJA_API int    mjaccess_terrain_update(MjAccessTerrain* terrain, const MjAccessData* data);
+MJA_API int    mjaccess_terrain_refresh(MjAccessTerrain* terrain);
+// Strided dirty rectangle in world cells; the part inside the window is also
+// written to the hfield. Returns the hfield cells written, or -1.
+MJA_API int    mjaccess_terrain_write(MjAccessTerrain* terrain, int row, int col, int rows,
+                                      int cols, const float* values, int stride);
+
+// ── Physics thread ───────────────────────────────────────────
+// Steps one MjAccessData on a native thread, paced so sim time follows wall
+// time * speed, and publishes a snapshot (time, bound transforms, sensordata)
+// after every step through a lock-free exchange. Until stop, only the thread
+// touches the data: inputs go through the command queue, applied in order
+// before the next mj_step, and direct access needs lock/unlock. Not
+// available without pthreads (start returns NULL).
+typedef struct {
+    double speed;         // sim seconds per wall second, 0 = 1
+    double max_lag;       // sim seconds of backlog before time is dropped, 0 = 0.1
+    double render_delay;  // interpolate this far behind the clock, 0 = one timestep
+} MjAccessPhysicsConfig;
+
+typedef struct {
+    double              time;
+    long long           step;        // steps taken by the thread
+    const MjAccessPose* poses;       // [bound transforms at start]
+    const double*       sensordata;  // [nsensordata]
+} MjAccessPhysicsFrame;
+
+// Command types: values overwrite [offset, offset + n) of the mjData array.
+// RESET resets to keyframe `offset`, or to the model defaults when -1.
+enum {
+    MJA_CMD_CTRL = 0,
+    MJA_CMD_QPOS,
+    MJA_CMD_QVEL,
+    MJA_CMD_ACT,
+    MJA_CMD_MOCAP_POS,
+    MJA_CMD_MOCAP_QUAT,
+    MJA_CMD_XFRC_APPLIED,
+    MJA_CMD_QFRC_APPLIED,
+    MJA_CMD_RESET
+};
+
+MJA_API MjAccessPhysicsThread* mjaccess_physics_start(MjAccessData* data,
+                                                      const MjAccessPhysicsConfig* config);
+MJA_API void mjaccess_physics_stop(MjAccessPhysicsThread* pt);
+MJA_API int  mjaccess_physics_command(MjAccessPhysicsThread* pt, int type, int offset,
+                                      const double* values, int n);
+// Reader calls (one thread): latest fills the two held snapshots, valid until
+// the next latest/interpolate call, and returns 1 if a new one arrived.
+// interpolate writes the bound poses render_delay behind the newest
+// snapshot's extrapolated time. Rebinding transforms while running is unsafe.
+MJA_API int  mjaccess_physics_latest(MjAccessPhysicsThread* pt, MjAccessPhysicsFrame* prev,
+                                     MjAccessPhysicsFrame* cur);
+MJA_API int  mjaccess_physics_interpolate(MjAccessPhysicsThread* pt, MjAccessPose* out, int n);
+MJA_API void mjaccess_physics_lock(MjAccessPhysicsThread* pt);
+MJA_API void mjaccess_physics_unlock(MjAccessPhysicsThread* pt);
+// Pausing does not take the lock; the clock restarts from the current sim
+// time on resume, so a pause is never replayed.
+MJA_API void mjaccess_physics_set_paused(MjAccessPhysicsThread* pt, int paused);
+// First mjtWarning raised since start (the thread then stops stepping), or -1.
+MJA_API int  mjaccess_physics_error(const MjAccessPhysicsThread* pt);
+MJA_API long long mjaccess_physics_steps(const MjAccessPhysicsThread* pt);
+
 // ── Batched simulation ───────────────────────────────────────
 MJA_API MjAccessBatchedSim* mjaccess_batched_create(MjAccessModel* model,
                                                     const MjAccessBatchedConfig* config);
 MJA_API void mjaccess_batched_free(MjAccessBatchedSim* sim);
 MJA_API void mjaccess_batched_step(MjAccessBatchedSim* sim, const double* ctrl);
+// Frame-skip in one call: ctrl [num_envs * nu] is held for n_substeps steps.
+MJA_API void mjaccess_batched_step_n(MjAccessBatchedSim* sim, const double* ctrl,
+                                     int n_substeps);
+// Per-substep controls: ctrl_schedule is [num_envs][n_substeps][nu].
+MJA_API void mjaccess_batched_step_schedule(MjAccessBatchedSim* sim, const double* ctrl_schedule,
+                                            int n_substeps);
+
+// Asynchronous stepping. step_async stages ctrl (env_count * nu values for
+// envs [env_begin, env_begin + env_count)) and returns at once; a driver
+// thread steps that range on the worker pool. Until wait returns the caller
+// may only touch rows of envs outside the range (state, outputs, obs) -- e.g.
+// run inference on one half while the other half steps. Other batched calls
+// wait for the job first. is_busy polls without blocking. Returns 0 or -1.
+MJA_API int  mjaccess_batched_step_async(MjAccessBatchedSim* sim, const double* ctrl,
+                                         int n_substeps, int env_begin, int env_count);
+MJA_API void mjaccess_batched_wait(MjAccessBatchedSim* sim);
+MJA_API int  mjaccess_batched_is_busy(const MjAccessBatchedSim* sim);
+
+// reset restarts the masked envs from the model default (never the snapshot
+// pool), runs mj_forward and sets their reset flags.
 MJA_API void mjaccess_batched_reset(MjAccessBatchedSim* sim, const int* reset_mask);
+MJA_API int  mjaccess_batched_num_threads(const MjAccessBatchedSim* sim);
+MJA_API int  mjaccess_batched_is_contiguous(const MjAccessBatchedSim* sim);
 
-// Batched getters: double[num_envs * dim]
+// Batched getters: double[num_envs * dim]. Contiguous sims return the state
+// slabs themselves (stable for the sim's lifetime); otherwise each call
+// gathers into a per-field buffer.
+MJA_API const double* mjaccess_batched_get_field(const MjAccessBatchedSim* sim, int field,
+                                                 int* n_out);
 MJA_API const double* mjaccess_batched_get_qpos(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_qvel(const MjAccessBatchedSim* sim, int* n_out);
+MJA_API const double* mjaccess_batched_get_ctrl(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_xpos(const MjAccessBatchedSim* sim, int* n_out);
+MJA_API const double* mjaccess_batched_get_xquat(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_subtree_com(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_cinert(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_cvel(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_qfrc_actuator(const MjAccessBatchedSim* sim, int* n_out);
 MJA_API const double* mjaccess_batched_get_cfrc_ext(const MjAccessBatchedSim* sim, int* n_out);
+MJA_API const double* mjaccess_batched_get_sensordata(const MjAccessBatchedSim* sim, int* n_out);
+MJA_API const double* mjaccess_batched_get_geom_xpos(const MjAccessBatchedSim* sim, int* n_out);
+MJA_API const double* mjaccess_batched_get_geom_xmat(const MjAccessBatchedSim* sim, int* n_out);
+
+// Caller-owned output buffers. Once bound, the worker that steps (or resets)
+// an env copies that env's row of `field` into dst[env * dim]. dst must hold
+// num_envs * dim doubles and stay valid (pinned) until unbound; n is its
+// length. Binding NULL unbinds the field. Returns 0 on success, -1 on error.
+MJA_API int      mjaccess_batched_bind_output(MjAccessBatchedSim* sim, int field,
+                                              double* dst, int n);
+MJA_API void     mjaccess_batched_clear_outputs(MjAccessBatchedSim* sim);
+MJA_API unsigned mjaccess_batched_output_mask(const MjAccessBatchedSim* sim);
+
+// Initial-state snapshot pool. Snapshots use the mj_getState layout for the
+// pool's mjSTATE_* spec (default mjSTATE_INTEGRATION); setting a new spec
+// empties the pool and returns the per-snapshot size in doubles.
+MJA_API int  mjaccess_batched_snapshot_set_spec(MjAccessBatchedSim* sim, unsigned spec);
+MJA_API int  mjaccess_batched_snapshot_size(const MjAccessBatchedSim* sim);
+MJA_API int  mjaccess_batched_snapshot_count(const MjAccessBatchedSim* sim);
+MJA_API int  mjaccess_batched_snapshot_capture(MjAccessBatchedSim* sim, int env_idx);
+MJA_API int  mjaccess_batched_snapshot_add(MjAccessBatchedSim* sim, const double* states,
+                                           int n_states);
+MJA_API void mjaccess_batched_snapshot_clear(MjAccessBatchedSim* sim);
+
+// Auto-reset. Envs marked in done_mask are restarted by the workers during
+// the next step instead of being stepped: snapshot_index[i] picks a snapshot,
+// -1 (or a NULL array) picks one at random, and an empty pool falls back to
+// the model default. Restarted envs run mj_forward so getters and outputs
+// show the initial state; reset flags report which envs restarted.
+MJA_API void mjaccess_batched_set_auto_reset(MjAccessBatchedSim* sim,
+                                             const MjAccessAutoResetConfig* config);
+MJA_API void mjaccess_batched_set_done(MjAccessBatchedSim* sim, const int* done_mask,
+                                       const int* snapshot_index);
+MJA_API void mjaccess_batched_reset_to_snapshots(MjAccessBatchedSim* sim, const int* reset_mask,
+                                                 const int* snapshot_index);
+MJA_API const int* mjaccess_batched_get_reset_flags(const MjAccessBatchedSim* sim, int* n_out);
+
+// Observation plan. Terms are appended in order (by id, or by name through
+// mj_name2id) and compiled into coalesced copy runs. After every step or
+// reset the workers write each env's row of float[num_envs * obs_dim],
+// into an internal buffer or a caller-bound one (NULL rebinds internal).
+// obs_add and obs_clear change the row width and unbind a caller buffer, so
+// bind after the plan is complete. obs_add returns the term width, or -1 for
+// an unknown term/object.
+MJA_API void mjaccess_batched_obs_clear(MjAccessBatchedSim* sim);
+MJA_API int  mjaccess_batched_obs_add(MjAccessBatchedSim* sim, int term, int obj_id);
+MJA_API int  mjaccess_batched_obs_add_named(MjAccessBatchedSim* sim, int term, const char* name);
+MJA_API int  mjaccess_batched_obs_dim(const MjAccessBatchedSim* sim);
+MJA_API int  mjaccess_batched_bind_obs(MjAccessBatchedSim* sim, float* dst, int n);
+MJA_API const float* mjaccess_batched_get_obs(const MjAccessBatchedSim* sim, int* n_out);
+MJA_API void mjaccess_batched_obs_refresh(MjAccessBatchedSim* sim);
+
+// Running normalization. Observations: per-feature mean/variance, updated by
+// the workers during the gather of every step (auto-resets included) and
+// applied in place, so the obs tensor holds clip((x - mean) / sqrt(var + eps))
+// computed with the statistics as of the previous call (reset,
+// reset_to_snapshots and obs_refresh normalize without updating). Changing the observation plan disables it. Rewards: scaled by
+// the running std of the discounted return (done envs restart their return).
+// Frozen statistics are applied but not updated. get/set are for save/load;
+// obs_norm_get returns obs_dim (0 when disabled), arrays may be NULL.
+MJA_API int  mjaccess_batched_obs_norm_enable(MjAccessBatchedSim* sim,
+                                              const MjAccessNormConfig* config);
+MJA_API int  mjaccess_batched_obs_norm_get(const MjAccessBatchedSim* sim, double* mean,
+                                           double* var, double* count);
+MJA_API int  mjaccess_batched_obs_norm_set(MjAccessBatchedSim* sim, const double* mean,
+                                           const double* var, double count, int dim);
+MJA_API int  mjaccess_batched_reward_norm_enable(MjAccessBatchedSim* sim,
+                                                 const MjAccessNormConfig* config);
+MJA_API void mjaccess_batched_normalize_rewards(MjAccessBatchedSim* sim, float* rewards,
+                                                const int* dones);
+MJA_API void mjaccess_batched_reward_norm_get(const MjAccessBatchedSim* sim, double* stats3);
+MJA_API void mjaccess_batched_reward_norm_set(MjAccessBatchedSim* sim, const double* stats3);
+MJA_API void mjaccess_batched_norm_freeze(MjAccessBatchedSim* sim, int frozen);
+MJA_API void mjaccess_batched_norm_reset(MjAccessBatchedSim* sim);
+
+// Domain randomization. An enabled parameter gets a per-env copy of its model
+// array, initialized from the model; workers step each env against its own
+// row without touching the shared model. param_table returns the writable
+// [num_envs * dim] rows (edits apply from the next step). Terms are applied in
+// order to a fresh copy of the model's values whenever an env is resampled:
+// by randomize (NULL mask = all envs, run on the worker pool) and, with
+// rand_on_reset, by every reset, snapshot reset and auto-reset. Draws use one
+// stream per env, seeded by the auto-reset seed. rand_add enables the term's
+// parameter and returns the term index, or -1 for an invalid term.
+// A randomized body mass also gets per-env body_subtreemass sums, redone on
+// every resample and, once the mass table has been fetched, before every job.
+// body_inertia is not scaled with the mass, and the other compile-time
+// constants derived from it (body_invweight0, dof_invweight0, actuator_acc0)
+// keep the shared model's values: they only feed the constraint regularizer
+// (diagApprox) and compile-time actuator settings, which stay nominal.
+MJA_API int     mjaccess_batched_param_enable(MjAccessBatchedSim* sim, int param);
+MJA_API void    mjaccess_batched_param_disable(MjAccessBatchedSim* sim, int param);
+MJA_API double* mjaccess_batched_param_table(MjAccessBatchedSim* sim, int param, int* n_out);
+MJA_API int     mjaccess_batched_rand_add(MjAccessBatchedSim* sim, const MjAccessRandTerm* term);
+MJA_API void    mjaccess_batched_rand_clear(MjAccessBatchedSim* sim);
+MJA_API void    mjaccess_batched_rand_on_reset(MjAccessBatchedSim* sim, int enabled);
+MJA_API void    mjaccess_batched_randomize(MjAccessBatchedSim* sim, const int* env_mask);
+
+// Batched profiling. While enabled, workers time every env step and the
+// gather after it, harvest what MuJoCo's stage timers gained since the last
+// harvest (the timers are not cleared) and the solver counts, and accumulate
+// them per worker; get_profile sums the workers. worker_profile fills
+// busy/idle ms per worker (arrays of n, may be NULL) and returns the worker
+// count. Disabled profiling costs one branch per env.
+MJA_API int  mjaccess_batched_profile_enable(MjAccessBatchedSim* sim, int enabled);
+MJA_API void mjaccess_batched_get_profile(MjAccessBatchedSim* sim, MjAccessProfile* out);
+MJA_API int  mjaccess_batched_get_worker_profile(MjAccessBatchedSim* sim, double* busy_ms,
+                                                 double* idle_ms, int n);
+MJA_API void mjaccess_batched_profile_reset(MjAccessBatchedSim* sim);
+
+// Trajectory recording. Every step job becomes one frame: workers copy the
+// selected fields of each stepped env into a preallocated ring slot as the env
+// finishes, and a writer thread encodes and streams published frames to the
+// file (single producer, single consumer, no locks on the step path). An env's
+// episode counter advances on every reset and auto-reset. Partial async steps
+// record only their env range. record_stop drains the ring and closes the
+// file; it returns -1 if a write failed.
+MJA_API int  mjaccess_batched_record_start(MjAccessBatchedSim* sim, const char* path,
+                                           const MjAccessRecordConfig* config);
+MJA_API int  mjaccess_batched_record_stop(MjAccessBatchedSim* sim);
+MJA_API void mjaccess_batched_record_stats(const MjAccessBatchedSim* sim,
+                                           MjAccessRecordStats* out);
+
+// Recording reader. next decodes the following frame into rows
+// ([num_envs * row_bytes], only rows env_first..env_first+env_count-1 are
+// written) and returns 1, 0 at the end of the file or -1 on a corrupt file.
+MJA_API MjAccessRecordReader* mjaccess_record_open(const char* path, MjAccessRecordInfo* info);
+MJA_API int  mjaccess_record_next(MjAccessRecordReader* reader, void* rows, long long* frame,
+                                  int* env_first, int* env_count);
+MJA_API void mjaccess_record_close(MjAccessRecordReader* reader);
+
+// Instanced rendering. render_setup sorts the geoms whose group bit is set in
+// group_mask (0 = every group) and whose alpha is nonzero into batches that
+// share one mesh: a primitive type, or one mesh / hfield id. It returns the
+// batch count, or -1 on error. render_matrices writes, on the worker pool, a
+// Unity Matrix4x4 (column-major floats) for every batched geom of every env
+// in envs (NULL = envs 0..n_envs-1): the Unity-space geom frame, moved by the
+// env's grid cell (grid NULL = no offset), scaled to fit Unity's built-in
+// primitive meshes (plane, sphere, capsule, cylinder, cube). Mesh and hfield
+// batches are left unscaled and expect the compiled geometry in Unity axes.
+// Batch b occupies matrices [first * n_envs, (first + count) * n_envs),
+// grouped by env, so each batch is one instanced draw. n is out's capacity in
+// matrices. Returns the number written, or -1 on error or if out is too small.
+typedef struct {
+    int type;    // mjtGeom
+    int dataid;  // mesh or hfield id, -1 for primitives
+    int count;   // geoms per env
+    int first;   // geoms per env in the batches before this one
+} MjAccessRenderBatch;
+
+typedef struct {
+    int   columns;     // envs per grid row, 0 = ceil(sqrt(n_envs))
+    float spacing[2];  // Unity-space x and z distance between cells
+    float origin[3];   // Unity-space position of the first cell
+} MjAccessRenderGrid;
+
+MJA_API int mjaccess_batched_render_setup(MjAccessBatchedSim* sim, unsigned group_mask);
+MJA_API int mjaccess_batched_render_batches(const MjAccessBatchedSim* sim,
+                                            MjAccessRenderBatch* out, int n);
+// Geom ids of all batches in batch order; returns the total per env.
+MJA_API int mjaccess_batched_render_geoms(const MjAccessBatchedSim* sim, int* out, int n);
+MJA_API int mjaccess_batched_render_matrices(MjAccessBatchedSim* sim, const int* envs,
+                                             int n_envs, const MjAccessRenderGrid* grid,
+                                             float* out, int n);
+
+// Batched contacts. With a nonzero capacity the worker that steps (or resets)
+// an env packs its filtered contacts into the env's fixed block of
+// [num_envs * capacity] contacts and its count (clamped to capacity).
+// get_contacts returns the blocks, the counts and the capacity; both arrays
+// stay valid until the capacity changes. Capacity 0 turns the export off.
+MJA_API int mjaccess_batched_contact_filter(MjAccessBatchedSim* sim, int side, int objtype,
+                                            const int* ids, int n);
+MJA_API int mjaccess_batched_contact_capacity(MjAccessBatchedSim* sim, int capacity);
+MJA_API const MjAccessContact* mjaccess_batched_get_contacts(const MjAccessBatchedSim* sim,
+                                                             const int** counts, int* capacity);
 
 // Per-env setters
 MJA_API void mjaccess_batched_set_env_qpos(MjAccessBatchedSim* sim, int env_idx,
@@ -155,6 +819,55 @@ MJA_API void mjaccess_batched_set_env_qpos(MjAccessBatchedSim* sim, int env_idx,
 MJA_API void mjaccess_batched_set_env_qvel(MjAccessBatchedSim* sim, int env_idx,
                                            const double* qvel, int nv);
 
+// Scatter writes: one call stages values for an mjData array (an MJA_CMD_*
+// type other than RESET) across a list of envs. values is [n_envs][n_elems]
+// for the element indices in elems, or [n_envs][array size] when elems is
+// NULL. Writes apply on the worker pool at the start of the next step or
+// reset (sync, async or multi-model), in call order, to every listed env
+// whether or not that step advances it. A step's ctrl argument overwrites
+// mjData.ctrl for the envs it steps, so CTRL writes persist only for other
+// envs or when stepping with the sim's own contiguous ctrl buffer. Returns 0,
+// or -1 on a bad field, index or repeated env (nothing is staged).
+MJA_API int mjaccess_batched_scatter(MjAccessBatchedSim* sim, int field, const int* envs,
+                                     int n_envs, const int* elems, int n_elems,
+                                     const double* values);
+
+// Active envs. Steps (sync, async and multi-model) only visit active envs;
+// inactive ones keep their state, get no restart flag, and drop any pending
+// done flag. The mask persists until changed; NULL makes every env active.
+// Both setters return the active count, or -1 on error.
+MJA_API int mjaccess_batched_set_active(MjAccessBatchedSim* sim, const int* active_mask);
+MJA_API int mjaccess_batched_set_env_active(MjAccessBatchedSim* sim, int env_idx, int active);
+// Ascending active env indices: row k of an active gather is env list[k].
+MJA_API const int* mjaccess_batched_get_active(const MjAccessBatchedSim* sim, int* n_out);
+// Pack the active envs' rows of a field (or of the observation tensor) into
+// dst. Returns the row count, or -1 if n is smaller than rows * dim.
+MJA_API int mjaccess_batched_gather_active(MjAccessBatchedSim* sim, int field, double* dst, int n);
+MJA_API int mjaccess_batched_gather_obs_active(MjAccessBatchedSim* sim, float* dst, int n);
+
+// ── Multi-model batched simulation ───────────────────────────
+// Env groups built from different models, stepped in one parallel dispatch on
+// a shared pool. create takes the pool settings (num_threads, chunk_size,
+// pin_threads, cpu_offset) from config; add_group takes num_envs,
+// solver_iterations and contiguous_state and returns the group index.
+// Work is balanced with each group's measured step cost (group_cost, ns per
+// env substep). Groups are ordinary batched sims owned by the multi sim: use
+// their getters, outputs, observation plan, resets and randomization, but do
+// not free them or step them asynchronously.
+// multi_step ctrl holds every group's [num_envs * nu] block back to back;
+// ctrl_offset(group) is the start of a group's block (ngroups = total size).
+MJA_API MjAccessMultiSim*   mjaccess_multi_create(const MjAccessBatchedConfig* config);
+MJA_API void                mjaccess_multi_free(MjAccessMultiSim* ms);
+MJA_API int                 mjaccess_multi_add_group(MjAccessMultiSim* ms, MjAccessModel* model,
+                                                     const MjAccessBatchedConfig* config);
+MJA_API int                 mjaccess_multi_num_groups(const MjAccessMultiSim* ms);
+MJA_API int                 mjaccess_multi_num_threads(const MjAccessMultiSim* ms);
+MJA_API MjAccessBatchedSim* mjaccess_multi_group(MjAccessMultiSim* ms, int group);
+MJA_API int                 mjaccess_multi_ctrl_offset(const MjAccessMultiSim* ms, int group);
+MJA_API double              mjaccess_multi_group_cost(const MjAccessMultiSim* ms, int group);
+MJA_API void                mjaccess_multi_step(MjAccessMultiSim* ms, const double* ctrl,
+                                                int n_substeps);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,7 +11,7 @@ namespace Mujoco.Mjb
         private MjbBatchedSim _sim;
         private MjbModel _model;
         private readonly int _envIndex;
-        private readonly int _nq, _nv, _nu, _nbody, _njnt, _ngeom;
+        private readonly int _nq, _nv, _nu, _nbody, _njnt, _ngeom, _nsensordata;
         private double* _ctrlPtr;
         private bool _ownsCtrl;
         private bool _disposed;
@@ -26,6 +26,7 @@ namespace Mujoco.Mjb
             var info = model.Info;
             _nq = info.nq; _nv = info.nv; _nu = info.nu;
             _nbody = info.nbody; _njnt = info.njnt; _ngeom = info.ngeom;
+            _nsensordata = info.nsensordata;
 
             if (sharedCtrlPtr != null)
             {
@@ -50,6 +51,10 @@ namespace Mujoco.Mjb
         public int Nconmax => _model.Nconmax;
 
         public void Step() { }
+        public void Step(int nSubsteps) { }
+        public void StepAsync(int nSubsteps) { }
+        public void WaitStep() { }
+        public bool IsStepping => false;
         public void Forward() { }
         public void ResetData() { }
         public void RnePostConstraint() { }
@@ -69,19 +74,13 @@ namespace Mujoco.Mjb
         public void SetQpos(double[] qpos) => _sim.SetEnvQpos(_envIndex, qpos);
         public void SetQvel(double[] qvel) => _sim.SetEnvQvel(_envIndex, qvel);
 
-        public void SetQpos(int index, double value)
-        {
-            throw new NotSupportedException(
-                "Per-index SetQpos not supported on batched proxy. " +
-                "Build a double[] and use SetQpos(double[]).");
-        }
+        // Staged on the sim and applied before its next step, so after any
+        // whole-array SetQpos/SetQvel made in between.
+        public void SetQpos(int index, double value) =>
+            _sim.Scatter(MjbPhysicsCommand.Qpos, _envIndex, index, value);
 
-        public void SetQvel(int index, double value)
-        {
-            throw new NotSupportedException(
-                "Per-index SetQvel not supported on batched proxy. " +
-                "Build a double[] and use SetQvel(double[]).");
-        }
+        public void SetQvel(int index, double value) =>
+            _sim.Scatter(MjbPhysicsCommand.Qvel, _envIndex, index, value);
 
         public MjbDoubleSpan GetQpos() => Slice(_sim.GetQpos(), _envIndex * _nq, _nq);
         public MjbDoubleSpan GetQvel() => Slice(_sim.GetQvel(), _envIndex * _nv, _nv);
@@ -94,9 +93,9 @@ namespace Mujoco.Mjb
         public MjbDoubleSpan GetQfrcActuator() => Slice(_sim.GetQfrcActuator(), _envIndex * _nv, _nv);
         public MjbDoubleSpan GetCfrcExt() => Slice(_sim.GetCfrcExt(), _envIndex * _nbody * 6, _nbody * 6);
 
-        public MjbDoubleSpan GetGeomXpos() => default;
-        public MjbDoubleSpan GetGeomXmat() => default;
-        public MjbDoubleSpan GetSensordata() => default;
+        public MjbDoubleSpan GetGeomXpos() => Slice(_sim.GetGeomXpos(), _envIndex * _ngeom * 3, _ngeom * 3);
+        public MjbDoubleSpan GetGeomXmat() => Slice(_sim.GetGeomXmat(), _envIndex * _ngeom * 9, _ngeom * 9);
+        public MjbDoubleSpan GetSensordata() => Slice(_sim.GetSensordata(), _envIndex * _nsensordata, _nsensordata);
 
         public double BodyMass(int bodyId) => _model.BodyMass(bodyId);
         public int Name2Id(int objType, string name) => _model.Name2Id(objType, name);
@@ -18,6 +18,11 @@ namespace Mujoco.Mjb
 
         // ── Simulation ──────────────────────────────────────────────────
         void Step();
+        void Step(int nSubsteps);
+        // Start nSubsteps off the calling thread; state must not be touched until WaitStep.
+        void StepAsync(int nSubsteps);
+        void WaitStep();
+        bool IsStepping { get; }
         void Forward();
         void ResetData();
         void RnePostConstraint();
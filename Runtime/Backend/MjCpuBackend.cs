@@ -2,6 +2,7 @@
 // Apache-2.0 License
 
 using System;
+using System.Threading.Tasks;
 
 namespace Mujoco.Mjb
 {
@@ -12,6 +13,7 @@ namespace Mujoco.Mjb
         private readonly bool _ownsModel;
         private readonly bool _ownsData;
         private bool _disposed;
+        private Task _pendingStep;
 
         private readonly int _nq, _nv, _nu, _nbody, _njnt, _ngeom;
 
@@ -67,7 +69,26 @@ namespace Mujoco.Mjb
 
         public int Nconmax => _model.Nconmax;
 
-        public void Step() => _data.Step();
+        public void Step() { WaitStep(); _data.Step(); }
+        public void Step(int nSubsteps) { WaitStep(); _data.Step(nSubsteps); }
+
+        // A single mjData has nothing to split, so the whole step runs on a pool thread.
+        public void StepAsync(int nSubsteps)
+        {
+            WaitStep();
+            var data = _data;
+            _pendingStep = Task.Run(() => data.Step(nSubsteps));
+        }
+
+        public void WaitStep()
+        {
+            var pending = _pendingStep;
+            if (pending == null) return;
+            _pendingStep = null;
+            pending.GetAwaiter().GetResult();
+        }
+
+        public bool IsStepping => _pendingStep != null && !_pendingStep.IsCompleted;
         public void Forward() => _data.Forward();
         public void ResetData() => _data.ResetData();
         public void RnePostConstraint() => _data.RnePostConstraint();
@@ -106,6 +127,7 @@ namespace Mujoco.Mjb
         {
             if (_disposed) return;
             _disposed = true;
+            try { WaitStep(); } catch (Exception) { }
             if (_ownsData) _data?.Dispose();
             _data = null;
             if (_ownsModel) _model?.Dispose();
@@ -38,6 +38,29 @@ namespace Mujoco
         mjOBJ_MODEL = 102,
     }
 
+    [System.Flags]
+    public enum mjtState : uint
+    {
+        mjSTATE_TIME = 1 << 0,
+        mjSTATE_QPOS = 1 << 1,
+        mjSTATE_QVEL = 1 << 2,
+        mjSTATE_ACT = 1 << 3,
+        mjSTATE_WARMSTART = 1 << 4,
+        mjSTATE_CTRL = 1 << 5,
+        mjSTATE_QFRC_APPLIED = 1 << 6,
+        mjSTATE_XFRC_APPLIED = 1 << 7,
+        mjSTATE_EQ_ACTIVE = 1 << 8,
+        mjSTATE_MOCAP_POS = 1 << 9,
+        mjSTATE_MOCAP_QUAT = 1 << 10,
+        mjSTATE_USERDATA = 1 << 11,
+        mjSTATE_PLUGIN = 1 << 12,
+        mjSTATE_PHYSICS = mjSTATE_QPOS | mjSTATE_QVEL | mjSTATE_ACT | mjSTATE_PLUGIN,
+        mjSTATE_FULLPHYSICS = mjSTATE_TIME | mjSTATE_PHYSICS,
+        mjSTATE_USER = mjSTATE_CTRL | mjSTATE_QFRC_APPLIED | mjSTATE_XFRC_APPLIED |
+                       mjSTATE_EQ_ACTIVE | mjSTATE_MOCAP_POS | mjSTATE_MOCAP_QUAT | mjSTATE_USERDATA,
+        mjSTATE_INTEGRATION = mjSTATE_FULLPHYSICS | mjSTATE_USER | mjSTATE_WARMSTART,
+    }
+
     public enum mjtJoint : int
     {
         mjJNT_FREE = 0,
@@ -71,4 +94,24 @@ namespace Mujoco
         mjBIAS_MUSCLE = 2,
         mjBIAS_USER = 3,
     }
+
+    public enum mjtTimer : int
+    {
+        mjTIMER_STEP = 0,
+        mjTIMER_FORWARD = 1,
+        mjTIMER_INVERSE = 2,
+        mjTIMER_POSITION = 3,
+        mjTIMER_VELOCITY = 4,
+        mjTIMER_ACTUATION = 5,
+        mjTIMER_CONSTRAINT = 6,
+        mjTIMER_ADVANCE = 7,
+        mjTIMER_POS_KINEMATICS = 8,
+        mjTIMER_POS_INERTIA = 9,
+        mjTIMER_POS_COLLISION = 10,
+        mjTIMER_POS_MAKE = 11,
+        mjTIMER_POS_PROJECT = 12,
+        mjTIMER_COL_BROAD = 13,
+        mjTIMER_COL_NARROW = 14,
+        mjNTIMER = 15,
+    }
 }
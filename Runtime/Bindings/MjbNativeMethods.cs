@@ -21,6 +21,49 @@ namespace Mujoco.Mjb
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_free_model(IntPtr model);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_model_cache_set_dir(string dir);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_model_cache_get_stats(out MjbModelCacheStats stats);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_model_cache_reset_stats();
+
+        // Incremental scene edits
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_load_model_editable(string xmlString);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_model_is_editable(IntPtr model);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_spec_delete(IntPtr model, int objType, string name);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_spec_add_body(IntPtr model, string parent, string name,
+            double* pos3, double* quat4);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_spec_add_geom(IntPtr model, string body, string name,
+            int geomType, double* size3, double* pos3);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_spec_set_attr(IntPtr model, int objType, string name,
+            int attr, double* values, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_spec_recompile(IntPtr model, IntPtr data);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_model_reload(IntPtr model, IntPtr data, string xmlString,
+            double* oldQpos, double* oldQvel);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_model_reload_mapped(IntPtr model, IntPtr data,
+            string xmlString, double* oldQpos, double* oldQvel, string[] jointNames,
+            int* oldJointIds, int nJoints);
+
         // ── Model accessors ──────────────────────────────────────────────
 
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
@@ -85,6 +128,10 @@ namespace Mujoco.Mjb
         public static extern void mjaccess_model_set_hfield_data(IntPtr model, int offset,
             float* values, int n);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_model_set_hfield_rect(IntPtr model, int hfieldId, int row,
+            int col, int rows, int cols, float* values, int stride);
+
         // ── Data lifecycle ───────────────────────────────────────────────
 
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
@@ -101,6 +148,9 @@ namespace Mujoco.Mjb
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_step(IntPtr model, IntPtr data);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_step_n(IntPtr model, IntPtr data, int nSubsteps);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_forward(IntPtr model, IntPtr data);
 
@@ -237,6 +287,16 @@ namespace Mujoco.Mjb
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern int mjaccess_get_warning_count(IntPtr data, int index);
 
+        // Profiling
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_profile_timers(int enabled);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_get_profile(IntPtr data, MjbProfile* profile);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_reset_profile(IntPtr data);
+
         // Model I/O
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern int mjaccess_save_last_xml(IntPtr model, string path,
@@ -261,18 +321,48 @@ namespace Mujoco.Mjb
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_batched_step(IntPtr sim, double* ctrl);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_step_n(IntPtr sim, double* ctrl, int nSubsteps);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_step_schedule(IntPtr sim, double* ctrlSchedule, int nSubsteps);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_step_async(IntPtr sim, double* ctrl, int nSubsteps, int envBegin, int envCount);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_wait(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_is_busy(IntPtr sim);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_batched_reset(IntPtr sim, int* resetMask);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_num_threads(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_is_contiguous(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_get_field(IntPtr sim, int field, int* nOut);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern double* mjaccess_batched_get_qpos(IntPtr sim, int* nOut);
 
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern double* mjaccess_batched_get_qvel(IntPtr sim, int* nOut);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_get_ctrl(IntPtr sim, int* nOut);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern double* mjaccess_batched_get_xpos(IntPtr sim, int* nOut);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_get_xquat(IntPtr sim, int* nOut);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern double* mjaccess_batched_get_subtree_com(IntPtr sim, int* nOut);
 
@@ -288,10 +378,384 @@ namespace Mujoco.Mjb
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern double* mjaccess_batched_get_cfrc_ext(IntPtr sim, int* nOut);
 
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_get_sensordata(IntPtr sim, int* nOut);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_get_geom_xpos(IntPtr sim, int* nOut);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_get_geom_xmat(IntPtr sim, int* nOut);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_bind_output(IntPtr sim, int field, double* dst, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_clear_outputs(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern uint mjaccess_batched_output_mask(IntPtr sim);
+
+        // Snapshot pool and auto-reset
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_snapshot_set_spec(IntPtr sim, uint spec);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_snapshot_size(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_snapshot_count(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_snapshot_capture(IntPtr sim, int envIdx);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_snapshot_add(IntPtr sim, double* states, int nStates);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_snapshot_clear(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_set_auto_reset(IntPtr sim, ref MjbAutoResetConfig config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_set_done(IntPtr sim, int* doneMask, int* snapshotIndex);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_reset_to_snapshots(IntPtr sim, int* resetMask, int* snapshotIndex);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int* mjaccess_batched_get_reset_flags(IntPtr sim, int* nOut);
+
+        // Observation plan
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_obs_clear(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_obs_add(IntPtr sim, int term, int objId);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_obs_add_named(IntPtr sim, int term, string name);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_obs_dim(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_bind_obs(IntPtr sim, float* dst, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern float* mjaccess_batched_get_obs(IntPtr sim, int* nOut);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_obs_refresh(IntPtr sim);
+
+        // Running normalization
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_obs_norm_enable(IntPtr sim, MjbNormConfig* config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_obs_norm_get(IntPtr sim, double* mean, double* var, double* count);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_obs_norm_set(IntPtr sim, double* mean, double* var, double count, int dim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_reward_norm_enable(IntPtr sim, MjbNormConfig* config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_normalize_rewards(IntPtr sim, float* rewards, int* dones);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_reward_norm_get(IntPtr sim, double* stats3);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_reward_norm_set(IntPtr sim, double* stats3);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_norm_freeze(IntPtr sim, int frozen);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_norm_reset(IntPtr sim);
+
+        // Domain randomization
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_param_enable(IntPtr sim, int param);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_param_disable(IntPtr sim, int param);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_batched_param_table(IntPtr sim, int param, int* nOut);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_rand_add(IntPtr sim, MjbRandTerm* term);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_rand_clear(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_rand_on_reset(IntPtr sim, int enabled);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_randomize(IntPtr sim, int* envMask);
+
+        // Batched profiling
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_profile_enable(IntPtr sim, int enabled);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_get_profile(IntPtr sim, MjbProfile* profile);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_get_worker_profile(IntPtr sim, double* busyMs, double* idleMs, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_profile_reset(IntPtr sim);
+
+        // Bulk transforms
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_bind_transforms(IntPtr data, int* objtypes, int* ids, float* offsets, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_export_transforms(IntPtr data, MjbPose* poses, int n);
+
+        // Derivatives
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_transition_fd_threads(IntPtr data, int numThreads);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_transition_fd(IntPtr model, IntPtr data, double eps, int centered,
+            double* A, double* B, double* C, double* D);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_transition_fd(IntPtr sim, double eps, int centered,
+            double* A, double* B, double* C, double* D);
+
+        // Rollouts
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_state_size(IntPtr model, uint spec);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_get_state(IntPtr data, uint spec, double* state);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_set_state(IntPtr data, uint spec, double* state);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_rollout_create(IntPtr model, ref MjbRolloutConfig config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_rollout_free(IntPtr ro);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_rollout_num_threads(IntPtr ro);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_rollout_state_size(IntPtr ro, out int outSize);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_rollout_set_cost(IntPtr ro, MjbRolloutCost* cost);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_rollout(IntPtr ro, double* startState, int nroll, int horizon,
+            double* ctrl, double* outStates, double* outSensors, double* outCosts);
+
+        // Contacts
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_contact_filter(IntPtr data, int side, int objtype, int* ids, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_export_contacts(IntPtr data, MjbContact* contacts, int capacity);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_contact_filter(IntPtr sim, int side, int objtype, int* ids, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_contact_capacity(IntPtr sim, int capacity);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern MjbContact* mjaccess_batched_get_contacts(IntPtr sim, int** counts, int* capacity);
+
+        // Kinematic playback
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_traj_open(string path);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_traj_close(IntPtr traj);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long mjaccess_traj_num_frames(IntPtr traj);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_traj_nq(IntPtr traj);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double mjaccess_traj_time(IntPtr traj, long frame);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double* mjaccess_traj_frame(IntPtr traj, long frame);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double mjaccess_traj_locate(IntPtr traj, double time);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_traj_apply(IntPtr traj, IntPtr model, IntPtr data, double frame);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_traj_writer_open(string path, int nq);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_traj_writer_add(IntPtr writer, double time, double* qpos);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_traj_writer_close(IntPtr writer);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_record_export_traj(string recordPath, int env, string trajPath, double dt);
+
+        // Terrain paging
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_terrain_create(IntPtr model, ref MjbTerrainConfig config, string path);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_terrain_free(IntPtr terrain);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern float* mjaccess_terrain_world(IntPtr terrain, int* rows, int* cols);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_terrain_window(IntPtr terrain, int* row, int* col);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_terrain_center(IntPtr terrain, double x, double y);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_terrain_update(IntPtr terrain, IntPtr data);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_terrain_refresh(IntPtr terrain);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_terrain_write(IntPtr terrain, int row, int col, int rows, int cols,
+            float* values, int stride);
+
+        // Physics thread
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_physics_start(IntPtr data, ref MjbPhysicsConfig config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_physics_stop(IntPtr pt);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_physics_command(IntPtr pt, int type, int offset, double* values, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_physics_latest(IntPtr pt, MjbPhysicsFrame* prev, MjbPhysicsFrame* cur);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_physics_interpolate(IntPtr pt, MjbPose* output, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_physics_lock(IntPtr pt);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_physics_unlock(IntPtr pt);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_physics_set_paused(IntPtr pt, int paused);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_physics_error(IntPtr pt);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern long mjaccess_physics_steps(IntPtr pt);
+
+        // Trajectory recording
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_record_start(IntPtr sim, string path, ref MjbRecordConfig config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_record_stop(IntPtr sim);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_batched_record_stats(IntPtr sim, out MjbRecordStats stats);
+
+        // Instanced rendering
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_render_setup(IntPtr sim, uint groupMask);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_render_batches(IntPtr sim, MjbRenderBatch* batches, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_render_geoms(IntPtr sim, int* geoms, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_render_matrices(IntPtr sim, int* envs, int nEnvs,
+            MjbRenderGrid* grid, float* matrices, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_record_open(string path, out MjbRecordInfo info);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_record_next(IntPtr reader, void* rows, out long frame,
+            out int envFirst, out int envCount);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_record_close(IntPtr reader);
+
+        // Multi-model batched simulation
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_multi_create(ref MjbBatchedConfig config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_multi_free(IntPtr ms);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_multi_add_group(IntPtr ms, IntPtr model, ref MjbBatchedConfig config);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_multi_num_groups(IntPtr ms);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_multi_num_threads(IntPtr ms);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr mjaccess_multi_group(IntPtr ms, int group);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_multi_ctrl_offset(IntPtr ms, int group);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern double mjaccess_multi_group_cost(IntPtr ms, int group);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void mjaccess_multi_step(IntPtr ms, double* ctrl, int nSubsteps);
+
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_batched_set_env_qpos(IntPtr sim, int envIdx, double* qpos, int nq);
 
         [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
         public static extern void mjaccess_batched_set_env_qvel(IntPtr sim, int envIdx, double* qvel, int nv);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_scatter(IntPtr sim, int field, int* envs, int nEnvs,
+            int* elems, int nElems, double* values);
+
+        // Active envs
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_set_active(IntPtr sim, int* activeMask);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_set_env_active(IntPtr sim, int envIdx, int active);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int* mjaccess_batched_get_active(IntPtr sim, int* nOut);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_gather_active(IntPtr sim, int field, double* dst, int n);
+
+        [DllImport(LibName, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int mjaccess_batched_gather_obs_active(IntPtr sim, float* dst, int n);
     }
 }
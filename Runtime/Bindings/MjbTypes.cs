@@ -21,6 +21,56 @@ namespace Mujoco.Mjb
         public int nsensor;
         public int nsensordata;
         public int neq;
+        public int na;
+    }
+
+    /// <summary>Spec attributes editable in place (mirrors MjAccessSpecAttr).</summary>
+    public enum MjbSpecAttr : int
+    {
+        Pos = 0,    // body/geom/site: 3
+        Quat,       // body/geom/site: 4
+        Size,       // geom/site: 3
+        Mass,       // body/geom: 1
+        Friction,   // geom: 3
+        Rgba,       // geom/site: 4
+    }
+
+    /// <summary>Step profile (mirrors MjAccessProfile). Stage arrays are indexed by mjtTimer.</summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbProfile
+    {
+        public const int StageCount = 16;
+        public const int BinCount = 24;
+
+        public long jobs;          // batched step dispatches
+        public long envSteps;      // mj_step calls
+        public double wallMs;      // caller time inside those dispatches
+        public double stepMs;      // summed over envs and workers
+        public double gatherMs;    // output and observation writes
+        public fixed double stageMs[StageCount];
+        public fixed long stageCalls[StageCount];
+        public long contacts;      // summed after each step
+        public long constraints;
+        public long solverIters;
+        public int maxContacts;
+        public int maxConstraints;
+        public fixed long stepHist[BinCount];  // bin 0 < 1 us, bin k in [2^(k-1), 2^k) us
+
+        public double GetStageMs(mjtTimer timer) => stageMs[(int)timer];
+        public long GetStageCalls(mjtTimer timer) => stageCalls[(int)timer];
+        public long GetHistogramBin(int bin) => stepHist[bin];
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbModelCacheStats
+    {
+        public long hits;
+        public long misses;
+        public long stores;
+        public double compileMs;  // total time in the XML compiler
+        public double loadMs;     // total time loading cached binaries
+
+        public double HitRate => hits + misses > 0 ? (double)hits / (hits + misses) : 0.0;
     }
 
     [StructLayout(LayoutKind.Sequential)]
@@ -28,6 +78,291 @@ namespace Mujoco.Mjb
     {
         public int numEnvs;
         public int solverIterations;
+        public int numThreads;   // 0 = one per online CPU
+        public int chunkSize;    // 0 = auto
+        public int pinThreads;   // nonzero = pin workers to CPUs (Linux/Android)
+        public int cpuOffset;
+        public int contiguousState;  // nonzero = state slabs, zero-copy batched getters
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbAutoResetConfig
+    {
+        public ulong seed;            // snapshot selection RNG, one stream per env
+        public int detectBadState;    // restart envs that hit NaN/inf or BADQPOS/BADQVEL/BADQACC
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbNormConfig
+    {
+        public float clip;     // clamp normalized values to [-clip, clip], 0 = no clipping
+        public float epsilon;  // added to the variance, 0 = 1e-8
+        public float gamma;    // rewards: discount of the running return, 0 = 0.99
+    }
+
+    /// <summary>Per-env fields held by a batched sim (mirrors MjAccessField).</summary>
+    public enum MjbBatchedField : int
+    {
+        Qpos = 0,
+        Qvel,
+        Ctrl,
+        Xpos,
+        Xquat,
+        SubtreeCom,
+        Cinert,
+        Cvel,
+        QfrcActuator,
+        CfrcExt,
+        Sensordata,
+        GeomXpos,
+        GeomXmat,
+    }
+
+    /// <summary>Observation plan terms (mirrors MjAccessObsTerm).</summary>
+    public enum MjbObsTerm : int
+    {
+        JointQpos = 0,     // 7 free, 4 ball, 1 hinge/slide
+        JointQvel,         // 6 free, 3 ball, 1 hinge/slide
+        ActuatorCtrl,      // 1
+        BodyXpos,          // 3
+        BodyXquat,         // 4
+        BodyCvel,          // 6
+        BodySubtreeCom,    // 3
+        BodyCfrcExt,       // 6
+        SiteXpos,          // 3
+        GeomXpos,          // 3
+        Sensor,            // sensor_dim
+    }
+
+    /// <summary>Model arrays that can be overridden per env (mirrors MjAccessParam).</summary>
+    public enum MjbParam : int
+    {
+        BodyMass = 0,      // nbody x 1
+        GeomFriction,      // ngeom x 3
+        DofDamping,        // nv x 1
+        ActuatorGainprm,   // nu x 10
+    }
+
+    public enum MjbDistribution : int
+    {
+        Uniform = 0,   // [a, b]
+        LogUniform,    // [a, b], both > 0
+        Gaussian,      // mean a, stddev b
+    }
+
+    public enum MjbRandOp : int
+    {
+        Scale = 0,  // value *= sample
+        Add,        // value += sample
+        Set,        // value = sample
+    }
+
+    /// <summary>One domain randomization term (mirrors MjAccessRandTerm).</summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbRandTerm
+    {
+        public MjbParam param;
+        public int obj;        // object id, -1 = all
+        public int component;  // column within the object, -1 = all
+        public MjbDistribution dist;
+        public MjbRandOp op;
+        public int shared;     // nonzero = one draw for every selected element
+        public double a;
+        public double b;
+    }
+
+    /// <summary>
+    /// Unity-space frame pose (mirrors MjAccessPose), laid out as a Vector3 position
+    /// followed by a Quaternion rotation (x, y, z, w).
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbPose
+    {
+        public float px, py, pz;
+        public float qx, qy, qz, qw;
+    }
+
+    /// <summary>Trajectory recording options (mirrors MjAccessRecordFlags).</summary>
+    [Flags]
+    public enum MjbRecordFlags : int
+    {
+        None = 0,
+        Float32 = 1,   // store fields as float instead of double
+        Delta = 2,     // XOR each row with the env's previous recorded row
+        Compress = 4,  // byte-shuffle + zero-run coding per frame
+        Drop = 8,      // drop frames instead of stalling when the writer falls behind
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbRecordConfig
+    {
+        public uint fieldMask;    // bits of MjbBatchedField, 0 = qpos | qvel | ctrl | sensordata
+        public int ringFrames;    // frames buffered ahead of the writer, 0 = 16
+        public int chunkFrames;   // max frames per file chunk, 0 = 8
+        public MjbRecordFlags flags;
+
+        public static uint Mask(params MjbBatchedField[] fields)
+        {
+            uint mask = 0;
+            foreach (var f in fields) mask |= 1u << (int)f;
+            return mask;
+        }
+    }
+
+    /// <summary>
+    /// Recording file header (mirrors MjAccessRecordInfo). A decoded row is int32 episode,
+    /// int32 step within the episode, then the recorded fields in MjbBatchedField order.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbRecordInfo
+    {
+        public const int FieldCount = 13;
+
+        public int version;
+        public int numEnvs;
+        public uint fieldMask;
+        public MjbRecordFlags flags;
+        public int elemSize;      // 8 = double, 4 = float
+        public int rowBytes;
+        public fixed int dims[FieldCount];
+
+        public int GetDim(MjbBatchedField field) => dims[(int)field];
+
+        /// <summary>Byte offset of a field within a row, or -1 if it was not recorded.</summary>
+        public int GetFieldOffset(MjbBatchedField field)
+        {
+            if ((fieldMask & (1u << (int)field)) == 0) return -1;
+            int offset = 2 * sizeof(int);
+            for (int f = 0; f < (int)field; f++)
+                if ((fieldMask & (1u << f)) != 0) offset += dims[f] * elemSize;
+            return offset;
+        }
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbRecordStats
+    {
+        public long frames;        // step jobs offered to the recorder
+        public long dropped;       // frames skipped under MjbRecordFlags.Drop
+        public long bytesRaw;      // row bytes handed to the writer
+        public long bytesWritten;  // file bytes, headers included
+        public double stallMs;     // time the stepping thread waited on the writer
+        public int ioError;        // nonzero once a write failed
+    }
+
+    /// <summary>
+    /// One contact in the MuJoCo world frame (mirrors MjAccessContact). frame rows are the
+    /// normal (geom0 to geom1) and two tangents; force is mj_contactForce in that frame.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbContact
+    {
+        public int geom0, geom1;
+        public int body0, body1;
+        public double dist;
+        public fixed double pos[3];
+        public fixed double frame[9];
+        public fixed double force[6];
+    }
+
+    /// <summary>Terrain pager setup (mirrors MjAccessTerrainConfig).</summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbTerrainConfig
+    {
+        public int hfieldId;
+        public int geomId;          // -1 = the first geom using hfieldId
+        public int rows, cols;      // world heightmap size in cells
+        public fixed double origin[2];  // world x, y of cell (0, 0)
+        public int tile;            // recenter granularity in cells, 0 = 16
+        public int trackBody;       // body followed by Update, -1 = none
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbPhysicsConfig
+    {
+        public double speed;        // sim seconds per wall second, 0 = 1
+        public double maxLag;       // sim seconds of backlog before time is dropped, 0 = 0.1
+        public double renderDelay;  // interpolation delay, 0 = one timestep
+    }
+
+    /// <summary>
+    /// A physics-thread snapshot (mirrors MjAccessPhysicsFrame); the pointers stay valid
+    /// until the next Latest/Interpolate call.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbPhysicsFrame
+    {
+        public double time;
+        public long step;
+        public MjbPose* poses;        // [bound transforms]
+        public double* sensordata;    // [nsensordata]
+    }
+
+    /// <summary>Physics-thread command targets (mirrors MJA_CMD_*).</summary>
+    public enum MjbPhysicsCommand : int
+    {
+        Ctrl = 0,
+        Qpos,
+        Qvel,
+        Act,
+        MocapPos,
+        MocapQuat,
+        XfrcApplied,
+        QfrcApplied,
+        Reset,  // offset = keyframe, -1 = model defaults
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbRolloutConfig
+    {
+        public mjtState startSpec;  // layout of start states, 0 = mjSTATE_INTEGRATION
+        public mjtState outSpec;    // layout of recorded states, 0 = mjSTATE_FULLPHYSICS
+        public int numThreads;      // 0 = one per online CPU
+    }
+
+    /// <summary>Diagonal quadratic rollout cost (mirrors MjAccessRolloutCost).</summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbRolloutCost
+    {
+        public double* qposRef;       // [nq], null = qpos0
+        public double* qposWeight;    // [nv] on the tangent-space qpos error, null = off
+        public double* qvelRef;       // [nv], null = 0
+        public double* qvelWeight;    // [nv]
+        public double* ctrlRef;       // [nu]
+        public double* ctrlWeight;    // [nu]
+        public double* sensorRef;     // [nsensordata]
+        public double* sensorWeight;  // [nsensordata]
+        public double terminal;       // last step's state and sensor terms count (1 + terminal) times
+    }
+
+    /// <summary>
+    /// Geoms drawn with one mesh (mirrors MjAccessRenderBatch): a primitive type, or one
+    /// mesh / hfield. Its matrices start at <c>first * numEnvs</c>, grouped by env.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MjbRenderBatch
+    {
+        public int type;    // mjtGeom
+        public int dataid;  // mesh or hfield id, -1 for primitives
+        public int count;   // geoms per env
+        public int first;   // geoms per env in the batches before this one
+    }
+
+    /// <summary>Unity-space layout of rendered envs (mirrors MjAccessRenderGrid).</summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct MjbRenderGrid
+    {
+        public int columns;          // envs per grid row, 0 = ceil(sqrt(numEnvs))
+        public fixed float spacing[2];
+        public fixed float origin[3];
+
+        public static MjbRenderGrid Create(int columns, float spacingX, float spacingZ)
+        {
+            var grid = new MjbRenderGrid { columns = columns };
+            grid.spacing[0] = spacingX;
+            grid.spacing[1] = spacingZ;
+            return grid;
+        }
     }
 
     public unsafe struct MjbDoubleSpan
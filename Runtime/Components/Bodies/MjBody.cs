@@ -45,5 +45,12 @@ namespace Mujoco {
       transform.position = MjEngineTool.UnityVector3AtEntry(data.GetXpos(), MujocoId);
       transform.rotation = MjEngineTool.UnityQuaternionAtEntry(data.GetXquat(), MujocoId);
     }
+
+    public override bool GetSyncFrame(out mjtObj objectType, out MjTransformation offset) {
+      base.GetSyncFrame(out objectType, out offset);
+      if (OverridesSyncState(typeof(MjBody))) return false;
+      objectType = mjtObj.mjOBJ_BODY;
+      return true;
+    }
   }
 }
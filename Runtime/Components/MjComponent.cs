@@ -57,6 +57,22 @@ public abstract class MjComponent : MonoBehaviour {
 
   public virtual void OnSyncState(MjbData data) {}
 
+  // Components whose OnSyncState only copies a MuJoCo frame into their
+  // transform report the frame here (and a local offset composed on its
+  // right); MjScene then updates all of them with one native export and one
+  // transform job instead of calling OnSyncState.
+  public virtual bool GetSyncFrame(out mjtObj objectType, out MjTransformation offset) {
+    objectType = mjtObj.mjOBJ_UNKNOWN;
+    offset = new MjTransformation(Vector3.zero, Quaternion.identity);
+    return false;
+  }
+
+  // True if a subclass below `type` replaces its OnSyncState, which then has
+  // to keep being called.
+  protected bool OverridesSyncState(Type type) {
+    return GetType().GetMethod(nameof(OnSyncState)).DeclaringType != type;
+  }
+
   private bool _sceneExcludesMe = false;
 
   protected virtual void OnEnable() {
@@ -318,6 +318,18 @@ public class MjGlobalSettings : MonoBehaviour {
   [Tooltip("If false, numerical suffixes will be aded to ensure name uniqueness.")]
   public bool UseRawGameObjectNames;
 
+  [Tooltip("Cache compiled models under the temporary cache path to skip the XML compiler. " +
+           "The key covers the scene XML only: clear the cache after editing meshes, " +
+           "textures or heightfields. Entries are never evicted.")]
+  public bool UseModelCache;
+
+  [Tooltip("Collect MuJoCo's per-stage step timers (MjScene.LastStepProfile, Profiler counters).")]
+  public bool ProfileNativeStages;
+
+  [Tooltip("Step MjScene on a native thread paced to wall time and interpolate poses for " +
+           "rendering. Ignored when a ctrlCallback is registered or threads are unavailable.")]
+  public bool BackgroundPhysics;
+
   public MjOptionStruct GlobalOptions = MjOptionStruct.Default;
 
   public MjSizeStruct GlobalSizes = MjSizeStruct.Default;
@@ -22,7 +22,11 @@ using System.Linq;
 using System.Runtime.InteropServices;
 using System.Text;
 using System.Xml;
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+using Unity.Jobs;
 using UnityEngine;
+using UnityEngine.Jobs;
 using Debug = UnityEngine.Debug;
 using UnityEngine.Profiling;
 using Mujoco.Mjb;
@@ -43,6 +47,42 @@ public class MjScene : MonoBehaviour {
 
   public IMjPhysicsBackend PhysicsBackend => _backend;
 
+  // Stage timers of the last StepScene, collected when
+  // MjGlobalSettings.ProfileNativeStages is set.
+  public MjbProfile LastStepProfile { get; private set; }
+
+  // Raised with every collected profile. The optional Mujoco.Runtime.Profiling
+  // assembly (built when com.unity.profiling.core is installed) feeds it to
+  // Profiler counters.
+  public static event Action<MjbProfile> stepProfiled;
+
+  private bool _profiling;
+
+  // Bulk transform sync: bodies, geoms and sites whose OnSyncState only copies
+  // their MuJoCo frame are bound natively and posed by one export and one
+  // transform job; the rest still get OnSyncState. Transforms are in BFS
+  // order, so parents are written before their children.
+  private List<MjComponent> _syncComponents = new List<MjComponent>();
+  private List<MjComponent> _stateComponents = new List<MjComponent>();
+  private TransformAccessArray _syncTransforms;
+  private NativeArray<MjbPose> _syncPoses;
+  private NativeArray<byte> _syncEnabled;
+
+  // Kinematic playback: while a trajectory is loaded, FixedUpdate advances the
+  // playback clock instead of stepping and each frame is posed with
+  // mj_kinematics only, reading qpos straight from the mapped file.
+  public MjbTrajectory Playback { get; private set; }
+  public double PlaybackTime { get; private set; }
+  public float PlaybackSpeed = 1.0f;
+  public bool PlaybackLoop = false;
+
+  // Background physics (MjGlobalSettings.BackgroundPhysics): a native thread
+  // steps Data paced to wall time. FixedUpdate then only runs the update events
+  // and OnSyncState under its lock, and Update poses the bound transforms from
+  // snapshots interpolated between the last two steps.
+  public MjbPhysicsThread PhysicsThread { get; private set; }
+  private bool _physicsThreadUnavailable;
+
   public MjcfGenerationContext GenerationContext {
     get {
       if (_generationContext == null) {
@@ -105,14 +145,69 @@ public class MjScene : MonoBehaviour {
   public bool PauseSimulation = false;
 
   protected void FixedUpdate() {
+    if (PhysicsThread != null) PhysicsThread.Paused = PauseSimulation;
     if (PauseSimulation) return;
+    if (Playback != null) {
+      AdvancePlayback(Time.fixedDeltaTime * PlaybackSpeed);
+      return;
+    }
+    if (UseBackgroundPhysics()) {
+      UpdateBackgroundPhysics();
+      return;
+    }
+    StopPhysicsThread();
     preUpdateEvent?.Invoke(this, new MjStepArgs(Model, Data));
     StepScene();
     postUpdateEvent?.Invoke(this, new MjStepArgs(Model, Data));
   }
 
+  protected void Update() {
+    if (PhysicsThread != null) SyncTransforms();
+  }
+
+  private bool UseBackgroundPhysics() {
+    var settings = MjGlobalSettings.Instance;
+    if (settings == null || !settings.BackgroundPhysics || ctrlCallback != null ||
+        Model == null || Data == null) {
+      return false;
+    }
+    if (PhysicsThread != null) return true;
+    if (_physicsThreadUnavailable) return false;
+    try {
+      var config = new MjbPhysicsConfig { speed = Time.timeScale > 0 ? Time.timeScale : 1 };
+      PhysicsThread = new MjbPhysicsThread(Data, config);
+    } catch (PlatformNotSupportedException e) {
+      Debug.LogWarning($"MjScene: {e.Message}; stepping on the main thread.");
+      _physicsThreadUnavailable = true;
+      return false;
+    }
+    return true;
+  }
+
+  private void UpdateBackgroundPhysics() {
+    if (PhysicsThread.Error >= 0) {
+      StopPhysicsThread();
+      CheckForPhysicsException();
+      return;
+    }
+    using (PhysicsThread.Lock()) {
+      preUpdateEvent?.Invoke(this, new MjStepArgs(Model, Data));
+      if (_profiling) CollectStepProfile();
+      SyncStateComponents();
+      postUpdateEvent?.Invoke(this, new MjStepArgs(Model, Data));
+    }
+  }
+
+  // Joins the physics thread, handing Data back to the main thread; the next
+  // FixedUpdate restarts it from the current state.
+  public void StopPhysicsThread() {
+    PhysicsThread?.Dispose();
+    PhysicsThread = null;
+  }
+
   public void ResetData() {
     if (Model == null || Data == null) return;
+    StopPhysicsThread();
     Data.ResetData();
     _backend?.ResetData();
     Data.Forward();
@@ -133,6 +228,15 @@ public class MjScene : MonoBehaviour {
   private MjcfGenerationContext _generationContext;
 
   public XmlDocument CreateScene(bool skipCompile=false) {
+    var sceneMjcf = GenerateScene();
+    if (!skipCompile) {
+      CompileScene(sceneMjcf, _orderedComponents);
+    }
+    postInitEvent?.Invoke(this, new MjStepArgs(Model, Data));
+    return sceneMjcf;
+  }
+
+  private XmlDocument GenerateScene() {
     if (_generationContext != null) {
       throw new InvalidOperationException(
           "The scene is currently being generated on another thread.");
@@ -167,16 +271,17 @@ public class MjScene : MonoBehaviour {
       SaveToFile(sceneMjcf, Path.Combine(Application.temporaryCachePath, settings.DebugFileName));
     }
 
-    if (!skipCompile) {
-      CompileScene(sceneMjcf, _orderedComponents);
-    }
-    postInitEvent?.Invoke(this, new MjStepArgs(Model, Data));
     return sceneMjcf;
   }
 
   private void CompileScene(
       XmlDocument mjcf, IEnumerable<MjComponent> components) {
-    Model = MjbModel.LoadFromString(mjcf.OuterXml);
+    UseModelCache(true);
+    try {
+      Model = MjbModel.LoadFromString(mjcf.OuterXml);
+    } finally {
+      UseModelCache(false);
+    }
     if (Model == null) {
       throw new NullReferenceException("Model loading failed, see other errors for root cause.");
     }
@@ -184,7 +289,18 @@ public class MjScene : MonoBehaviour {
     if (Data == null) {
       throw new NullReferenceException("Model loaded but MakeData failed.");
     }
+    BindScene(components);
+  }
+
+  // The cache directory is process-wide: it is set only around the scene's own
+  // loads so other loaders (the MJCF importer saves the last XML) compile.
+  private static void UseModelCache(bool on) {
+    var settings = MjGlobalSettings.Instance;
+    MjbModel.SetCacheDirectory(on && settings != null && settings.UseModelCache
+        ? Path.Combine(Application.temporaryCachePath, "MjModelCache") : null);
+  }
 
+  private void BindScene(IEnumerable<MjComponent> components) {
     _lastWarningCounts = null;
 
     double mjTimestep = Model.Timestep;
@@ -199,88 +315,168 @@ public class MjScene : MonoBehaviour {
     }
 
     _backend = new MjCpuBackend(Model, Data);
+    BindTransformSync(components);
+
+    var settings = MjGlobalSettings.Instance;
+    SetProfiling(settings != null && settings.ProfileNativeStages);
+  }
+
+  private void SetProfiling(bool enabled) {
+    if (enabled == _profiling) return;
+    MjbData.EnableTimers(enabled);
+    _profiling = enabled;
+    if (enabled) Data?.ResetProfile();
+  }
+
+  private void CollectStepProfile() {
+    var profile = Data.GetProfile();
+    Data.ResetProfile();
+    LastStepProfile = profile;
+    stepProfiled?.Invoke(profile);
   }
 
   public void SyncUnityToMjState() {
-    foreach (var component in _orderedComponents) {
+    SyncTransforms();
+    if (PhysicsThread != null) {
+      using (PhysicsThread.Lock()) SyncStateComponents();
+    } else {
+      SyncStateComponents();
+    }
+  }
+
+  private unsafe void SyncTransforms() {
+    int n = _syncComponents.Count;
+    if (n == 0) return;
+    for (int i = 0; i < n; i++) {
+      var component = _syncComponents[i];
+      _syncEnabled[i] = (byte)(component != null && component.isActiveAndEnabled ? 1 : 0);
+    }
+    var poses = (MjbPose*)NativeArrayUnsafeUtility.GetUnsafePtr(_syncPoses);
+    if (PhysicsThread != null) {
+      PhysicsThread.Interpolate(poses, n);
+    } else {
+      Data.ExportTransforms(poses, n);
+    }
+    new ApplyPosesJob { Poses = _syncPoses, Enabled = _syncEnabled }
+        .Schedule(_syncTransforms).Complete();
+  }
+
+  private void SyncStateComponents() {
+    foreach (var component in _stateComponents) {
       if (component != null && component.isActiveAndEnabled) {
         component.OnSyncState(Data);
       }
     }
   }
 
-  public unsafe void RecreateScene() {
-    var joints = FindObjectsByType<MjBaseJoint>(FindObjectsSortMode.None);
-    var positions = new Dictionary<MjBaseJoint, double[]>();
-    var velocities = new Dictionary<MjBaseJoint, double[]>();
-    foreach (var joint in joints) {
-      if (joint.QposAddress > -1) {
-        int jntType = Model.JntType(joint.MujocoId);
-        var qpos = Data.GetQpos();
-        var qvel = Data.GetQvel();
-        int qa = joint.QposAddress;
-        int da = joint.DofAddress;
-        switch (jntType) {
-          default:
-          case (int)mjtJoint.mjJNT_HINGE:
-          case (int)mjtJoint.mjJNT_SLIDE:
-            positions[joint] = new double[] { qpos[qa] };
-            velocities[joint] = new double[] { qvel[da] };
-            break;
-          case (int)mjtJoint.mjJNT_BALL:
-            positions[joint] = new double[] { qpos[qa], qpos[qa+1], qpos[qa+2], qpos[qa+3] };
-            velocities[joint] = new double[] { qvel[da], qvel[da+1], qvel[da+2] };
-            break;
-          case (int)mjtJoint.mjJNT_FREE:
-            positions[joint] = new double[] {
-                qpos[qa], qpos[qa+1], qpos[qa+2], qpos[qa+3],
-                qpos[qa+4], qpos[qa+5], qpos[qa+6] };
-            velocities[joint] = new double[] {
-                qvel[da], qvel[da+1], qvel[da+2],
-                qvel[da+3], qvel[da+4], qvel[da+5] };
-            break;
-        }
+  private struct ApplyPosesJob : IJobParallelForTransform {
+    [ReadOnly] public NativeArray<MjbPose> Poses;
+    [ReadOnly] public NativeArray<byte> Enabled;
+
+    public void Execute(int index, TransformAccess transform) {
+      if (Enabled[index] == 0) return;
+      var p = Poses[index];
+      transform.position = new Vector3(p.px, p.py, p.pz);
+      transform.rotation = new Quaternion(p.qx, p.qy, p.qz, p.qw);
+    }
+  }
+
+  private void BindTransformSync(IEnumerable<MjComponent> components) {
+    ReleaseTransformSync();
+    var types = new List<int>();
+    var ids = new List<int>();
+    var offsets = new List<float>();
+    foreach (var component in components) {
+      if (component != null && component.MujocoId >= 0 &&
+          component.GetSyncFrame(out var type, out var offset)) {
+        _syncComponents.Add(component);
+        types.Add((int)type);
+        ids.Add(component.MujocoId);
+        offsets.Add(offset.Translation.x);
+        offsets.Add(offset.Translation.y);
+        offsets.Add(offset.Translation.z);
+        offsets.Add(offset.Rotation.x);
+        offsets.Add(offset.Rotation.y);
+        offsets.Add(offset.Rotation.z);
+        offsets.Add(offset.Rotation.w);
+      } else {
+        _stateComponents.Add(component);
       }
     }
+    int n = _syncComponents.Count;
+    Data.BindTransforms(types.ToArray(), ids.ToArray(), offsets.ToArray());
+    _syncTransforms = new TransformAccessArray(_syncComponents.Select(c => c.transform).ToArray());
+    _syncPoses = new NativeArray<MjbPose>(n, Allocator.Persistent);
+    _syncEnabled = new NativeArray<byte>(n, Allocator.Persistent);
+  }
 
+  private void ReleaseTransformSync() {
+    _syncComponents.Clear();
+    _stateComponents.Clear();
+    if (_syncTransforms.isCreated) _syncTransforms.Dispose();
+    if (_syncPoses.IsCreated) _syncPoses.Dispose();
+    if (_syncEnabled.IsCreated) _syncEnabled.Dispose();
+  }
+
+  // The MJCF is generated from the Unity transforms, so they are posed at the
+  // reference configuration first. Generated names carry a scene-wide counter
+  // and shift when components are added, so each surviving joint component is
+  // paired with its old joint id and the live state is mapped natively along
+  // those pairs; the handles stay valid. This is a full regeneration and
+  // compile: component edits are not translated into MjbModel spec edits.
+  public void RecreateScene() {
+    StopPhysicsThread();
+    if (Model == null || Data == null) {
+      DestroyScene();
+      CreateScene();
+      return;
+    }
+    var qpos = Data.GetQpos().ToArray();
+    var qvel = Data.GetQvel().ToArray();
+    var oldJointIds = new Dictionary<MjBaseJoint, int>();
+    foreach (var joint in _orderedComponents.OfType<MjBaseJoint>()) {
+      if (joint != null && joint.MujocoId >= 0) oldJointIds[joint] = joint.MujocoId;
+    }
     Data.ResetData();
     Data.Kinematics();
     SyncUnityToMjState();
 
-    DestroyScene();
-    CreateScene();
-
-    foreach (var joint in joints) {
-      try {
-        var position = positions[joint];
-        var velocity = velocities[joint];
-        int jntType = Model.JntType(joint.MujocoId);
-        int qa = joint.QposAddress;
-        int da = joint.DofAddress;
-        switch (jntType) {
-          default:
-          case (int)mjtJoint.mjJNT_HINGE:
-          case (int)mjtJoint.mjJNT_SLIDE:
-            Data.SetQposAt(qa, position[0]);
-            Data.SetQvelAt(da, velocity[0]);
-            break;
-          case (int)mjtJoint.mjJNT_BALL:
-            for (int i = 0; i < 4; i++) Data.SetQposAt(qa + i, position[i]);
-            for (int i = 0; i < 3; i++) Data.SetQvelAt(da + i, velocity[i]);
-            break;
-          case (int)mjtJoint.mjJNT_FREE:
-            for (int i = 0; i < 7; i++) Data.SetQposAt(qa + i, position[i]);
-            for (int i = 0; i < 6; i++) Data.SetQvelAt(da + i, velocity[i]);
-            break;
-        }
-      } catch {}
+    var sceneMjcf = GenerateScene();
+    var jointNames = new List<string>();
+    var jointIds = new List<int>();
+    foreach (var joint in _orderedComponents.OfType<MjBaseJoint>()) {
+      if (oldJointIds.TryGetValue(joint, out var oldId)) {
+        jointNames.Add(joint.MujocoName);
+        jointIds.Add(oldId);
+      }
     }
+    preDestroyEvent?.Invoke(this, new MjStepArgs(Model, Data));
+    UseModelCache(true);
+    try {
+      Model.Reload(Data, sceneMjcf.OuterXml, qpos, qvel, jointNames.ToArray(), jointIds.ToArray());
+    } catch {
+      Data.SetQpos(qpos);
+      Data.SetQvel(qvel);
+      Data.Kinematics();
+      SyncUnityToMjState();
+      throw;
+    } finally {
+      UseModelCache(false);
+    }
+    _backend?.Dispose();
+    BindScene(_orderedComponents);
+    postInitEvent?.Invoke(this, new MjStepArgs(Model, Data));
+
     Data.Kinematics();
     SyncUnityToMjState();
   }
 
   public void DestroyScene() {
+    StopPhysicsThread();
     preDestroyEvent?.Invoke(this, new MjStepArgs(Model, Data));
+    StopPlayback();
+    ReleaseTransformSync();
+    SetProfiling(false);
     _backend?.Dispose();
     _backend = null;
     Data?.Dispose();
@@ -293,6 +489,7 @@ public class MjScene : MonoBehaviour {
     if (Model == null || Data == null) {
       throw new NullReferenceException("Failed to create Mujoco runtime.");
     }
+    StopPhysicsThread();
     Profiler.BeginSample("MjStep");
     Profiler.BeginSample("MjStep.mj_step");
 
@@ -303,11 +500,11 @@ public class MjScene : MonoBehaviour {
         Data.Step2();
       }
     } else {
-      for (int i = 0; i < _subStepsPerFixedUpdate; i++)
-        _backend.Step();
+      _backend.Step(_subStepsPerFixedUpdate);
     }
     Profiler.EndSample(); // MjStep.mj_step
 
+    if (_profiling) CollectStepProfile();
     CheckForPhysicsException();
 
     Profiler.BeginSample("MjStep.OnSyncState");
@@ -316,6 +513,56 @@ public class MjScene : MonoBehaviour {
     Profiler.EndSample(); // MjStep
   }
 
+  // Replaces stepping with playback of a trajectory file (see MjbTrajectory)
+  // until StopPlayback; the pose of the last applied frame is kept.
+  public void StartPlayback(string path) {
+    if (Model == null || Data == null) {
+      throw new NullReferenceException("Failed to create Mujoco runtime.");
+    }
+    var trajectory = new MjbTrajectory(path);
+    if (trajectory.Nq != Model.Info.nq) {
+      trajectory.Dispose();
+      throw new ArgumentException(
+          $"Trajectory '{path}' has nq={trajectory.Nq}, the scene has nq={Model.Info.nq}.");
+    }
+    StopPlayback();
+    StopPhysicsThread();
+    Playback = trajectory;
+    SeekPlayback(trajectory.StartTime);
+  }
+
+  public void StopPlayback() {
+    Playback?.Dispose();
+    Playback = null;
+  }
+
+  // Scrubbing: pose the scene at a trajectory time (clamped), interpolating
+  // between the neighbouring frames.
+  public void SeekPlayback(double time) {
+    if (Playback == null) return;
+    PlaybackTime = Math.Min(Math.Max(time, Playback.StartTime), Playback.EndTime);
+    Profiler.BeginSample("MjPlayback");
+    Playback.Apply(Model, Data, Playback.Locate(PlaybackTime));
+    SyncUnityToMjState();
+    Profiler.EndSample();
+  }
+
+  public void SeekPlaybackFrame(long frame) {
+    if (Playback == null) return;
+    frame = Math.Min(Math.Max(frame, 0), Playback.FrameCount - 1);
+    SeekPlayback(Playback.GetTime(frame));
+  }
+
+  private void AdvancePlayback(double dt) {
+    double time = PlaybackTime + dt;
+    double duration = Playback.Duration;
+    if (PlaybackLoop && duration > 0) {
+      time = Playback.StartTime + (time - Playback.StartTime) % duration;
+      if (time < Playback.StartTime) time += duration;
+    }
+    SeekPlayback(time);
+  }
+
   private static readonly string[] _warningMessages = {
       "INERTIA: (Near-) Singular inertia matrix.",
       "CONTACTFULL: nconmax isn't sufficient.",
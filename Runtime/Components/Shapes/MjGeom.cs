@@ -86,6 +86,14 @@ public class MjGeom : MjShapeComponent {
     }
   }
 
+  public override bool GetSyncFrame(out mjtObj objectType, out MjTransformation offset) {
+    base.GetSyncFrame(out objectType, out offset);
+    if (OverridesSyncState(typeof(MjGeom))) return false;
+    objectType = mjtObj.mjOBJ_GEOM;
+    if (ShapeType == ShapeTypes.Mesh) offset = _comTransform;
+    return true;
+  }
+
   public void OnDrawGizmosSelected() {
     Gizmos.color = Color.blue;
     DrawGizmos(transform);
@@ -47,6 +47,10 @@ public class MjHeightFieldShape : IMjShape {
 
   private int _updateCountdown;
 
+  // Heightmap samples edited since the last upload; width 0 = no partial edit pending.
+  private RectInt _dirtyRegion;
+  private bool _dirtyAll;
+
   [HideInInspector]
   public float MinimumHeight { get; private set; }
 
@@ -86,8 +90,7 @@ public class MjHeightFieldShape : IMjShape {
       if (UpdateLimit > 1) {
         scene.preUpdateEvent += (unused_first, unused_second) => CountdownUpdateCondition();
       }
-      TerrainCallbacks.heightmapChanged += (unused_first, unused_second, unused_third) =>
-          RebuildHeightField();
+      TerrainCallbacks.heightmapChanged += OnHeightmapChanged;
     }
 
     mjcf.SetAttribute("hfield", assetName);
@@ -131,6 +134,33 @@ public class MjHeightFieldShape : IMjShape {
     MjScene.Instance.Model.SetHfieldData(adr, curData);
   }
 
+  // Uploads only the edited samples, read from the CPU copy of the heightmap.
+  public void UpdateHeightFieldRegion(RectInt region) {
+    int res = Terrain.terrainData.heightmapResolution;
+    region.SetMinMax(Vector2Int.Max(region.min, Vector2Int.zero),
+                     Vector2Int.Min(region.max, new Vector2Int(res, res)));
+    if (region.width <= 0 || region.height <= 0) return;
+    float[,] heights = Terrain.terrainData.GetHeights(region.x, region.y, region.width,
+                                                      region.height);
+    var values = new float[region.width * region.height];
+    Buffer.BlockCopy(heights, 0, values, 0, values.Length * sizeof(float));
+    MjScene.Instance.Model.SetHfieldRect(HeightFieldId, region.y, region.x, region.height,
+                                         region.width, values);
+  }
+
+  private void OnHeightmapChanged(Terrain terrain, RectInt heightRegion, bool synched) {
+    if (terrain != Terrain) return;
+    // Unsynched edits only exist in the heightmap texture, so take the full readback.
+    if (!synched || _dirtyRegion.width == 0) {
+      _dirtyAll |= !synched;
+      _dirtyRegion = heightRegion;
+    } else {
+      _dirtyRegion.SetMinMax(Vector2Int.Min(_dirtyRegion.min, heightRegion.min),
+                             Vector2Int.Max(_dirtyRegion.max, heightRegion.max));
+    }
+    RebuildHeightField();
+  }
+
   public void CountdownUpdateCondition() {
     if (_updateCountdown < 1) return;
     _updateCountdown -= 1;
@@ -144,9 +174,13 @@ public class MjHeightFieldShape : IMjShape {
     if (ExportImage) {
       // If we export an image, it needs to be read by the compiler so we might as well rebuild the scene.
       MjScene.Instance.SceneRecreationAtLateUpdateRequested = true;
-    } else {
+    } else if (_dirtyAll || _dirtyRegion.width == 0) {
       UpdateHeightFieldData();
+    } else {
+      UpdateHeightFieldRegion(_dirtyRegion);
     }
+    _dirtyRegion = default;
+    _dirtyAll = false;
     _updateCountdown = UpdateLimit + 1;
   }
 
@@ -45,6 +45,13 @@ public class MjSite : MjShapeComponent {
     transform.rotation = MjEngineTool.UnityQuaternionFromMatrixAtEntry(data.GetSiteXmat(), MujocoId);
   }
 
+  public override bool GetSyncFrame(out mjtObj objectType, out MjTransformation offset) {
+    base.GetSyncFrame(out objectType, out offset);
+    if (OverridesSyncState(typeof(MjSite))) return false;
+    objectType = mjtObj.mjOBJ_SITE;
+    return true;
+  }
+
   public void OnDrawGizmosSelected() {
     Gizmos.color = Color.magenta;
     DrawGizmos(transform);
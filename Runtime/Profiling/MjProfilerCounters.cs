@@ -0,0 +1,44 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using Unity.Profiling;
+using UnityEngine;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+// Publishes MjScene's stage profile as Profiler counters. This assembly only
+// compiles with com.unity.profiling.core installed, so Mujoco.Runtime itself
+// does not depend on the package.
+internal static class MjProfilerCounters {
+  private const ProfilerCounterOptions _counterOptions =
+      ProfilerCounterOptions.FlushOnEndOfFrame | ProfilerCounterOptions.ResetToZeroOnFlush;
+  private static readonly ProfilerCounterValue<double> _stepCounter = new ProfilerCounterValue<double>(
+      ProfilerCategory.Physics, "MuJoCo Step", ProfilerMarkerDataUnit.TimeNanoseconds, _counterOptions);
+  private static readonly ProfilerCounterValue<double> _collisionCounter = new ProfilerCounterValue<double>(
+      ProfilerCategory.Physics, "MuJoCo Collision", ProfilerMarkerDataUnit.TimeNanoseconds, _counterOptions);
+  private static readonly ProfilerCounterValue<double> _constraintCounter = new ProfilerCounterValue<double>(
+      ProfilerCategory.Physics, "MuJoCo Constraint", ProfilerMarkerDataUnit.TimeNanoseconds, _counterOptions);
+  private static readonly ProfilerCounterValue<int> _contactCounter = new ProfilerCounterValue<int>(
+      ProfilerCategory.Physics, "MuJoCo Contacts", ProfilerMarkerDataUnit.Count);
+  private static readonly ProfilerCounterValue<int> _efcCounter = new ProfilerCounterValue<int>(
+      ProfilerCategory.Physics, "MuJoCo Constraints", ProfilerMarkerDataUnit.Count);
+  private static readonly ProfilerCounterValue<long> _solverCounter = new ProfilerCounterValue<long>(
+      ProfilerCategory.Physics, "MuJoCo Solver Iterations", ProfilerMarkerDataUnit.Count, _counterOptions);
+
+  [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.SubsystemRegistration)]
+  private static void Register() {
+    MjScene.stepProfiled -= Publish;
+    MjScene.stepProfiled += Publish;
+  }
+
+  private static void Publish(MjbProfile profile) {
+    _stepCounter.Value += profile.GetStageMs(mjtTimer.mjTIMER_STEP) * 1e6;
+    _collisionCounter.Value += profile.GetStageMs(mjtTimer.mjTIMER_POS_COLLISION) * 1e6;
+    _constraintCounter.Value += profile.GetStageMs(mjtTimer.mjTIMER_CONSTRAINT) * 1e6;
+    _contactCounter.Value = profile.maxContacts;
+    _efcCounter.Value = profile.maxConstraints;
+    _solverCounter.Value += profile.solverIters;
+  }
+}
+}
@@ -2,6 +2,8 @@
 // Apache-2.0 License
 
 using System;
+using System.IO;
+using System.Runtime.InteropServices;
 
 namespace Mujoco.Mjb
 {
@@ -9,19 +11,39 @@ namespace Mujoco.Mjb
     {
         internal IntPtr Handle { get; private set; }
         private bool _disposed;
+        private readonly bool _ownsHandle;  // false for groups owned by an MjbMultiSim
 
         private MjbDoubleSpan _cQpos, _cQvel, _cXpos, _cSubtreeCom;
         private MjbDoubleSpan _cCinert, _cCvel, _cQfrcActuator, _cCfrcExt;
         private bool _cached;
 
-        internal MjbBatchedSim(IntPtr handle)
+        // Pins for managed arrays bound as output buffers, indexed by MjbBatchedField.
+        private readonly GCHandle[] _outputPins = new GCHandle[(int)MjbBatchedField.GeomXmat + 1];
+
+        internal MjbBatchedSim(IntPtr handle, MjbModelInfo modelInfo, int numEnvs,
+            bool ownsHandle = true)
         {
             Handle = handle;
+            _ownsHandle = ownsHandle;
+            ModelInfo = modelInfo;
+            NumEnvs = numEnvs;
+            IsContiguous = MjbNativeMethods.mjaccess_batched_is_contiguous(handle) != 0;
         }
 
+        public MjbModelInfo ModelInfo { get; }
+        public int NumEnvs { get; }
+
+        /// <summary>
+        /// True when the sim was created with contiguousState: getters return the
+        /// state slabs directly and the returned spans stay valid across steps.
+        /// </summary>
+        public bool IsContiguous { get; }
+
         public unsafe void CacheState()
         {
             ThrowIfDisposed();
+            // Slab pointers never move, so a single fetch serves the sim's lifetime.
+            if (_cached && IsContiguous) return;
             int n;
             _cQpos = new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_qpos(Handle, &n), n);
             _cQvel = new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_qvel(Handle, &n), n);
@@ -34,7 +56,19 @@ namespace Mujoco.Mjb
             _cached = true;
         }
 
-        public void InvalidateCache() => _cached = false;
+        public void InvalidateCache()
+        {
+            if (!IsContiguous) _cached = false;
+        }
+
+        public int NumThreads
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_batched_num_threads(Handle);
+            }
+        }
 
         public unsafe void Step(double[] ctrl)
         {
@@ -43,6 +77,57 @@ namespace Mujoco.Mjb
                 MjbNativeMethods.mjaccess_batched_step(Handle, p);
         }
 
+        /// <summary>Frame-skip: hold <paramref name="ctrl"/> for <paramref name="nSubsteps"/> steps.</summary>
+        public unsafe void Step(double[] ctrl, int nSubsteps)
+        {
+            ThrowIfDisposed();
+            fixed (double* p = ctrl)
+                MjbNativeMethods.mjaccess_batched_step_n(Handle, p, nSubsteps);
+        }
+
+        /// <summary>
+        /// Step with a per-substep control schedule laid out as
+        /// [numEnvs][nSubsteps][nu].
+        /// </summary>
+        public unsafe void StepSchedule(double[] ctrlSchedule, int nSubsteps)
+        {
+            ThrowIfDisposed();
+            fixed (double* p = ctrlSchedule)
+                MjbNativeMethods.mjaccess_batched_step_schedule(Handle, p, nSubsteps);
+        }
+
+        /// <summary>
+        /// Start stepping envs [envBegin, envBegin + envCount) on the worker pool and return
+        /// immediately; ctrl holds envCount * nu values and is copied before returning.
+        /// Until <see cref="Wait"/> only rows of envs outside the range may be read or
+        /// written, so inference on one half can overlap physics on the other.
+        /// </summary>
+        public unsafe void StepAsync(double[] ctrl, int envBegin, int envCount, int nSubsteps = 1)
+        {
+            ThrowIfDisposed();
+            int rc;
+            fixed (double* p = ctrl)
+                rc = MjbNativeMethods.mjaccess_batched_step_async(Handle, p, nSubsteps, envBegin, envCount);
+            if (rc != 0)
+                throw new ArgumentException($"Invalid async step range [{envBegin}, {envBegin + envCount})");
+        }
+
+        /// <summary>Block until the last StepAsync has finished.</summary>
+        public void Wait()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_wait(Handle);
+        }
+
+        public bool IsStepping
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_batched_is_busy(Handle) != 0;
+            }
+        }
+
         public unsafe void Reset(int[] resetMask)
         {
             ThrowIfDisposed();
@@ -50,6 +135,611 @@ namespace Mujoco.Mjb
                 MjbNativeMethods.mjaccess_batched_reset(Handle, p);
         }
 
+        // ── Snapshot pool and auto-reset ─────────────────────────────
+
+        /// <summary>Set the mjSTATE_* spec of pooled snapshots (empties the pool).</summary>
+        public int SetSnapshotSpec(mjtState spec)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_batched_snapshot_set_spec(Handle, (uint)spec);
+        }
+
+        /// <summary>Doubles per snapshot for the current spec.</summary>
+        public int SnapshotSize
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_batched_snapshot_size(Handle);
+            }
+        }
+
+        public int SnapshotCount
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_batched_snapshot_count(Handle);
+            }
+        }
+
+        /// <summary>Capture the current state of one env into the pool; returns its index.</summary>
+        public int CaptureSnapshot(int envIndex)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_batched_snapshot_capture(Handle, envIndex);
+        }
+
+        /// <summary>Append packed states (SnapshotSize doubles each); returns the first index.</summary>
+        public unsafe int AddSnapshots(double[] states)
+        {
+            ThrowIfDisposed();
+            int size = SnapshotSize;
+            if (size <= 0 || states.Length % size != 0)
+                throw new ArgumentException($"State buffer length must be a multiple of {size}");
+            fixed (double* p = states)
+                return MjbNativeMethods.mjaccess_batched_snapshot_add(Handle, p, states.Length / size);
+        }
+
+        public void ClearSnapshots()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_snapshot_clear(Handle);
+        }
+
+        public void SetAutoReset(MjbAutoResetConfig config)
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_set_auto_reset(Handle, ref config);
+        }
+
+        /// <summary>
+        /// Mark envs to restart during the next Step. snapshotIndex (optional) picks a
+        /// pooled snapshot per env; -1 or null picks one at random.
+        /// </summary>
+        public unsafe void SetDone(int[] doneMask, int[] snapshotIndex = null)
+        {
+            ThrowIfDisposed();
+            fixed (int* d = doneMask)
+            fixed (int* s = snapshotIndex)
+                MjbNativeMethods.mjaccess_batched_set_done(Handle, d, s);
+        }
+
+        /// <summary>Restart the masked envs from the snapshot pool immediately, in parallel.</summary>
+        public unsafe void ResetToSnapshots(int[] resetMask, int[] snapshotIndex = null)
+        {
+            ThrowIfDisposed();
+            fixed (int* m = resetMask)
+            fixed (int* s = snapshotIndex)
+                MjbNativeMethods.mjaccess_batched_reset_to_snapshots(Handle, m, s);
+        }
+
+        /// <summary>int[numEnvs]: 1 for envs restarted by the last step or reset.</summary>
+        public unsafe void GetResetFlags(out int* data, out int length)
+        {
+            ThrowIfDisposed();
+            int n;
+            data = MjbNativeMethods.mjaccess_batched_get_reset_flags(Handle, &n);
+            length = n;
+        }
+
+        // ── Observation plan (packed float32) ────────────────────────
+
+        public void ClearObservation()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_obs_clear(Handle);
+        }
+
+        /// <summary>Append a term for object <paramref name="objId"/>; returns its width.</summary>
+        public int AddObservation(MjbObsTerm term, int objId)
+        {
+            ThrowIfDisposed();
+            int width = MjbNativeMethods.mjaccess_batched_obs_add(Handle, (int)term, objId);
+            if (width < 0)
+                throw new ArgumentException($"Invalid observation term {term} for object {objId}");
+            return width;
+        }
+
+        /// <summary>Append a term for the named object; returns its width.</summary>
+        public int AddObservation(MjbObsTerm term, string name)
+        {
+            ThrowIfDisposed();
+            int width = MjbNativeMethods.mjaccess_batched_obs_add_named(Handle, (int)term, name);
+            if (width < 0)
+                throw new ArgumentException($"Invalid observation term {term} for object '{name}'");
+            return width;
+        }
+
+        public int ObservationDim
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_batched_obs_dim(Handle);
+            }
+        }
+
+        /// <summary>
+        /// Have the workers write observations into a caller-owned
+        /// float[numEnvs * ObservationDim]; null restores the internal buffer.
+        /// Adding or clearing terms unbinds it, so bind once the plan is complete.
+        /// </summary>
+        public unsafe void BindObservation(float* dst, int length)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_bind_obs(Handle, dst, length) != 0)
+                throw new ArgumentException($"Observation buffer is too small ({length})");
+        }
+
+        /// <summary>float[numEnvs * ObservationDim] written by the last step or reset.</summary>
+        public unsafe MjbFloatSpan GetObservation()
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbFloatSpan(MjbNativeMethods.mjaccess_batched_get_obs(Handle, &n), n);
+        }
+
+        /// <summary>Recompute observations for every env from the current state.</summary>
+        public void RefreshObservation()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_obs_refresh(Handle);
+        }
+
+        // ── Running normalization ────────────────────────────────────
+
+        /// <summary>
+        /// Keep running per-feature mean/variance of the observation plan and write
+        /// normalized observations in place. Statistics are updated by the step workers
+        /// during the gather; adding or clearing terms disables normalization.
+        /// </summary>
+        public unsafe void EnableObservationNormalization(MjbNormConfig config)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_obs_norm_enable(Handle, &config) != 0)
+                throw new InvalidOperationException("Observation normalization needs a non-empty observation plan");
+        }
+
+        public unsafe void DisableObservationNormalization()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_obs_norm_enable(Handle, null);
+        }
+
+        /// <summary>Scale rewards by the running std of the discounted return.</summary>
+        public unsafe void EnableRewardNormalization(MjbNormConfig config)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_reward_norm_enable(Handle, &config) != 0)
+                throw new OutOfMemoryException("Failed to allocate reward normalization state");
+        }
+
+        public unsafe void DisableRewardNormalization()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_reward_norm_enable(Handle, null);
+        }
+
+        /// <summary>Normalize rewards[numEnvs] in place; dones (optional) restart the running returns.</summary>
+        public unsafe void NormalizeRewards(float[] rewards, int[] dones = null)
+        {
+            ThrowIfDisposed();
+            fixed (float* r = rewards)
+            fixed (int* d = dones)
+                MjbNativeMethods.mjaccess_batched_normalize_rewards(Handle, r, d);
+        }
+
+        /// <summary>Frozen statistics are still applied but no longer updated (evaluation).</summary>
+        public void FreezeNormalization(bool frozen = true)
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_norm_freeze(Handle, frozen ? 1 : 0);
+        }
+
+        public void ResetNormalization()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_norm_reset(Handle);
+        }
+
+        /// <summary>Copy the observation statistics into mean/var[ObservationDim]; returns the sample count.</summary>
+        public unsafe double GetObservationStats(double[] mean, double[] var)
+        {
+            ThrowIfDisposed();
+            int dim = ObservationDim;
+            if ((mean != null && mean.Length < dim) || (var != null && var.Length < dim))
+                throw new ArgumentException($"Statistics arrays must hold {dim} values");
+            double count = 0;
+            fixed (double* m = mean)
+            fixed (double* v = var)
+                MjbNativeMethods.mjaccess_batched_obs_norm_get(Handle, m, v, &count);
+            return count;
+        }
+
+        public unsafe void SetObservationStats(double[] mean, double[] var, double count)
+        {
+            ThrowIfDisposed();
+            if (mean == null || var == null || mean.Length != var.Length)
+                throw new ArgumentException("mean and var must have the same length");
+            fixed (double* m = mean)
+            fixed (double* v = var)
+            {
+                if (MjbNativeMethods.mjaccess_batched_obs_norm_set(Handle, m, v, count, mean.Length) != 0)
+                    throw new ArgumentException(
+                        $"Statistics of dim {mean.Length} do not match the enabled observation normalization");
+            }
+        }
+
+        /// <summary>Write observation (if enabled) and reward statistics.</summary>
+        public unsafe void SaveNormalization(Stream stream)
+        {
+            ThrowIfDisposed();
+            int dim = MjbNativeMethods.mjaccess_batched_obs_norm_get(Handle, null, null, null);
+            var mean = new double[dim];
+            var var = new double[dim];
+            double count = GetObservationStats(mean, var);
+            var reward = new double[3];
+            fixed (double* r = reward)
+                MjbNativeMethods.mjaccess_batched_reward_norm_get(Handle, r);
+
+            using (var w = new BinaryWriter(stream, System.Text.Encoding.UTF8, true))
+            {
+                w.Write(dim);
+                w.Write(count);
+                for (int i = 0; i < dim; i++) w.Write(mean[i]);
+                for (int i = 0; i < dim; i++) w.Write(var[i]);
+                for (int i = 0; i < 3; i++) w.Write(reward[i]);
+            }
+        }
+
+        /// <summary>Restore statistics written by SaveNormalization (normalization must be enabled).</summary>
+        public unsafe void LoadNormalization(Stream stream)
+        {
+            ThrowIfDisposed();
+            using (var r = new BinaryReader(stream, System.Text.Encoding.UTF8, true))
+            {
+                int dim = r.ReadInt32();
+                double count = r.ReadDouble();
+                var mean = new double[dim];
+                var var = new double[dim];
+                for (int i = 0; i < dim; i++) mean[i] = r.ReadDouble();
+                for (int i = 0; i < dim; i++) var[i] = r.ReadDouble();
+                var reward = new double[3];
+                for (int i = 0; i < 3; i++) reward[i] = r.ReadDouble();
+
+                if (dim > 0) SetObservationStats(mean, var, count);
+                fixed (double* p = reward)
+                    MjbNativeMethods.mjaccess_batched_reward_norm_set(Handle, p);
+            }
+        }
+
+        // ── Domain randomization ─────────────────────────────────────
+
+        /// <summary>
+        /// Give every env its own copy of <paramref name="param"/>, initialized from
+        /// the model. Returns the per-env row length.
+        /// </summary>
+        public int EnableParameter(MjbParam param)
+        {
+            ThrowIfDisposed();
+            int dim = MjbNativeMethods.mjaccess_batched_param_enable(Handle, (int)param);
+            if (dim < 0)
+                throw new OutOfMemoryException($"Failed to allocate per-env {param}");
+            return dim;
+        }
+
+        /// <summary>Return to the shared model array and drop the parameter's terms.</summary>
+        public void DisableParameter(MjbParam param)
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_param_disable(Handle, (int)param);
+        }
+
+        /// <summary>
+        /// Writable double[numEnvs * dim] per-env rows of an enabled parameter; edits
+        /// apply from the next step. Empty when the parameter is shared.
+        /// </summary>
+        public unsafe MjbDoubleSpan GetParameterTable(MjbParam param)
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_param_table(Handle, (int)param, &n), n);
+        }
+
+        /// <summary>Append a randomization term (enables its parameter); returns the term index.</summary>
+        public unsafe int AddRandomization(MjbRandTerm term)
+        {
+            ThrowIfDisposed();
+            int index = MjbNativeMethods.mjaccess_batched_rand_add(Handle, &term);
+            if (index < 0)
+                throw new ArgumentException(
+                    $"Invalid randomization term for {term.param} (object {term.obj}, component {term.component})");
+            return index;
+        }
+
+        public void ClearRandomization()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_rand_clear(Handle);
+        }
+
+        /// <summary>Resample an env's parameters whenever it is reset or auto-reset.</summary>
+        public void RandomizeOnReset(bool enabled = true)
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_rand_on_reset(Handle, enabled ? 1 : 0);
+        }
+
+        /// <summary>Resample the masked envs (null = all) on the worker pool.</summary>
+        public unsafe void Randomize(int[] envMask = null)
+        {
+            ThrowIfDisposed();
+            fixed (int* m = envMask)
+                MjbNativeMethods.mjaccess_batched_randomize(Handle, m);
+        }
+
+        // ── Profiling ────────────────────────────────────────────────
+
+        /// <summary>
+        /// Have the workers time each env step and gather, and collect MuJoCo stage
+        /// timers and contact/constraint counts.
+        /// </summary>
+        public void EnableProfiling(bool enabled = true)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_profile_enable(Handle, enabled ? 1 : 0) != 0)
+                throw new OutOfMemoryException("Failed to allocate profiling state");
+        }
+
+        /// <summary>Totals since profiling was enabled or last reset.</summary>
+        public unsafe MjbProfile GetProfile()
+        {
+            ThrowIfDisposed();
+            MjbProfile profile;
+            MjbNativeMethods.mjaccess_batched_get_profile(Handle, &profile);
+            return profile;
+        }
+
+        /// <summary>Fill busy/idle ms per worker (arrays may be null); returns the worker count.</summary>
+        public unsafe int GetWorkerProfile(double[] busyMs, double[] idleMs)
+        {
+            ThrowIfDisposed();
+            int n = Math.Min(busyMs?.Length ?? int.MaxValue, idleMs?.Length ?? int.MaxValue);
+            if (n == int.MaxValue) n = 0;
+            fixed (double* b = busyMs)
+            fixed (double* i = idleMs)
+                return MjbNativeMethods.mjaccess_batched_get_worker_profile(Handle, b, i, n);
+        }
+
+        public void ResetProfile()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_profile_reset(Handle);
+        }
+
+        // ── Trajectory recording ─────────────────────────────────────
+
+        /// <summary>
+        /// Stream every subsequent step of all envs to <paramref name="path"/>; read the
+        /// file back with <see cref="MjbRecordReader"/>. Workers copy the selected fields
+        /// into a ring buffer and a native writer thread encodes and writes them.
+        /// </summary>
+        public void StartRecording(string path, MjbRecordConfig config = default)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_record_start(Handle, path, ref config) != 0)
+                throw new InvalidOperationException($"Failed to start recording to '{path}'");
+        }
+
+        /// <summary>Flush the remaining frames and close the file.</summary>
+        public void StopRecording()
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_record_stop(Handle) != 0)
+                throw new System.IO.IOException("Recording failed or was not started");
+        }
+
+        public MjbRecordStats GetRecordingStats()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_record_stats(Handle, out var stats);
+            return stats;
+        }
+
+        // ── Contacts (filled by the step workers) ────────────────────
+
+        /// <summary>Replace one side of the contact filter (see MjbData.SetContactFilter).</summary>
+        public unsafe void SetContactFilter(int side, mjtObj objectType, int[] ids)
+        {
+            ThrowIfDisposed();
+            fixed (int* p = ids)
+            {
+                if (MjbNativeMethods.mjaccess_batched_contact_filter(Handle, side, (int)objectType, p,
+                        ids?.Length ?? 0) != 0)
+                    throw new ArgumentException("Invalid contact filter side, type or id");
+            }
+        }
+
+        /// <summary>
+        /// Reserve <paramref name="capacity"/> contacts per env (0 = off). Every step and reset
+        /// then packs each env's filtered contacts into its block.
+        /// </summary>
+        public void SetContactCapacity(int capacity)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_contact_capacity(Handle, capacity) != 0)
+                throw new InvalidOperationException($"Failed to reserve {capacity} contacts per env");
+        }
+
+        /// <summary>
+        /// Contacts of env i are contacts[i * capacity .. i * capacity + counts[i]). The
+        /// pointers stay valid until the capacity changes.
+        /// </summary>
+        public unsafe MjbContact* GetContacts(out int* counts, out int capacity)
+        {
+            ThrowIfDisposed();
+            int* c;
+            int cap;
+            MjbContact* contacts = MjbNativeMethods.mjaccess_batched_get_contacts(Handle, &c, &cap);
+            counts = c;
+            capacity = cap;
+            return contacts;
+        }
+
+        // ── Derivatives ──────────────────────────────────────────────
+
+        /// <summary>
+        /// Finite-difference transition Jacobians of every env (see MjbData.TransitionFD), written
+        /// as numEnvs env-major blocks per buffer. Runs on the worker pool over (env, column).
+        /// </summary>
+        public unsafe void TransitionFD(double eps, bool centered, double* A, double* B,
+            double* C, double* D)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_transition_fd(Handle, eps, centered ? 1 : 0,
+                    A, B, C, D) != 0)
+                throw new InvalidOperationException("TransitionFD failed");
+        }
+
+        public unsafe void TransitionFD(double eps, bool centered, double[] A, double[] B,
+            double[] C = null, double[] D = null)
+        {
+            MjbData.CheckJacobianSizes(ModelInfo, NumEnvs, A, B, C, D);
+            fixed (double* a = A)
+            fixed (double* b = B)
+            fixed (double* c = C)
+            fixed (double* d = D)
+                TransitionFD(eps, centered, a, b, c, d);
+        }
+
+        // ── Instanced rendering ──────────────────────────────────────
+
+        /// <summary>
+        /// Group the visible geoms (nonzero alpha, group bit set in <paramref name="groupMask"/>,
+        /// 0 = all groups) into batches that each share one mesh, one instanced draw apiece.
+        /// </summary>
+        public unsafe MjbRenderBatch[] SetupRender(uint groupMask = 0)
+        {
+            ThrowIfDisposed();
+            int n = MjbNativeMethods.mjaccess_batched_render_setup(Handle, groupMask);
+            if (n < 0) throw new InvalidOperationException("Failed to set up render batches");
+            var batches = new MjbRenderBatch[n];
+            fixed (MjbRenderBatch* b = batches)
+                MjbNativeMethods.mjaccess_batched_render_batches(Handle, b, n);
+            return batches;
+        }
+
+        /// <summary>Geom ids of all render batches, in batch order.</summary>
+        public unsafe int[] GetRenderGeoms()
+        {
+            ThrowIfDisposed();
+            int n = MjbNativeMethods.mjaccess_batched_render_geoms(Handle, null, 0);
+            var geoms = new int[n];
+            fixed (int* g = geoms)
+                MjbNativeMethods.mjaccess_batched_render_geoms(Handle, g, n);
+            return geoms;
+        }
+
+        /// <summary>
+        /// Write a column-major Unity 4x4 matrix per batched geom of each env in
+        /// <paramref name="envs"/> (null = the first <paramref name="envCount"/> envs) to
+        /// <paramref name="matrices"/>, which holds <paramref name="capacity"/> matrices. Each env
+        /// is offset by its cell of <paramref name="grid"/>. Runs on the worker pool; returns the
+        /// number of matrices written.
+        /// </summary>
+        public unsafe int WriteRenderMatrices(int[] envs, int envCount, in MjbRenderGrid grid,
+            float* matrices, int capacity)
+        {
+            ThrowIfDisposed();
+            if (envs != null && envCount > envs.Length)
+                throw new ArgumentOutOfRangeException(nameof(envCount));
+            int written;
+            fixed (int* e = envs)
+            fixed (MjbRenderGrid* g = &grid)
+                written = MjbNativeMethods.mjaccess_batched_render_matrices(
+                    Handle, e, envCount, g, matrices, capacity);
+            if (written < 0)
+                throw new ArgumentException("Invalid env index or matrix buffer too small");
+            return written;
+        }
+
+        public unsafe int WriteRenderMatrices(int[] envs, int envCount, in MjbRenderGrid grid,
+            float[] matrices)
+        {
+            fixed (float* m = matrices)
+                return WriteRenderMatrices(envs, envCount, grid, m, matrices.Length / 16);
+        }
+
+        // ── Output buffers (filled by the step workers) ──────────────
+
+        /// <summary>
+        /// Bind a caller-owned double[numEnvs * dim] destination for <paramref name="field"/>.
+        /// Every Step/Reset then writes each env's row from the worker that stepped it,
+        /// so no CacheState/gather is needed. The memory must stay valid until unbound
+        /// (e.g. NativeArray.GetUnsafePtr()).
+        /// </summary>
+        public unsafe void BindOutput(MjbBatchedField field, double* dst, int length)
+        {
+            ThrowIfDisposed();
+            // a failed bind keeps the previous buffer, so its pin must outlive the call
+            if (MjbNativeMethods.mjaccess_batched_bind_output(Handle, (int)field, dst, length) != 0)
+                throw new ArgumentException($"Output buffer for {field} is too small ({length})");
+            ReleaseOutputPin(field);
+        }
+
+        /// <summary>Bind a managed array as output; it stays pinned until unbound or disposed.</summary>
+        public unsafe void BindOutput(MjbBatchedField field, double[] dst)
+        {
+            if (dst == null) throw new ArgumentNullException(nameof(dst));
+            var pin = GCHandle.Alloc(dst, GCHandleType.Pinned);
+            try
+            {
+                BindOutput(field, (double*)pin.AddrOfPinnedObject(), dst.Length);
+            }
+            catch
+            {
+                pin.Free();
+                throw;
+            }
+            _outputPins[(int)field] = pin;
+        }
+
+        public unsafe void UnbindOutput(MjbBatchedField field)
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_bind_output(Handle, (int)field, null, 0);
+            ReleaseOutputPin(field);
+        }
+
+        public void ClearOutputs()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_batched_clear_outputs(Handle);
+            ReleaseOutputPins();
+        }
+
+        public uint OutputMask
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_batched_output_mask(Handle);
+            }
+        }
+
+        private void ReleaseOutputPin(MjbBatchedField field)
+        {
+            ref GCHandle pin = ref _outputPins[(int)field];
+            if (pin.IsAllocated) pin.Free();
+        }
+
+        private void ReleaseOutputPins()
+        {
+            for (int i = 0; i < _outputPins.Length; i++)
+                if (_outputPins[i].IsAllocated) _outputPins[i].Free();
+        }
+
         // ── Per-env state setters ─────────────────────────────────────
 
         public unsafe void SetEnvQpos(int envIndex, double[] qpos)
@@ -66,6 +756,114 @@ namespace Mujoco.Mjb
                 MjbNativeMethods.mjaccess_batched_set_env_qvel(Handle, envIndex, p, qvel.Length);
         }
 
+        /// <summary>
+        /// Stage writes into one data array (any MjbPhysicsCommand but Reset) of several envs:
+        /// values is [envs.Length][elems.Length], or [envs.Length][array size] when elems is
+        /// null. The workers apply them before the next step or reset, including to envs that
+        /// step does not advance. The step's ctrl still overwrites Ctrl for the envs it steps.
+        /// </summary>
+        public unsafe void Scatter(MjbPhysicsCommand field, int[] envs, int[] elems, double[] values)
+        {
+            ThrowIfDisposed();
+            if (envs == null || values == null) throw new ArgumentNullException(envs == null ? nameof(envs) : nameof(values));
+            int n = elems?.Length ?? ScatterSize(field);
+            if (values.Length < envs.Length * n)
+                throw new ArgumentException("Values do not cover every env and element");
+            fixed (int* e = envs)
+            fixed (int* i = elems)
+            fixed (double* v = values)
+            {
+                if (MjbNativeMethods.mjaccess_batched_scatter(Handle, (int)field, e, envs.Length, i,
+                        elems?.Length ?? 0, v) != 0)
+                    throw new ArgumentException("Invalid field, index, or repeated env");
+            }
+        }
+
+        /// <summary>Stage one element of one env's data array.</summary>
+        public unsafe void Scatter(MjbPhysicsCommand field, int envIndex, int elem, double value)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_batched_scatter(Handle, (int)field, &envIndex, 1, &elem, 1,
+                    &value) != 0)
+                throw new ArgumentOutOfRangeException(nameof(elem));
+        }
+
+        private int ScatterSize(MjbPhysicsCommand field)
+        {
+            switch (field)
+            {
+                case MjbPhysicsCommand.Ctrl: return ModelInfo.nu;
+                case MjbPhysicsCommand.Qpos: return ModelInfo.nq;
+                case MjbPhysicsCommand.Qvel:
+                case MjbPhysicsCommand.QfrcApplied: return ModelInfo.nv;
+                case MjbPhysicsCommand.Act: return ModelInfo.na;
+                case MjbPhysicsCommand.MocapPos: return ModelInfo.nmocap * 3;
+                case MjbPhysicsCommand.MocapQuat: return ModelInfo.nmocap * 4;
+                case MjbPhysicsCommand.XfrcApplied: return ModelInfo.nbody * 6;
+                default: throw new ArgumentOutOfRangeException(nameof(field));
+            }
+        }
+
+        // ── Active envs ──────────────────────────────────────────────
+
+        /// <summary>
+        /// Persistent active mask ([NumEnvs], nonzero = active; null = all). Steps skip
+        /// inactive envs entirely. Returns the active count.
+        /// </summary>
+        public unsafe int SetActive(int[] activeMask)
+        {
+            ThrowIfDisposed();
+            if (activeMask != null && activeMask.Length < NumEnvs)
+                throw new ArgumentException($"Active mask must hold {NumEnvs} entries");
+            int n;
+            fixed (int* p = activeMask)
+                n = MjbNativeMethods.mjaccess_batched_set_active(Handle, p);
+            if (n < 0) throw new OutOfMemoryException("Failed to allocate the active mask");
+            return n;
+        }
+
+        public int SetEnvActive(int envIndex, bool active)
+        {
+            ThrowIfDisposed();
+            int n = MjbNativeMethods.mjaccess_batched_set_env_active(Handle, envIndex, active ? 1 : 0);
+            if (n < 0) throw new ArgumentOutOfRangeException(nameof(envIndex));
+            return n;
+        }
+
+        /// <summary>Ascending active env indices; row k of an active gather is env data[k].</summary>
+        public unsafe void GetActiveEnvs(out int* data, out int length)
+        {
+            ThrowIfDisposed();
+            int n;
+            data = MjbNativeMethods.mjaccess_batched_get_active(Handle, &n);
+            length = n;
+        }
+
+        /// <summary>Pack the active envs' rows of a field into dst; returns the row count.</summary>
+        public unsafe int GatherActive(MjbBatchedField field, double[] dst)
+        {
+            ThrowIfDisposed();
+            fixed (double* p = dst)
+            {
+                int rows = MjbNativeMethods.mjaccess_batched_gather_active(Handle, (int)field, p,
+                    dst?.Length ?? 0);
+                if (rows < 0) throw new ArgumentException("Destination is too small for the active rows");
+                return rows;
+            }
+        }
+
+        public unsafe int GatherActiveObservation(float[] dst)
+        {
+            ThrowIfDisposed();
+            fixed (float* p = dst)
+            {
+                int rows = MjbNativeMethods.mjaccess_batched_gather_obs_active(Handle, p, dst?.Length ?? 0);
+                if (rows < 0)
+                    throw new ArgumentException("Destination is too small, or no observation plan is set");
+                return rows;
+            }
+        }
+
         // ── Batched state getters (double[numEnvs * dim]) ────────────
 
         public unsafe MjbDoubleSpan GetQpos()
@@ -84,6 +882,13 @@ namespace Mujoco.Mjb
             return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_qvel(Handle, &n), n);
         }
 
+        public unsafe MjbDoubleSpan GetCtrl()
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_ctrl(Handle, &n), n);
+        }
+
         public unsafe MjbDoubleSpan GetXpos()
         {
             if (_cached) return _cXpos;
@@ -92,6 +897,13 @@ namespace Mujoco.Mjb
             return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_xpos(Handle, &n), n);
         }
 
+        public unsafe MjbDoubleSpan GetXquat()
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_xquat(Handle, &n), n);
+        }
+
         public unsafe MjbDoubleSpan GetSubtreeCom()
         {
             if (_cached) return _cSubtreeCom;
@@ -132,6 +944,34 @@ namespace Mujoco.Mjb
             return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_cfrc_ext(Handle, &n), n);
         }
 
+        public unsafe MjbDoubleSpan GetSensordata()
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_sensordata(Handle, &n), n);
+        }
+
+        public unsafe MjbDoubleSpan GetGeomXpos()
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_geom_xpos(Handle, &n), n);
+        }
+
+        public unsafe MjbDoubleSpan GetGeomXmat()
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_geom_xmat(Handle, &n), n);
+        }
+
+        public unsafe MjbDoubleSpan GetField(MjbBatchedField field)
+        {
+            ThrowIfDisposed();
+            int n;
+            return new MjbDoubleSpan(MjbNativeMethods.mjaccess_batched_get_field(Handle, (int)field, &n), n);
+        }
+
         private void ThrowIfDisposed()
         {
             if (_disposed) throw new ObjectDisposedException(nameof(MjbBatchedSim));
@@ -141,9 +981,10 @@ namespace Mujoco.Mjb
         {
             if (!_disposed && Handle != IntPtr.Zero)
             {
-                MjbNativeMethods.mjaccess_batched_free(Handle);
+                if (_ownsHandle) MjbNativeMethods.mjaccess_batched_free(Handle);
                 Handle = IntPtr.Zero;
                 _disposed = true;
+                ReleaseOutputPins();
             }
         }
     }
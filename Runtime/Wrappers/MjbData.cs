@@ -25,6 +25,13 @@ namespace Mujoco.Mjb
             MjbNativeMethods.mjaccess_step(_model.Handle, Handle);
         }
 
+        /// <summary>Run <paramref name="nSubsteps"/> mj_step calls in one native call.</summary>
+        public void Step(int nSubsteps)
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_step_n(_model.Handle, Handle, nSubsteps);
+        }
+
         public void Forward()
         {
             ThrowIfDisposed();
@@ -349,6 +356,161 @@ namespace Mujoco.Mjb
             return MjbNativeMethods.mjaccess_get_warning_count(Handle, index);
         }
 
+        // ── Profiling ────────────────────────────────────────────────
+
+        /// <summary>
+        /// Install (or release) the process-wide clock MuJoCo needs to fill its
+        /// per-stage timers. Calls are counted and shared with batched profiling.
+        /// </summary>
+        public static void EnableTimers(bool enabled)
+        {
+            MjbNativeMethods.mjaccess_profile_timers(enabled ? 1 : 0);
+        }
+
+        /// <summary>Stage timers since the last ResetProfile (or reset), plus current contact counts.</summary>
+        public unsafe MjbProfile GetProfile()
+        {
+            ThrowIfDisposed();
+            MjbProfile profile;
+            MjbNativeMethods.mjaccess_get_profile(Handle, &profile);
+            return profile;
+        }
+
+        public void ResetProfile()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_reset_profile(Handle);
+        }
+
+        // ── Bulk transforms ──────────────────────────────────────────
+
+        /// <summary>
+        /// Bind frames (mjOBJ_BODY, mjOBJ_XBODY, mjOBJ_GEOM or mjOBJ_SITE ids) for
+        /// <see cref="ExportTransforms"/>. offsets (7 floats per frame in MjbPose layout,
+        /// may be null) are Unity-space local offsets composed on the right of each frame.
+        /// </summary>
+        public unsafe void BindTransforms(int[] objectTypes, int[] ids, float[] offsets = null)
+        {
+            ThrowIfDisposed();
+            if (objectTypes.Length != ids.Length || (offsets != null && offsets.Length != ids.Length * 7))
+                throw new ArgumentException("BindTransforms arrays differ in length");
+            fixed (int* t = objectTypes)
+            fixed (int* i = ids)
+            fixed (float* o = offsets)
+            {
+                if (MjbNativeMethods.mjaccess_bind_transforms(Handle, t, i, o, ids.Length) != 0)
+                    throw new ArgumentException("Invalid object type or id in BindTransforms");
+            }
+        }
+
+        /// <summary>Write the Unity-space poses of all bound frames; returns the count.</summary>
+        public unsafe int ExportTransforms(MjbPose* poses, int length)
+        {
+            ThrowIfDisposed();
+            int n = MjbNativeMethods.mjaccess_export_transforms(Handle, poses, length);
+            if (n < 0) throw new ArgumentException($"Pose buffer too small ({length})");
+            return n;
+        }
+
+        // ── Contacts ─────────────────────────────────────────────────
+
+        /// <summary>
+        /// Replace one side (0 or 1) of the contact filter with geoms (mjOBJ_GEOM) or all geoms
+        /// of bodies (mjOBJ_BODY); an empty list matches everything. A contact is exported when
+        /// one geom is in side 0 and the other in side 1.
+        /// </summary>
+        public unsafe void SetContactFilter(int side, mjtObj objectType, int[] ids)
+        {
+            ThrowIfDisposed();
+            fixed (int* p = ids)
+            {
+                if (MjbNativeMethods.mjaccess_contact_filter(Handle, side, (int)objectType, p,
+                        ids?.Length ?? 0) != 0)
+                    throw new ArgumentException("Invalid contact filter side, type or id");
+            }
+        }
+
+        /// <summary>Write up to <paramref name="capacity"/> filtered contacts; returns how many passed.</summary>
+        public unsafe int ExportContacts(MjbContact* contacts, int capacity)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_export_contacts(Handle, contacts, capacity);
+        }
+
+        public unsafe int ExportContacts(MjbContact[] contacts)
+        {
+            fixed (MjbContact* p = contacts)
+                return ExportContacts(p, contacts.Length);
+        }
+
+        // ── Full state (mj_getState / mj_setState) ───────────────────
+
+        public unsafe double[] GetState(mjtState spec)
+        {
+            ThrowIfDisposed();
+            var state = new double[_model.StateSize(spec)];
+            fixed (double* p = state)
+                MjbNativeMethods.mjaccess_get_state(Handle, (uint)spec, p);
+            return state;
+        }
+
+        public unsafe void SetState(mjtState spec, double[] state)
+        {
+            ThrowIfDisposed();
+            if (state.Length < _model.StateSize(spec))
+                throw new ArgumentException("State is shorter than the spec's size");
+            fixed (double* p = state)
+                MjbNativeMethods.mjaccess_set_state(Handle, (uint)spec, p);
+        }
+
+        // ── Derivatives ──────────────────────────────────────────────
+
+        /// <summary>Size the worker pool used by <see cref="TransitionFD"/> (0 = one per CPU).</summary>
+        public int SetTransitionFDThreads(int numThreads)
+        {
+            ThrowIfDisposed();
+            int n = MjbNativeMethods.mjaccess_transition_fd_threads(Handle, numThreads);
+            if (n < 0) throw new InvalidOperationException("Failed to create the derivative worker pool");
+            return n;
+        }
+
+        /// <summary>
+        /// Finite-difference transition Jacobians around the current state, laid out as
+        /// mjd_transitionFD: A (nx x nx, nx = 2 nv + na), B (nx x nu), C (nsensordata x nx) and
+        /// D (nsensordata x nu), row-major, any may be null. Columns are computed in parallel on
+        /// scratch data; this data is not modified.
+        /// </summary>
+        public unsafe void TransitionFD(double eps, bool centered, double* A, double* B,
+            double* C, double* D)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_transition_fd(_model.Handle, Handle, eps, centered ? 1 : 0,
+                    A, B, C, D) != 0)
+                throw new InvalidOperationException("TransitionFD failed");
+        }
+
+        public unsafe void TransitionFD(double eps, bool centered, double[] A, double[] B,
+            double[] C = null, double[] D = null)
+        {
+            CheckJacobianSizes(_model.Info, 1, A, B, C, D);
+            fixed (double* a = A)
+            fixed (double* b = B)
+            fixed (double* c = C)
+            fixed (double* d = D)
+                TransitionFD(eps, centered, a, b, c, d);
+        }
+
+        internal static void CheckJacobianSizes(MjbModelInfo info, int numEnvs, double[] A,
+            double[] B, double[] C, double[] D)
+        {
+            int nx = 2 * info.nv + info.na;
+            if ((A != null && A.Length < numEnvs * nx * nx) ||
+                (B != null && B.Length < numEnvs * nx * info.nu) ||
+                (C != null && C.Length < numEnvs * info.nsensordata * nx) ||
+                (D != null && D.Length < numEnvs * info.nsensordata * info.nu))
+                throw new ArgumentException("Jacobian buffer too small");
+        }
+
         // ── Mocap setters ────────────────────────────────────────────
 
         public unsafe void SetMocapPos(double[] pos)
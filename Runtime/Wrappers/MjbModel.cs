@@ -33,6 +33,41 @@ namespace Mujoco.Mjb
             return new MjbModel(h);
         }
 
+        /// <summary>
+        /// Compile a model that keeps its mjSpec, so bodies/geoms can be edited and
+        /// recompiled in place with <see cref="Recompile"/>.
+        /// </summary>
+        public static MjbModel LoadEditable(string xmlString)
+        {
+            IntPtr h = MjbNativeMethods.mjaccess_load_model_editable(xmlString);
+            if (h == IntPtr.Zero)
+                throw new InvalidOperationException("Failed to load editable model from XML string");
+            return new MjbModel(h);
+        }
+
+        /// <summary>
+        /// Cache compiled models in <paramref name="directory"/>, keyed by a hash of the XML,
+        /// so repeated loads skip the compiler. Null or empty disables the cache. The setting is
+        /// process-wide; models loaded from the cache cannot SaveLastXml.
+        /// </summary>
+        public static void SetCacheDirectory(string directory)
+        {
+            if (MjbNativeMethods.mjaccess_model_cache_set_dir(directory) != 0)
+                throw new ArgumentException($"Cache directory path is too long: {directory}");
+        }
+
+        /// <summary>Process-wide cache hits/misses and compile/load time.</summary>
+        public static MjbModelCacheStats CacheStats
+        {
+            get
+            {
+                MjbNativeMethods.mjaccess_model_cache_get_stats(out var stats);
+                return stats;
+            }
+        }
+
+        public static void ResetCacheStats() => MjbNativeMethods.mjaccess_model_cache_reset_stats();
+
         public MjbModelInfo Info
         {
             get
@@ -42,6 +77,13 @@ namespace Mujoco.Mjb
             }
         }
 
+        /// <summary>Size in doubles of an mj_getState vector for <paramref name="spec"/>.</summary>
+        public int StateSize(mjtState spec)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_state_size(Handle, (uint)spec);
+        }
+
         public double Timestep
         {
             get
@@ -176,6 +218,10 @@ namespace Mujoco.Mjb
             }
         }
 
+        /// <summary>
+        /// Save the last MJCF parsed by the compiler. Throws for models loaded from the
+        /// compiled-model cache, which parse no XML.
+        /// </summary>
         public void SaveLastXml(string path)
         {
             ThrowIfDisposed();
@@ -192,6 +238,24 @@ namespace Mujoco.Mjb
                 MjbNativeMethods.mjaccess_model_set_hfield_data(Handle, offset, p, values.Length);
         }
 
+        /// <summary>
+        /// Write a rows x cols block of hfield <paramref name="hfieldId"/> at (row, col);
+        /// consecutive source rows are <paramref name="stride"/> floats apart (0 = cols).
+        /// </summary>
+        public unsafe void SetHfieldRect(int hfieldId, int row, int col, int rows, int cols,
+            float[] values, int stride = 0)
+        {
+            ThrowIfDisposed();
+            if (values == null || values.Length < (rows - 1) * Math.Max(stride, cols) + cols)
+                throw new ArgumentException("Values do not cover the rectangle");
+            fixed (float* p = values)
+            {
+                if (MjbNativeMethods.mjaccess_model_set_hfield_rect(Handle, hfieldId, row, col, rows,
+                        cols, p, stride) != 0)
+                    throw new ArgumentOutOfRangeException(nameof(row), "Rectangle outside the hfield");
+            }
+        }
+
         public static void LoadPluginLibrary(string path)
         {
             MjbNativeMethods.mjaccess_load_plugin_library(path);
@@ -205,6 +269,121 @@ namespace Mujoco.Mjb
                 MjbNativeMethods.mjaccess_object_velocity(Handle, data.Handle, objtype, objid, flgLocal, p);
         }
 
+        // ── Incremental scene edits ──────────────────────────────────
+
+        public bool IsEditable
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_model_is_editable(Handle) != 0;
+            }
+        }
+
+        /// <summary>Remove a named element (and its subtree) from the spec.</summary>
+        public void DeleteElement(mjtObj objType, string name)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_spec_delete(Handle, (int)objType, name) != 0)
+                throw new ArgumentException($"Cannot delete {objType} '{name}'");
+        }
+
+        /// <summary>Add a body under <paramref name="parent"/> (null = world).</summary>
+        public unsafe void AddBody(string parent, string name, double[] pos = null, double[] quat = null)
+        {
+            ThrowIfDisposed();
+            int rc;
+            fixed (double* p = pos)
+            fixed (double* q = quat)
+                rc = MjbNativeMethods.mjaccess_spec_add_body(Handle, parent, name, p, q);
+            if (rc != 0)
+                throw new ArgumentException($"Cannot add body '{name}' under '{parent ?? "world"}'");
+        }
+
+        public unsafe void AddGeom(string body, string name, int geomType, double[] size, double[] pos = null)
+        {
+            ThrowIfDisposed();
+            int rc;
+            fixed (double* s = size)
+            fixed (double* p = pos)
+                rc = MjbNativeMethods.mjaccess_spec_add_geom(Handle, body, name, geomType, s, p);
+            if (rc != 0)
+                throw new ArgumentException($"Cannot add geom to body '{body}'");
+        }
+
+        /// <summary>Set the leading values of a body/geom/site attribute in the spec.</summary>
+        public unsafe void SetSpecAttribute(mjtObj objType, string name, MjbSpecAttr attr, params double[] values)
+        {
+            ThrowIfDisposed();
+            int rc;
+            fixed (double* v = values)
+                rc = MjbNativeMethods.mjaccess_spec_set_attr(Handle, (int)objType, name, (int)attr, v,
+                                                             values?.Length ?? 0);
+            if (rc != 0)
+                throw new ArgumentException($"Cannot set {attr} of {objType} '{name}'");
+        }
+
+        /// <summary>
+        /// Apply pending spec edits: rebuilds this model and <paramref name="data"/> in place,
+        /// keeping the state of elements that survived the edit. Fails while batched sims,
+        /// multi-sim groups or terrains made from this model are alive; see Reload.
+        /// </summary>
+        public void Recompile(MjbData data)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_spec_recompile(Handle, data.Handle) != 0)
+                throw new InvalidOperationException("Recompiling the edited spec failed, see log for details");
+        }
+
+        /// <summary>
+        /// Replace this model and <paramref name="data"/> with ones compiled from new MJCF,
+        /// keeping both handles. Joint qpos/qvel are mapped by joint name from
+        /// oldQpos/oldQvel (null: the data's current state). On failure the old model stays.
+        /// Handles made from this model:
+        /// <list type="bullet">
+        /// <item>MjbBatchedSim, MjbMultiSim groups and MjbTerrain block the reload (it throws)
+        /// until they are disposed.</item>
+        /// <item>MjbRollout follows the model and rebuilds on its next call, clearing its cost.</item>
+        /// <item>Other MjbData made from this model become invalid.</item>
+        /// <item>An MjbPhysicsThread on <paramref name="data"/> must be disposed first.</item>
+        /// </list>
+        /// The data's contact filter and finite-difference scratch are dropped.
+        /// </summary>
+        public unsafe void Reload(MjbData data, string xmlString, double[] oldQpos = null, double[] oldQvel = null)
+        {
+            ThrowIfDisposed();
+            int rc;
+            fixed (double* q = oldQpos)
+            fixed (double* v = oldQvel)
+                rc = MjbNativeMethods.mjaccess_model_reload(Handle, data.Handle, xmlString, q, v);
+            if (rc != 0)
+                throw new InvalidOperationException("Model reload failed, see log for details");
+        }
+
+        /// <summary>
+        /// Reload like <see cref="Reload"/>, but pair joints explicitly: the joint named
+        /// jointNames[i] in the new model takes the state of old joint id oldJointIds[i], and
+        /// joints not listed start at qpos0. Use it when generated names are not stable
+        /// across the rebuild.
+        /// </summary>
+        public unsafe void Reload(MjbData data, string xmlString, double[] oldQpos, double[] oldQvel,
+                                  string[] jointNames, int[] oldJointIds)
+        {
+            ThrowIfDisposed();
+            if (jointNames == null || oldJointIds == null || jointNames.Length != oldJointIds.Length)
+                throw new ArgumentException("jointNames and oldJointIds must have the same length");
+            int rc;
+            var ids = oldJointIds.Length > 0 ? oldJointIds : new int[1];
+            fixed (double* q = oldQpos)
+            fixed (double* v = oldQvel)
+            fixed (int* j = ids)
+                rc = MjbNativeMethods.mjaccess_model_reload_mapped(Handle, data.Handle, xmlString,
+                                                                   q, v, jointNames, j,
+                                                                   oldJointIds.Length);
+            if (rc != 0)
+                throw new InvalidOperationException("Model reload failed, see log for details");
+        }
+
         public MjbData MakeData()
         {
             ThrowIfDisposed();
@@ -220,7 +399,7 @@ namespace Mujoco.Mjb
             IntPtr h = MjbNativeMethods.mjaccess_batched_create(Handle, ref config);
             if (h == IntPtr.Zero)
                 throw new InvalidOperationException("Failed to create MjbBatchedSim");
-            return new MjbBatchedSim(h);
+            return new MjbBatchedSim(h, Info, config.numEnvs);
         }
 
         private void ThrowIfDisposed()
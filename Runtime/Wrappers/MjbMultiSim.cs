@@ -0,0 +1,104 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using System.Collections.Generic;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>
+    /// Env groups built from different models, stepped in one parallel dispatch on a
+    /// shared worker pool and balanced by each group's measured step cost. Each group
+    /// is an <see cref="MjbBatchedSim"/> for gathers, outputs, observations and resets;
+    /// it is owned by this sim and cannot step asynchronously.
+    /// </summary>
+    public sealed class MjbMultiSim : IDisposable
+    {
+        internal IntPtr Handle { get; private set; }
+        private bool _disposed;
+        private readonly List<MjbBatchedSim> _groups = new List<MjbBatchedSim>();
+
+        /// <summary>Pool settings come from numThreads, chunkSize, pinThreads and cpuOffset.</summary>
+        public MjbMultiSim(MjbBatchedConfig poolConfig)
+        {
+            Handle = MjbNativeMethods.mjaccess_multi_create(ref poolConfig);
+            if (Handle == IntPtr.Zero)
+                throw new InvalidOperationException("Failed to create MjbMultiSim");
+        }
+
+        /// <summary>
+        /// Add numEnvs envs of <paramref name="model"/> (solverIterations and
+        /// contiguousState also apply); returns the group index.
+        /// </summary>
+        public int AddGroup(MjbModel model, MjbBatchedConfig config)
+        {
+            ThrowIfDisposed();
+            int group = MjbNativeMethods.mjaccess_multi_add_group(Handle, model.Handle, ref config);
+            if (group < 0)
+                throw new InvalidOperationException("Failed to add group to MjbMultiSim");
+            _groups.Add(new MjbBatchedSim(MjbNativeMethods.mjaccess_multi_group(Handle, group),
+                model.Info, config.numEnvs, false));
+            return group;
+        }
+
+        public int GroupCount => _groups.Count;
+
+        public MjbBatchedSim GetGroup(int group)
+        {
+            ThrowIfDisposed();
+            return _groups[group];
+        }
+
+        public int NumThreads
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_multi_num_threads(Handle);
+            }
+        }
+
+        /// <summary>Start of a group's [numEnvs * nu] block in the Step ctrl array.</summary>
+        public int GetCtrlOffset(int group)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_multi_ctrl_offset(Handle, group);
+        }
+
+        /// <summary>Length of the Step ctrl array (every group's block back to back).</summary>
+        public int CtrlSize => GetCtrlOffset(_groups.Count);
+
+        /// <summary>Smoothed step cost of a group in ns per env substep (0 before its first step).</summary>
+        public double GetGroupCost(int group)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_multi_group_cost(Handle, group);
+        }
+
+        public unsafe void Step(double[] ctrl, int nSubsteps = 1)
+        {
+            ThrowIfDisposed();
+            if (ctrl == null || ctrl.Length < CtrlSize)
+                throw new ArgumentException($"ctrl must hold {CtrlSize} values");
+            fixed (double* p = ctrl)
+                MjbNativeMethods.mjaccess_multi_step(Handle, p, nSubsteps);
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_disposed) throw new ObjectDisposedException(nameof(MjbMultiSim));
+        }
+
+        public void Dispose()
+        {
+            if (!_disposed && Handle != IntPtr.Zero)
+            {
+                foreach (var g in _groups) g.Dispose();
+                _groups.Clear();
+                MjbNativeMethods.mjaccess_multi_free(Handle);
+                Handle = IntPtr.Zero;
+                _disposed = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>
+    /// Steps an MjbData on a native thread paced to wall time and publishes a snapshot of
+    /// the bound transforms and sensordata after every step. While it runs only the thread
+    /// touches the data: queue inputs with Command, or hold Lock() for direct access.
+    /// Unsupported without pthreads (Windows), where the constructor throws.
+    /// </summary>
+    public sealed class MjbPhysicsThread : IDisposable
+    {
+        private IntPtr _handle;
+
+        public MjbPhysicsThread(MjbData data, MjbPhysicsConfig config = default)
+        {
+            if (data == null) throw new ArgumentNullException(nameof(data));
+            _handle = MjbNativeMethods.mjaccess_physics_start(data.Handle, ref config);
+            if (_handle == IntPtr.Zero)
+                throw new PlatformNotSupportedException("Failed to start the physics thread");
+        }
+
+        /// <summary>Queue values for [offset, offset + length) of a data array, applied before the next step.</summary>
+        public unsafe void Command(MjbPhysicsCommand type, int offset, double[] values)
+        {
+            ThrowIfDisposed();
+            if (values == null) throw new ArgumentNullException(nameof(values));
+            fixed (double* p = values)
+            {
+                if (MjbNativeMethods.mjaccess_physics_command(_handle, (int)type, offset, p, values.Length) != 0)
+                    throw new ArgumentOutOfRangeException(nameof(offset), "Command outside the data array");
+            }
+        }
+
+        public unsafe void SetCtrl(int index, double value)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_physics_command(_handle, (int)MjbPhysicsCommand.Ctrl, index, &value, 1) != 0)
+                throw new ArgumentOutOfRangeException(nameof(index));
+        }
+
+        /// <summary>Reset to a keyframe, or to the model defaults when key is -1.</summary>
+        public unsafe void Reset(int key = -1)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_physics_command(_handle, (int)MjbPhysicsCommand.Reset, key, null, 0) != 0)
+                throw new ArgumentOutOfRangeException(nameof(key));
+        }
+
+        /// <summary>
+        /// The two newest snapshots held by the reader (main thread only); returns true if a
+        /// new one arrived since the last call.
+        /// </summary>
+        public unsafe bool Latest(out MjbPhysicsFrame prev, out MjbPhysicsFrame cur)
+        {
+            ThrowIfDisposed();
+            MjbPhysicsFrame a, b;
+            int fresh = MjbNativeMethods.mjaccess_physics_latest(_handle, &a, &b);
+            prev = a;
+            cur = b;
+            return fresh == 1;
+        }
+
+        /// <summary>Bound poses blended between the held snapshots at render time (main thread only).</summary>
+        public unsafe int Interpolate(MjbPose* output, int n)
+        {
+            ThrowIfDisposed();
+            int count = MjbNativeMethods.mjaccess_physics_interpolate(_handle, output, n);
+            if (count < 0) throw new ArgumentException("Output holds fewer poses than are bound");
+            return count;
+        }
+
+        /// <summary>Exclusive access to the data between two steps; dispose to release.</summary>
+        public LockScope Lock()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_physics_lock(_handle);
+            return new LockScope(_handle);
+        }
+
+        public readonly struct LockScope : IDisposable
+        {
+            private readonly IntPtr _handle;
+
+            internal LockScope(IntPtr handle) { _handle = handle; }
+
+            public void Dispose() => MjbNativeMethods.mjaccess_physics_unlock(_handle);
+        }
+
+        public bool Paused
+        {
+            set
+            {
+                ThrowIfDisposed();
+                MjbNativeMethods.mjaccess_physics_set_paused(_handle, value ? 1 : 0);
+            }
+        }
+
+        /// <summary>First mjtWarning raised since start (stepping then stops), or -1.</summary>
+        public int Error => _handle == IntPtr.Zero ? -1 : MjbNativeMethods.mjaccess_physics_error(_handle);
+
+        public long Steps => _handle == IntPtr.Zero ? 0 : MjbNativeMethods.mjaccess_physics_steps(_handle);
+
+        private void ThrowIfDisposed()
+        {
+            if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MjbPhysicsThread));
+        }
+
+        /// <summary>Joins the thread; the data is the caller's again afterwards.</summary>
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                MjbNativeMethods.mjaccess_physics_stop(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>
+    /// Sequential reader for files written by <see cref="MjbBatchedSim.StartRecording"/>.
+    /// Each frame is one step job; ReadFrame decodes it into a numEnvs * rowBytes buffer,
+    /// writing only the rows of the envs the frame covers.
+    /// </summary>
+    public sealed class MjbRecordReader : IDisposable
+    {
+        private IntPtr _handle;
+        public MjbRecordInfo Info { get; }
+
+        public MjbRecordReader(string path)
+        {
+            _handle = MjbNativeMethods.mjaccess_record_open(path, out var info);
+            if (_handle == IntPtr.Zero)
+                throw new System.IO.IOException($"Failed to open recording '{path}'");
+            Info = info;
+        }
+
+        public int FrameBytes => Info.numEnvs * Info.rowBytes;
+
+        /// <summary>Decode the next frame; returns false at the end of the file.</summary>
+        public unsafe bool ReadFrame(byte[] rows, out long frame, out int envFirst, out int envCount)
+        {
+            if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MjbRecordReader));
+            if (rows == null || rows.Length < FrameBytes)
+                throw new ArgumentException($"rows must hold {FrameBytes} bytes");
+            int rc;
+            fixed (byte* p = rows)
+                rc = MjbNativeMethods.mjaccess_record_next(_handle, p, out frame, out envFirst, out envCount);
+            if (rc < 0) throw new System.IO.InvalidDataException("Corrupt recording");
+            return rc == 1;
+        }
+
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                MjbNativeMethods.mjaccess_record_close(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>
+    /// Native rollout engine for sampling-based MPC (MPPI, CEM). One call branches a start
+    /// state into many control sequences and runs each start to finish on one worker of the
+    /// engine's pool, so replanning costs one fork/join instead of one per step. It follows
+    /// its model through Recompile and Reload.
+    /// </summary>
+    public sealed class MjbRollout : IDisposable
+    {
+        private IntPtr _handle;
+        private readonly MjbModel _model;
+
+        public MjbRollout(MjbModel model, MjbRolloutConfig config = default)
+        {
+            _model = model ?? throw new ArgumentNullException(nameof(model));
+            _handle = MjbNativeMethods.mjaccess_rollout_create(model.Handle, ref config);
+            if (_handle == IntPtr.Zero)
+                throw new InvalidOperationException("Failed to create MjbRollout");
+        }
+
+        public int NumThreads
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_rollout_num_threads(_handle);
+            }
+        }
+
+        /// <summary>Doubles per start state (startSpec).</summary>
+        public int StartStateSize
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return MjbNativeMethods.mjaccess_rollout_state_size(_handle, out _);
+            }
+        }
+
+        /// <summary>Doubles per recorded state (outSpec).</summary>
+        public int OutStateSize
+        {
+            get
+            {
+                ThrowIfDisposed();
+                MjbNativeMethods.mjaccess_rollout_state_size(_handle, out int n);
+                return n;
+            }
+        }
+
+        /// <summary>Install a diagonal quadratic cost; the arrays are copied.</summary>
+        public unsafe void SetCost(double[] qposWeight = null, double[] qvelWeight = null,
+            double[] ctrlWeight = null, double[] sensorWeight = null, double[] qposRef = null,
+            double[] qvelRef = null, double[] ctrlRef = null, double[] sensorRef = null,
+            double terminal = 0)
+        {
+            ThrowIfDisposed();
+            var info = _model.Info;
+            if ((qposRef != null && qposRef.Length < info.nq) ||
+                (qposWeight != null && qposWeight.Length < info.nv) ||
+                (qvelRef != null && qvelRef.Length < info.nv) ||
+                (qvelWeight != null && qvelWeight.Length < info.nv) ||
+                (ctrlRef != null && ctrlRef.Length < info.nu) ||
+                (ctrlWeight != null && ctrlWeight.Length < info.nu) ||
+                (sensorRef != null && sensorRef.Length < info.nsensordata) ||
+                (sensorWeight != null && sensorWeight.Length < info.nsensordata))
+                throw new ArgumentException("Cost array shorter than its model dimension");
+            fixed (double* qr = qposRef)
+            fixed (double* qw = qposWeight)
+            fixed (double* vr = qvelRef)
+            fixed (double* vw = qvelWeight)
+            fixed (double* ur = ctrlRef)
+            fixed (double* uw = ctrlWeight)
+            fixed (double* sr = sensorRef)
+            fixed (double* sw = sensorWeight)
+            {
+                var cost = new MjbRolloutCost
+                {
+                    qposRef = qr, qposWeight = qw, qvelRef = vr, qvelWeight = vw,
+                    ctrlRef = ur, ctrlWeight = uw, sensorRef = sr, sensorWeight = sw,
+                    terminal = terminal,
+                };
+                if (MjbNativeMethods.mjaccess_rollout_set_cost(_handle, &cost) != 0)
+                    throw new InvalidOperationException("Failed to set rollout cost");
+            }
+        }
+
+        public unsafe void ClearCost()
+        {
+            ThrowIfDisposed();
+            MjbNativeMethods.mjaccess_rollout_set_cost(_handle, null);
+        }
+
+        /// <summary>
+        /// Roll <paramref name="count"/> control sequences (ctrl [count][horizon][nu]) out from
+        /// <paramref name="startState"/>. Outputs may be null: states [count][horizon][OutStateSize],
+        /// sensors [count][horizon][nsensordata], costs [count] (0 without a cost, +inf if the
+        /// rollout diverged).
+        /// </summary>
+        public unsafe void Run(double* startState, int count, int horizon, double* ctrl,
+            double* states, double* sensors, double* costs)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_rollout(_handle, startState, count, horizon, ctrl,
+                    states, sensors, costs) != 0)
+                throw new ArgumentException("Invalid rollout arguments");
+        }
+
+        public unsafe void Run(double[] startState, int count, int horizon, double[] ctrl,
+            double[] states = null, double[] sensors = null, double[] costs = null)
+        {
+            ThrowIfDisposed();
+            var info = _model.Info;
+            long steps = (long)count * horizon;
+            if (startState.Length < StartStateSize || ctrl.Length < steps * info.nu ||
+                (states != null && states.Length < steps * OutStateSize) ||
+                (sensors != null && sensors.Length < steps * info.nsensordata) ||
+                (costs != null && costs.Length < count))
+                throw new ArgumentException("Rollout buffer too small");
+            fixed (double* s0 = startState)
+            fixed (double* u = ctrl)
+            fixed (double* x = states)
+            fixed (double* y = sensors)
+            fixed (double* c = costs)
+                Run(s0, count, horizon, u, x, y, c);
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MjbRollout));
+        }
+
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                MjbNativeMethods.mjaccess_rollout_free(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
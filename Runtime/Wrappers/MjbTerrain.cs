@@ -0,0 +1,109 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>
+    /// Pages a large world heightmap through one hfield of the model. Recentering moves
+    /// the window in whole tiles and copies only the newly exposed strips, so terrain size
+    /// does not affect memory or update cost. Call between steps: the hfield is model-wide.
+    /// The hfield geom must be unrotated and sit on the world body or on a static,
+    /// unrotated child of it.
+    /// </summary>
+    public sealed class MjbTerrain : IDisposable
+    {
+        private IntPtr _handle;
+
+        /// <param name="path">Raw float32 rows x cols heightmap, mapped copy-on-write;
+        /// null keeps a zeroed map in memory.</param>
+        public MjbTerrain(MjbModel model, MjbTerrainConfig config, string path = null)
+        {
+            if (model == null) throw new ArgumentNullException(nameof(model));
+            _handle = MjbNativeMethods.mjaccess_terrain_create(model.Handle, ref config, path);
+            if (_handle == IntPtr.Zero)
+                throw new InvalidOperationException("Failed to create MjbTerrain");
+            Rows = config.rows;
+            Cols = config.cols;
+        }
+
+        public int Rows { get; }
+        public int Cols { get; }
+
+        /// <summary>The world map (row = y) for bulk fills; call Refresh afterwards.</summary>
+        public unsafe MjbFloatSpan World
+        {
+            get
+            {
+                ThrowIfDisposed();
+                int rows, cols;
+                float* p = MjbNativeMethods.mjaccess_terrain_world(_handle, &rows, &cols);
+                return new MjbFloatSpan(p, rows * cols);
+            }
+        }
+
+        /// <summary>Window origin in world cells, (-1, -1) before the first Center.</summary>
+        public unsafe void GetWindow(out int row, out int col)
+        {
+            ThrowIfDisposed();
+            int r, c;
+            MjbNativeMethods.mjaccess_terrain_window(_handle, &r, &c);
+            row = r;
+            col = c;
+        }
+
+        /// <summary>Center on MuJoCo world (x, y); returns the hfield cells copied.</summary>
+        public int Center(double x, double y)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_terrain_center(_handle, x, y);
+        }
+
+        /// <summary>Center on the tracked body; returns the hfield cells copied.</summary>
+        public int Update(MjbData data)
+        {
+            ThrowIfDisposed();
+            int n = MjbNativeMethods.mjaccess_terrain_update(_handle, data.Handle);
+            if (n < 0) throw new InvalidOperationException("Terrain has no tracked body");
+            return n;
+        }
+
+        public int Refresh()
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_terrain_refresh(_handle);
+        }
+
+        /// <summary>
+        /// Write a dirty rectangle in world cells; the part inside the window also goes to
+        /// the hfield. Returns the hfield cells written.
+        /// </summary>
+        public unsafe int Write(int row, int col, int rows, int cols, float[] values, int stride = 0)
+        {
+            ThrowIfDisposed();
+            if (values == null || values.Length < (rows - 1) * Math.Max(stride, cols) + cols)
+                throw new ArgumentException("Values do not cover the rectangle");
+            fixed (float* p = values)
+            {
+                int n = MjbNativeMethods.mjaccess_terrain_write(_handle, row, col, rows, cols, p, stride);
+                if (n < 0) throw new ArgumentOutOfRangeException(nameof(row), "Rectangle outside the world map");
+                return n;
+            }
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MjbTerrain));
+        }
+
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                MjbNativeMethods.mjaccess_terrain_free(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>
+    /// Memory-mapped qpos trajectory for kinematic playback. Opening does not read the
+    /// frames, which are only paged in as they are applied, so multi-GB files open
+    /// instantly and use no managed memory.
+    /// </summary>
+    public sealed class MjbTrajectory : IDisposable
+    {
+        private IntPtr _handle;
+
+        public MjbTrajectory(string path)
+        {
+            _handle = MjbNativeMethods.mjaccess_traj_open(path);
+            if (_handle == IntPtr.Zero)
+                throw new System.IO.IOException($"Failed to open trajectory '{path}'");
+            FrameCount = MjbNativeMethods.mjaccess_traj_num_frames(_handle);
+            Nq = MjbNativeMethods.mjaccess_traj_nq(_handle);
+            StartTime = MjbNativeMethods.mjaccess_traj_time(_handle, 0);
+            EndTime = MjbNativeMethods.mjaccess_traj_time(_handle, FrameCount - 1);
+        }
+
+        public long FrameCount { get; }
+        public int Nq { get; }
+        public double StartTime { get; }
+        public double EndTime { get; }
+        public double Duration => EndTime - StartTime;
+
+        public double GetTime(long frame)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_traj_time(_handle, frame);
+        }
+
+        /// <summary>Fractional frame at <paramref name="time"/>, clamped to the trajectory.</summary>
+        public double Locate(double time)
+        {
+            ThrowIfDisposed();
+            return MjbNativeMethods.mjaccess_traj_locate(_handle, time);
+        }
+
+        /// <summary>qpos of a frame, read in place from the mapping.</summary>
+        public unsafe MjbDoubleSpan GetFrame(long frame)
+        {
+            ThrowIfDisposed();
+            double* p = MjbNativeMethods.mjaccess_traj_frame(_handle, frame);
+            if (p == null) throw new ArgumentOutOfRangeException(nameof(frame));
+            return new MjbDoubleSpan(p, Nq);
+        }
+
+        /// <summary>
+        /// Pose <paramref name="data"/> at a (fractional) frame: qpos is interpolated from
+        /// the mapping and only mj_kinematics runs.
+        /// </summary>
+        public void Apply(MjbModel model, MjbData data, double frame)
+        {
+            ThrowIfDisposed();
+            if (MjbNativeMethods.mjaccess_traj_apply(_handle, model.Handle, data.Handle, frame) != 0)
+                throw new ArgumentException($"Trajectory nq ({Nq}) does not match the model");
+        }
+
+        /// <summary>Convert the qpos of one env of a batched recording; frame k is at time k * dt.</summary>
+        public static void ExportFromRecording(string recordPath, int env, string trajPath, double dt)
+        {
+            if (MjbNativeMethods.mjaccess_record_export_traj(recordPath, env, trajPath, dt) != 0)
+                throw new System.IO.IOException($"Failed to export env {env} of '{recordPath}'");
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MjbTrajectory));
+        }
+
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                MjbNativeMethods.mjaccess_traj_close(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
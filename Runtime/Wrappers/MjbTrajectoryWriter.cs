@@ -0,0 +1,49 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+
+namespace Mujoco.Mjb
+{
+    /// <summary>Appends qpos frames to a trajectory file readable by <see cref="MjbTrajectory"/>.</summary>
+    public sealed class MjbTrajectoryWriter : IDisposable
+    {
+        private IntPtr _handle;
+        public int Nq { get; }
+
+        public MjbTrajectoryWriter(string path, int nq)
+        {
+            _handle = MjbNativeMethods.mjaccess_traj_writer_open(path, nq);
+            if (_handle == IntPtr.Zero)
+                throw new System.IO.IOException($"Failed to create trajectory '{path}'");
+            Nq = nq;
+        }
+
+        /// <summary>Append a frame; times must not decrease.</summary>
+        public unsafe void Add(double time, MjbDoubleSpan qpos)
+        {
+            if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MjbTrajectoryWriter));
+            if (qpos.Length != Nq) throw new ArgumentException($"qpos must hold {Nq} values");
+            if (MjbNativeMethods.mjaccess_traj_writer_add(_handle, time, qpos.Data) != 0)
+                throw new System.IO.IOException("Failed to append trajectory frame");
+        }
+
+        /// <summary>Write the seek index and close the file.</summary>
+        public void Close()
+        {
+            if (_handle == IntPtr.Zero) return;
+            int rc = MjbNativeMethods.mjaccess_traj_writer_close(_handle);
+            _handle = IntPtr.Zero;
+            if (rc != 0) throw new System.IO.IOException("Failed to finish trajectory file");
+        }
+
+        public void Dispose()
+        {
+            if (_handle != IntPtr.Zero)
+            {
+                MjbNativeMethods.mjaccess_traj_writer_close(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}
@@ -15,6 +15,7 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
+using System.IO;
 using System.Xml;
 using NUnit.Framework;
 using UnityEngine;
@@ -158,6 +159,76 @@ public class MjSceneGenerationTests {
     Assert.That(_scene.Data.GetQvel()[0], Is.EqualTo(2));
   }
 
+  [Test]
+  public void SceneRecreatedKeepsJointState() {
+    _scene.CreateScene();
+    _scene.Data.SetQposAt(_joint.QposAddress, 0.3);
+    _scene.Data.SetQvelAt(_joint.DofAddress, 0.7);
+    var model = _scene.Model;
+    var data = _scene.Data;
+    _scene.RecreateScene();
+    Assert.That(_scene.Model, Is.SameAs(model));
+    Assert.That(_scene.Data, Is.SameAs(data));
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0.3).Within(1e-9));
+    Assert.That(_scene.Data.GetQvel()[_joint.DofAddress], Is.EqualTo(0.7).Within(1e-9));
+  }
+
+  [Test]
+  public void SceneRecreatedKeepsStateWhenJointIsInsertedBefore() {
+    _scene.CreateScene();
+    _scene.Data.SetQposAt(_joint.QposAddress, 0.3);
+    _scene.Data.SetQvelAt(_joint.DofAddress, 0.7);
+    var oldName = _joint.MujocoName;
+    // Generated first, so every later generated name (including _joint's) shifts.
+    var joint = new GameObject("joint").AddComponent<MjHingeJoint>();
+    joint.transform.parent = _body.transform;
+    joint.transform.SetSiblingIndex(0);
+    _scene.RecreateScene();
+    Assert.That(_joint.MujocoName, Is.Not.EqualTo(oldName));
+    Assert.That(_scene.Data.GetQpos()[joint.QposAddress], Is.EqualTo(0));
+    Assert.That(_scene.Data.GetQvel()[joint.DofAddress], Is.EqualTo(0));
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0.3).Within(1e-9));
+    Assert.That(_scene.Data.GetQvel()[_joint.DofAddress], Is.EqualTo(0.7).Within(1e-9));
+    UnityEngine.Object.DestroyImmediate(joint.gameObject);
+  }
+
+  [Test]
+  public void SceneRecreationRefusedWhileBatchedSimIsAlive() {
+    _scene.CreateScene();
+    _scene.Data.SetQposAt(_joint.QposAddress, 0.3);
+    var config = new MjbBatchedConfig { numEnvs = 2, numThreads = 1 };
+    using (var sim = _scene.Model.CreateBatchedSim(config)) {
+      Assert.That(() => _scene.RecreateScene(), Throws.TypeOf<InvalidOperationException>());
+      Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0.3).Within(1e-9));
+    }
+    _scene.RecreateScene();
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0.3).Within(1e-9));
+  }
+
+  [Test]
+  public void PlaybackSeeksBetweenFrames() {
+    _scene.CreateScene();
+    var path = Path.Combine(Application.temporaryCachePath, "MjSceneTests.traj");
+    using (var writer = new MjbTrajectoryWriter(path, _scene.Model.Info.nq)) {
+      for (int k = 0; k < 3; k++) {
+        _scene.Data.SetQposAt(_joint.QposAddress, 0.1 * k);
+        writer.Add(k, _scene.Data.GetQpos());
+      }
+      writer.Close();
+    }
+    _scene.StartPlayback(path);
+    Assert.That(_scene.PlaybackTime, Is.EqualTo(0));
+    _scene.SeekPlayback(0.5);
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0.05).Within(1e-9));
+    _scene.SeekPlaybackFrame(2);
+    Assert.That(_scene.PlaybackTime, Is.EqualTo(2));
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0.2).Within(1e-9));
+    _scene.SeekPlayback(5);
+    Assert.That(_scene.PlaybackTime, Is.EqualTo(2));
+    _scene.StopPlayback();
+    File.Delete(path);
+  }
+
 #region Test setup.
 
   public class FakeMjBody : MjBaseBody {
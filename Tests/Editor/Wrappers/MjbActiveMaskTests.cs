@@ -0,0 +1,142 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbActiveMaskTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private const int _numEnvs = 4;
+
+  private MjbModel _model;
+  private MjbBatchedSim _sim;
+  private MjbBatchedSim _reference;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    var config = new MjbBatchedConfig { numEnvs = _numEnvs, numThreads = 2 };
+    _sim = _model.CreateBatchedSim(config);
+    _reference = _model.CreateBatchedSim(config);
+    int nv = _model.Info.nv;
+    for (int i = 0; i < _numEnvs; i++) {
+      var qvel = new double[nv];
+      for (int k = 0; k < nv; k++) qvel[k] = 0.2 * (i + 1) - 0.1 * k;
+      _sim.SetEnvQvel(i, qvel);
+      _reference.SetEnvQvel(i, qvel);
+    }
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _sim.Dispose();
+    _reference.Dispose();
+    _model.Dispose();
+  }
+
+  private double[] Ctrl() {
+    var ctrl = new double[_numEnvs * _model.Info.nu];
+    for (int k = 0; k < ctrl.Length; k++) ctrl[k] = 0.3 * k - 0.5;
+    return ctrl;
+  }
+
+  [Test]
+  public void InactiveEnvsKeepTheirState() {
+    Assert.That(_sim.SetActive(new[] { 1, 0, 1, 0 }), Is.EqualTo(2));
+    var qpos0 = _sim.GetQpos().ToArray();
+    var qvel0 = _sim.GetQvel().ToArray();
+    for (int t = 0; t < 3; t++) {
+      _sim.Step(Ctrl());
+      _reference.Step(Ctrl());
+    }
+
+    int nq = _model.Info.nq, nv = _model.Info.nv;
+    var qpos = _sim.GetQpos().ToArray();
+    var qvel = _sim.GetQvel().ToArray();
+    var refQpos = _reference.GetQpos().ToArray();
+    for (int i = 0; i < _numEnvs; i++) {
+      bool active = i % 2 == 0;
+      for (int k = 0; k < nq; k++) {
+        int j = i * nq + k;
+        Assert.That(qpos[j], Is.EqualTo(active ? refQpos[j] : qpos0[j]));
+      }
+      for (int k = 0; k < nv; k++) {
+        int j = i * nv + k;
+        if (!active) Assert.That(qvel[j], Is.EqualTo(qvel0[j]));
+      }
+    }
+    Assert.That(qpos[0], Is.Not.EqualTo(qpos0[0]));
+  }
+
+  [Test]
+  public void GatherPacksTheActiveRows() {
+    _sim.AddObservation(MjbObsTerm.JointQvel, 1);
+    _sim.SetActive(new[] { 0, 1, 0, 1 });
+    _sim.Step(Ctrl());
+
+    unsafe {
+      _sim.GetActiveEnvs(out int* envs, out int length);
+      Assert.That(length, Is.EqualTo(2));
+      Assert.That(envs[0], Is.EqualTo(1));
+      Assert.That(envs[1], Is.EqualTo(3));
+    }
+
+    int nv = _model.Info.nv;
+    var rows = new double[2 * nv];
+    Assert.That(_sim.GatherActive(MjbBatchedField.Qvel, rows), Is.EqualTo(2));
+    var qvel = _sim.GetQvel().ToArray();
+    for (int k = 0; k < nv; k++) {
+      Assert.That(rows[k], Is.EqualTo(qvel[1 * nv + k]));
+      Assert.That(rows[nv + k], Is.EqualTo(qvel[3 * nv + k]));
+    }
+
+    int dim = _sim.ObservationDim;
+    var obsRows = new float[2 * dim];
+    Assert.That(_sim.GatherActiveObservation(obsRows), Is.EqualTo(2));
+    var obs = _sim.GetObservation().ToArray();
+    for (int j = 0; j < dim; j++) {
+      Assert.That(obsRows[j], Is.EqualTo(obs[1 * dim + j]));
+      Assert.That(obsRows[dim + j], Is.EqualTo(obs[3 * dim + j]));
+    }
+
+    Assert.That(() => _sim.GatherActive(MjbBatchedField.Qvel, new double[nv]),
+                Throws.TypeOf<ArgumentException>());
+  }
+
+  [Test]
+  public void TogglingSingleEnvsUpdatesTheCount() {
+    Assert.That(_sim.SetActive(new[] { 1, 0, 0, 0 }), Is.EqualTo(1));
+    Assert.That(_sim.SetEnvActive(2, true), Is.EqualTo(2));
+    Assert.That(_sim.SetEnvActive(0, false), Is.EqualTo(1));
+    unsafe {
+      _sim.GetActiveEnvs(out int* envs, out int length);
+      Assert.That(length, Is.EqualTo(1));
+      Assert.That(envs[0], Is.EqualTo(2));
+    }
+    Assert.That(_sim.SetActive(null), Is.EqualTo(_numEnvs));
+    Assert.That(() => _sim.SetEnvActive(_numEnvs, true), Throws.TypeOf<ArgumentOutOfRangeException>());
+    Assert.That(() => _sim.SetActive(new int[2]), Throws.TypeOf<ArgumentException>());
+  }
+}
+}
@@ -0,0 +1,120 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbBatchedAsyncTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private const int _numEnvs = 4;
+
+  private MjbModel _model;
+  private MjbBatchedSim _async;
+  private MjbBatchedSim _sync;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    var config = new MjbBatchedConfig { numEnvs = _numEnvs, numThreads = 2 };
+    _async = _model.CreateBatchedSim(config);
+    _sync = _model.CreateBatchedSim(config);
+    int nq = _model.Info.nq;
+    for (int i = 0; i < _numEnvs; i++) {
+      var qpos = new double[nq];
+      for (int k = 0; k < nq; k++) qpos[k] = 0.1 * (i + 1) * (k + 1);
+      _async.SetEnvQpos(i, qpos);
+      _sync.SetEnvQpos(i, qpos);
+    }
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _async.Dispose();
+    _sync.Dispose();
+    _model.Dispose();
+  }
+
+  private double[] Ctrl(int round) {
+    var ctrl = new double[_numEnvs * _model.Info.nu];
+    for (int k = 0; k < ctrl.Length; k++) ctrl[k] = Math.Cos(0.3 * k + round);
+    return ctrl;
+  }
+
+  private static double[] Slice(double[] src, int begin, int count) {
+    var dst = new double[count];
+    Array.Copy(src, begin, dst, 0, count);
+    return dst;
+  }
+
+  [Test]
+  public void HalvesSteppedInTurnMatchASynchronousStep() {
+    int nu = _model.Info.nu, nq = _model.Info.nq;
+    int half = _numEnvs / 2;
+    for (int round = 0; round < 3; round++) {
+      var ctrl = Ctrl(round);
+      var before = _async.GetQpos().ToArray();
+
+      var first = Slice(ctrl, 0, half * nu);
+      _async.StepAsync(first, 0, half);
+      // The controls were copied, so reusing the buffer must not leak into the step.
+      Array.Clear(first, 0, first.Length);
+      _async.Wait();
+      Assert.That(_async.IsStepping, Is.False);
+      var mid = _async.GetQpos().ToArray();
+      for (int k = half * nq; k < _numEnvs * nq; k++) Assert.That(mid[k], Is.EqualTo(before[k]));
+
+      _async.StepAsync(Slice(ctrl, half * nu, half * nu), half, half);
+      _async.Wait();
+      _sync.Step(ctrl);
+
+      var qpos = _async.GetQpos().ToArray();
+      var qvel = _async.GetQvel().ToArray();
+      var refQpos = _sync.GetQpos().ToArray();
+      var refQvel = _sync.GetQvel().ToArray();
+      for (int k = 0; k < qpos.Length; k++) Assert.That(qpos[k], Is.EqualTo(refQpos[k]));
+      for (int k = 0; k < qvel.Length; k++) Assert.That(qvel[k], Is.EqualTo(refQvel[k]));
+    }
+  }
+
+  [Test]
+  public void StepJoinsAPendingAsyncStep() {
+    _async.StepAsync(Ctrl(0), 0, _numEnvs, 2);
+    _async.Step(Ctrl(1));
+    Assert.That(_async.IsStepping, Is.False);
+    _sync.Step(Ctrl(0), 2);
+    _sync.Step(Ctrl(1));
+    var qpos = _async.GetQpos().ToArray();
+    var refQpos = _sync.GetQpos().ToArray();
+    for (int k = 0; k < qpos.Length; k++) Assert.That(qpos[k], Is.EqualTo(refQpos[k]));
+  }
+
+  [Test]
+  public void RangesOutsideTheBatchAreRejected() {
+    var ctrl = new double[_numEnvs * _model.Info.nu];
+    Assert.That(() => _async.StepAsync(ctrl, 3, 2), Throws.TypeOf<ArgumentException>());
+    Assert.That(() => _async.StepAsync(ctrl, 0, 0), Throws.TypeOf<ArgumentException>());
+    Assert.That(_async.IsStepping, Is.False);
+  }
+}
+}
@@ -0,0 +1,116 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbContactExportTests {
+
+  // Two boxes resting 1 mm into the floor, far enough apart not to touch.
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <geom name='floor' type='plane' size='5 5 0.1'/>
+      <body name='a' pos='0 0 0.099'>
+        <freejoint/>
+        <geom name='a' type='box' size='0.1 0.1 0.1'/>
+      </body>
+      <body name='b' pos='1 0 0.099'>
+        <freejoint/>
+        <geom name='b' type='box' size='0.1 0.1 0.1'/>
+      </body>
+    </worldbody>
+  </mujoco>";
+
+  private MjbModel _model;
+  private MjbData _data;
+  private int _floor, _geomA, _geomB, _bodyA;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _data = _model.MakeData();
+    _data.Forward();
+    _floor = _model.Name2Id((int)mjtObj.mjOBJ_GEOM, "floor");
+    _geomA = _model.Name2Id((int)mjtObj.mjOBJ_GEOM, "a");
+    _geomB = _model.Name2Id((int)mjtObj.mjOBJ_GEOM, "b");
+    _bodyA = _model.Name2Id((int)mjtObj.mjOBJ_BODY, "a");
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _data.Dispose();
+    _model.Dispose();
+  }
+
+  private int CountWith(mjtObj type, int[] side0, int[] side1) {
+    _data.SetContactFilter(0, type, side0);
+    _data.SetContactFilter(1, type, side1);
+    return _data.ExportContacts(new MjbContact[16]);
+  }
+
+  private static bool IsPair(MjbContact c, int g0, int g1) {
+    return (c.geom0 == g0 && c.geom1 == g1) || (c.geom0 == g1 && c.geom1 == g0);
+  }
+
+  [Test]
+  public void FiltersSplitTheContactsByPair() {
+    int all = _data.ExportContacts(new MjbContact[16]);
+    int a = CountWith(mjtObj.mjOBJ_GEOM, new[] { _geomA }, new[] { _floor });
+    int b = CountWith(mjtObj.mjOBJ_GEOM, new[] { _floor }, new[] { _geomB });
+    Assert.That(a, Is.GreaterThan(0));
+    Assert.That(b, Is.GreaterThan(0));
+    Assert.That(a + b, Is.EqualTo(all));
+    Assert.That(CountWith(mjtObj.mjOBJ_GEOM, new[] { _geomA }, new[] { _geomB }), Is.EqualTo(0));
+    Assert.That(CountWith(mjtObj.mjOBJ_BODY, new[] { _bodyA }, null), Is.EqualTo(a));
+    Assert.That(CountWith(mjtObj.mjOBJ_BODY, null, null), Is.EqualTo(all));
+  }
+
+  [Test]
+  public void ExportedContactsBelongToTheFilteredPair() {
+    _data.SetContactFilter(0, mjtObj.mjOBJ_GEOM, new[] { _geomA });
+    _data.SetContactFilter(1, mjtObj.mjOBJ_GEOM, new[] { _floor });
+    var contacts = new MjbContact[16];
+    int n = _data.ExportContacts(contacts);
+    for (int i = 0; i < n; i++) {
+      var c = contacts[i];
+      Assert.That(IsPair(c, _geomA, _floor), Is.True);
+      Assert.That(c.body0 == _bodyA || c.body1 == _bodyA, Is.True);
+      Assert.That(c.dist, Is.LessThan(0));
+      unsafe {
+        Assert.That(Math.Abs(c.frame[2]), Is.EqualTo(1).Within(1e-9));
+      }
+    }
+
+    // A short buffer still reports every contact that passed.
+    var one = new MjbContact[1];
+    Assert.That(_data.ExportContacts(one), Is.EqualTo(n));
+    Assert.That(IsPair(one[0], _geomA, _floor), Is.True);
+  }
+
+  [Test]
+  public void BatchedEnvsPackTheirFilteredContacts() {
+    const int numEnvs = 3, capacity = 8;
+    int expected = CountWith(mjtObj.mjOBJ_GEOM, new[] { _geomB }, new[] { _floor });
+    using (var sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = numEnvs, numThreads = 2 })) {
+      sim.SetContactFilter(0, mjtObj.mjOBJ_GEOM, new[] { _geomB });
+      sim.SetContactFilter(1, mjtObj.mjOBJ_GEOM, new[] { _floor });
+      sim.SetContactCapacity(capacity);
+      sim.Step(new double[1]);
+      unsafe {
+        MjbContact* contacts = sim.GetContacts(out int* counts, out int cap);
+        Assert.That(cap, Is.EqualTo(capacity));
+        for (int i = 0; i < numEnvs; i++) {
+          Assert.That(counts[i], Is.EqualTo(expected));
+          for (int k = 0; k < Math.Min(counts[i], cap); k++) {
+            Assert.That(IsPair(contacts[i * cap + k], _geomB, _floor), Is.True);
+          }
+        }
+      }
+    }
+  }
+}
+}
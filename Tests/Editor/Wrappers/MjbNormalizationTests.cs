@@ -0,0 +1,147 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbNormalizationTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private const int _numEnvs = 4;
+  private const double _epsilon = 1e-8;
+
+  private MjbModel _model;
+  private MjbBatchedSim _sim;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = _numEnvs, numThreads = 2 });
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _sim.Dispose();
+    _model.Dispose();
+  }
+
+  // Population mean and variance of each column, in two passes.
+  private static void TwoPass(List<double[]> rows, int dim, double[] mean, double[] var) {
+    for (int j = 0; j < dim; j++) {
+      double sum = 0;
+      foreach (var row in rows) sum += row[j];
+      mean[j] = sum / rows.Count;
+      double sq = 0;
+      foreach (var row in rows) sq += (row[j] - mean[j]) * (row[j] - mean[j]);
+      var[j] = sq / rows.Count;
+    }
+  }
+
+  private double[] Ctrl(int step) {
+    var ctrl = new double[_numEnvs * _model.Info.nu];
+    for (int k = 0; k < ctrl.Length; k++) ctrl[k] = Math.Sin(0.7 * k + 1.3 * step);
+    return ctrl;
+  }
+
+  [Test]
+  public void ObservationStatisticsMatchATwoPassReference() {
+    _sim.AddObservation(MjbObsTerm.JointQpos, 0);
+    _sim.AddObservation(MjbObsTerm.JointQvel, 1);
+    _sim.EnableObservationNormalization(new MjbNormConfig());
+    int nq = _model.Info.nq, nv = _model.Info.nv;
+    int qposAdr = _model.JntQposAdr(0), dofAdr = _model.JntDofAdr(1);
+
+    // The workers fold the float observation rows, so the reference does too.
+    var samples = new List<double[]>();
+    var mean = new double[2];
+    var var = new double[2];
+    const int steps = 6;
+    for (int t = 0; t < steps; t++) {
+      _sim.GetObservationStats(mean, var);
+      _sim.Step(Ctrl(t));
+      var qpos = _sim.GetQpos().ToArray();
+      var qvel = _sim.GetQvel().ToArray();
+      for (int i = 0; i < _numEnvs; i++) {
+        samples.Add(new double[] { (float)qpos[i * nq + qposAdr], (float)qvel[i * nv + dofAdr] });
+      }
+    }
+
+    // The last rows were normalized with the statistics from before that step.
+    var obs = _sim.GetObservation();
+    for (int i = 0; i < _numEnvs; i++) {
+      for (int j = 0; j < 2; j++) {
+        float x = (float)samples[(steps - 1) * _numEnvs + i][j];
+        float expected = (x - (float)mean[j]) * (float)(1.0 / Math.Sqrt(var[j] + _epsilon));
+        Assert.That(obs[i * 2 + j], Is.EqualTo(expected).Within(1e-5 * Math.Max(1, Math.Abs(expected))));
+      }
+    }
+
+    var refMean = new double[2];
+    var refVar = new double[2];
+    TwoPass(samples, 2, refMean, refVar);
+    double count = _sim.GetObservationStats(mean, var);
+    Assert.That(count, Is.EqualTo(steps * _numEnvs));
+    for (int j = 0; j < 2; j++) {
+      Assert.That(mean[j], Is.EqualTo(refMean[j]).Within(1e-9 * Math.Max(1, Math.Abs(refMean[j]))));
+      Assert.That(var[j], Is.EqualTo(refVar[j]).Within(1e-9 * Math.Max(1, refVar[j])));
+    }
+
+    _sim.FreezeNormalization();
+    _sim.Step(Ctrl(steps));
+    Assert.That(_sim.GetObservationStats(mean, var), Is.EqualTo(steps * _numEnvs));
+    _sim.FreezeNormalization(false);
+    _sim.ResetNormalization();
+    Assert.That(_sim.GetObservationStats(mean, var), Is.EqualTo(0));
+  }
+
+  [Test]
+  public void RewardsAreScaledByTheReturnStatistics() {
+    const float gamma = 0.9f;
+    _sim.EnableRewardNormalization(new MjbNormConfig { gamma = gamma });
+    var returns = new double[_numEnvs];
+    var samples = new List<double[]>();
+    var dones = new int[_numEnvs];
+    var rewards = new float[_numEnvs];
+    for (int t = 0; t < 5; t++) {
+      for (int i = 0; i < _numEnvs; i++) {
+        rewards[i] = (float)(Math.Cos(0.9 * i + 0.4 * t) + 0.5 * i);
+        dones[i] = (t == 2 && i == 1) ? 1 : 0;
+        returns[i] = returns[i] * gamma + rewards[i];
+        samples.Add(new double[] { returns[i] });
+      }
+      var raw = (float[])rewards.Clone();
+      _sim.NormalizeRewards(rewards, dones);
+
+      var mean = new double[1];
+      var var = new double[1];
+      TwoPass(samples, 1, mean, var);
+      float scale = (float)(1.0 / Math.Sqrt(var[0] + _epsilon));
+      for (int i = 0; i < _numEnvs; i++) {
+        Assert.That(rewards[i], Is.EqualTo(raw[i] * scale).Within(1e-5 * Math.Max(1, Math.Abs(raw[i] * scale))));
+        if (dones[i] != 0) returns[i] = 0;
+      }
+    }
+  }
+}
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbObservationPlanTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private MjbModel _model;
+  private MjbBatchedSim _sim;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = 3, numThreads = 2 });
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _sim.Dispose();
+    _model.Dispose();
+  }
+
+  [Test]
+  public void RowsFollowTheTermOrder() {
+    // The two qpos terms are adjacent in qpos and coalesce into one copy run; the
+    // qvel terms are reversed and must not.
+    Assert.That(_sim.AddObservation(MjbObsTerm.JointQpos, "shoulder"), Is.EqualTo(1));
+    Assert.That(_sim.AddObservation(MjbObsTerm.JointQpos, "elbow"), Is.EqualTo(1));
+    Assert.That(_sim.AddObservation(MjbObsTerm.JointQvel, "elbow"), Is.EqualTo(1));
+    Assert.That(_sim.AddObservation(MjbObsTerm.JointQvel, "shoulder"), Is.EqualTo(1));
+    Assert.That(_sim.AddObservation(MjbObsTerm.BodyXpos, "lower"), Is.EqualTo(3));
+    int dim = _sim.ObservationDim;
+    Assert.That(dim, Is.EqualTo(7));
+
+    var ctrl = new double[] { 0.5, -0.25, -1, 0.75, 0.25, 1 };
+    for (int k = 0; k < 5; k++) _sim.Step(ctrl);
+
+    int lower = _model.Name2Id((int)mjtObj.mjOBJ_BODY, "lower");
+    int nbody = _model.Info.nbody;
+    var qpos = _sim.GetQpos().ToArray();
+    var qvel = _sim.GetQvel().ToArray();
+    var xpos = _sim.GetXpos().ToArray();
+    var obs = _sim.GetObservation();
+    Assert.That(obs.Length, Is.EqualTo(3 * dim));
+    for (int i = 0; i < 3; i++) {
+      var expected = new float[] {
+        (float)qpos[i * 2], (float)qpos[i * 2 + 1],
+        (float)qvel[i * 2 + 1], (float)qvel[i * 2],
+        (float)xpos[(i * nbody + lower) * 3], (float)xpos[(i * nbody + lower) * 3 + 1],
+        (float)xpos[(i * nbody + lower) * 3 + 2],
+      };
+      for (int j = 0; j < dim; j++) Assert.That(obs[i * dim + j], Is.EqualTo(expected[j]));
+    }
+    Assert.That(qvel[0], Is.Not.EqualTo(qvel[1]));
+  }
+
+  [Test]
+  public void BoundBufferReceivesTheRows() {
+    _sim.AddObservation(MjbObsTerm.JointQpos, "elbow");
+    _sim.AddObservation(MjbObsTerm.ActuatorCtrl, 0);
+    var rows = new float[3 * _sim.ObservationDim];
+    unsafe {
+      fixed (float* p = rows) {
+        _sim.BindObservation(p, rows.Length);
+        _sim.Step(new double[] { 1, 0, 2, 0, 3, 0 });
+        _sim.BindObservation(null, 0);
+      }
+    }
+    var qpos = _sim.GetQpos().ToArray();
+    for (int i = 0; i < 3; i++) {
+      Assert.That(rows[i * 2], Is.EqualTo((float)qpos[i * 2 + 1]));
+      Assert.That(rows[i * 2 + 1], Is.EqualTo((float)(i + 1)));
+    }
+  }
+
+  [Test]
+  public void ClearingThePlanEmptiesTheRow() {
+    _sim.AddObservation(MjbObsTerm.JointQpos, "shoulder");
+    _sim.ClearObservation();
+    Assert.That(_sim.ObservationDim, Is.EqualTo(0));
+    Assert.That(() => _sim.AddObservation(MjbObsTerm.JointQpos, "missing"),
+                Throws.TypeOf<ArgumentException>());
+  }
+}
+}
@@ -0,0 +1,150 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbRandomizationTests {
+
+  // Explicit inertials, so setting a body's mass leaves everything else of the
+  // compiled model unchanged.
+  private const string _mjcfTemplate = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <inertial pos='0 0 -0.25' mass='{0}' diaginertia='0.02 0.02 0.002'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0' damping='0.1'/>
+          <inertial pos='0 0 -0.25' mass='0.5' diaginertia='0.01 0.01 0.001'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private const int _numEnvs = 4;
+
+  private MjbModel _model;
+  private MjbBatchedSim _sim;
+
+  private static string Mjcf(double upperMass) {
+    return string.Format(System.Globalization.CultureInfo.InvariantCulture, _mjcfTemplate, upperMass);
+  }
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(Mjcf(1));
+    _sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = _numEnvs, numThreads = 2 });
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _sim.Dispose();
+    _model.Dispose();
+  }
+
+  [Test]
+  public void SamplesStayWithinTheirBounds() {
+    _sim.EnableParameter(MjbParam.BodyMass);
+    var nominal = _sim.GetParameterTable(MjbParam.BodyMass).ToArray();
+    _sim.AddRandomization(new MjbRandTerm {
+      param = MjbParam.DofDamping, obj = -1, component = -1,
+      dist = MjbDistribution.Uniform, op = MjbRandOp.Set, a = 0.1, b = 0.2 });
+    _sim.AddRandomization(new MjbRandTerm {
+      param = MjbParam.BodyMass, obj = -1, component = 0,
+      dist = MjbDistribution.LogUniform, op = MjbRandOp.Scale, a = 0.5, b = 2 });
+    _sim.Randomize();
+
+    int nv = _model.Info.nv, nbody = _model.Info.nbody;
+    var damping = _sim.GetParameterTable(MjbParam.DofDamping).ToArray();
+    var mass = _sim.GetParameterTable(MjbParam.BodyMass).ToArray();
+    Assert.That(damping.Length, Is.EqualTo(_numEnvs * nv));
+    Assert.That(mass.Length, Is.EqualTo(_numEnvs * nbody));
+    foreach (double v in damping) Assert.That(v, Is.InRange(0.1, 0.2));
+    for (int k = 0; k < mass.Length; k++) {
+      Assert.That(mass[k], Is.InRange(0.5 * nominal[k], 2 * nominal[k]));
+    }
+    Assert.That(damping[0], Is.Not.EqualTo(damping[nv]));
+  }
+
+  [Test]
+  public void ReseedingReproducesTheDraws() {
+    _sim.AddRandomization(new MjbRandTerm {
+      param = MjbParam.DofDamping, obj = -1, component = -1,
+      dist = MjbDistribution.Gaussian, op = MjbRandOp.Add, a = 0, b = 0.1 });
+    _sim.SetAutoReset(new MjbAutoResetConfig { seed = 42 });
+    _sim.Randomize();
+    var first = _sim.GetParameterTable(MjbParam.DofDamping).ToArray();
+    _sim.Randomize();
+    var second = _sim.GetParameterTable(MjbParam.DofDamping).ToArray();
+    _sim.SetAutoReset(new MjbAutoResetConfig { seed = 42 });
+    _sim.Randomize();
+    var again = _sim.GetParameterTable(MjbParam.DofDamping).ToArray();
+
+    Assert.That(first[0], Is.Not.EqualTo(second[0]));
+    for (int k = 0; k < first.Length; k++) Assert.That(again[k], Is.EqualTo(first[k]));
+  }
+
+  [Test]
+  public void MaskedEnvsAloneAreResampled() {
+    _sim.AddRandomization(new MjbRandTerm {
+      param = MjbParam.DofDamping, obj = -1, component = -1,
+      dist = MjbDistribution.Uniform, op = MjbRandOp.Set, a = 1, b = 2 });
+    var before = _sim.GetParameterTable(MjbParam.DofDamping).ToArray();
+    _sim.Randomize(new[] { 0, 1, 0, 0 });
+    var after = _sim.GetParameterTable(MjbParam.DofDamping).ToArray();
+    int nv = _model.Info.nv;
+    for (int i = 0; i < _numEnvs; i++) {
+      for (int k = 0; k < nv; k++) {
+        if (i == 1) Assert.That(after[i * nv + k], Is.InRange(1.0, 2.0));
+        else Assert.That(after[i * nv + k], Is.EqualTo(before[i * nv + k]));
+      }
+    }
+  }
+
+  [Test]
+  public void SetMassMatchesAModelCompiledWithThatMass() {
+    // body_subtreemass feeds subtree_com, so a stale row would show up there.
+    int upper = _model.Name2Id((int)mjtObj.mjOBJ_BODY, "upper");
+    _sim.AddRandomization(new MjbRandTerm {
+      param = MjbParam.BodyMass, obj = upper, component = 0,
+      dist = MjbDistribution.Uniform, op = MjbRandOp.Set, a = 3, b = 3 });
+    _sim.Randomize(new[] { 0, 0, 1, 0 });
+
+    using (var heavy = MjbModel.LoadFromString(Mjcf(3)))
+    using (var data = heavy.MakeData()) {
+      var qpos = new[] { 0.3, -0.4 };
+      for (int i = 0; i < _numEnvs; i++) _sim.SetEnvQpos(i, qpos);
+      data.SetQpos(qpos);
+      var ctrl = new double[] { 0.2, -0.1 };
+      var batchCtrl = new double[_numEnvs * 2];
+      for (int i = 0; i < _numEnvs; i++) Array.Copy(ctrl, 0, batchCtrl, i * 2, 2);
+      data.SetCtrl(ctrl);
+      for (int t = 0; t < 20; t++) {
+        _sim.Step(batchCtrl);
+        data.Step();
+      }
+
+      int nq = _model.Info.nq, nbody = _model.Info.nbody;
+      var simQpos = _sim.GetQpos().ToArray();
+      var simCom = _sim.GetSubtreeCom().ToArray();
+      var refQpos = data.GetQpos().ToArray();
+      var refCom = data.GetSubtreeCom().ToArray();
+      for (int k = 0; k < nq; k++) {
+        Assert.That(simQpos[2 * nq + k], Is.EqualTo(refQpos[k]).Within(1e-12));
+      }
+      for (int k = 0; k < 3 * nbody; k++) {
+        Assert.That(simCom[2 * 3 * nbody + k], Is.EqualTo(refCom[k]).Within(1e-12));
+      }
+      Assert.That(simQpos[0], Is.Not.EqualTo(refQpos[0]));
+    }
+  }
+}
+}
@@ -0,0 +1,136 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using NUnit.Framework;
+using Mujoco.Mjb;
+using UnityEngine;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbRecorderTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private const int _numEnvs = 3;
+
+  private MjbModel _model;
+  private MjbBatchedSim _sim;
+  private string _path;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = _numEnvs, numThreads = 2 });
+    _path = Path.Combine(Application.temporaryCachePath, "MjbRecorderTests.rec");
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _sim.Dispose();
+    _model.Dispose();
+    File.Delete(_path);
+  }
+
+  // Steps K frames, restarting env 1 before the frame at `restartAt`, and returns
+  // the qpos of every frame.
+  private List<double[]> Record(MjbRecordFlags flags, int steps, int restartAt) {
+    _sim.StartRecording(_path, new MjbRecordConfig { flags = flags, ringFrames = 2, chunkFrames = 3 });
+    var frames = new List<double[]>();
+    var ctrl = new double[_numEnvs * _model.Info.nu];
+    for (int k = 0; k < steps; k++) {
+      for (int j = 0; j < ctrl.Length; j++) ctrl[j] = Math.Sin(0.5 * j + k);
+      if (k == restartAt) _sim.SetDone(new[] { 0, 1, 0 });
+      _sim.Step(ctrl);
+      frames.Add(_sim.GetQpos().ToArray());
+    }
+    Assert.That(_sim.GetRecordingStats().frames, Is.EqualTo((long)steps));
+    _sim.StopRecording();
+    return frames;
+  }
+
+  private void AssertRoundTrip(MjbRecordFlags flags) {
+    const int steps = 7, restartAt = 4;
+    var expected = Record(flags, steps, restartAt);
+    int nq = _model.Info.nq;
+
+    using (var reader = new MjbRecordReader(_path)) {
+      var info = reader.Info;
+      Assert.That(info.numEnvs, Is.EqualTo(_numEnvs));
+      Assert.That(info.flags, Is.EqualTo(flags));
+      Assert.That(info.elemSize, Is.EqualTo(8));
+      Assert.That(info.GetDim(MjbBatchedField.Qpos), Is.EqualTo(nq));
+      Assert.That(info.GetFieldOffset(MjbBatchedField.Xpos), Is.EqualTo(-1));
+      int qposOffset = info.GetFieldOffset(MjbBatchedField.Qpos);
+      Assert.That(qposOffset, Is.EqualTo(8));
+
+      var rows = new byte[reader.FrameBytes];
+      for (int k = 0; k < steps; k++) {
+        Assert.That(reader.ReadFrame(rows, out long frame, out int envFirst, out int envCount), Is.True);
+        Assert.That(frame, Is.EqualTo((long)k));
+        Assert.That(envFirst, Is.EqualTo(0));
+        Assert.That(envCount, Is.EqualTo(_numEnvs));
+        for (int i = 0; i < _numEnvs; i++) {
+          int row = i * info.rowBytes;
+          bool restarted = i == 1 && k >= restartAt;
+          Assert.That(BitConverter.ToInt32(rows, row), Is.EqualTo(restarted ? 1 : 0));
+          Assert.That(BitConverter.ToInt32(rows, row + 4), Is.EqualTo(restarted ? k - restartAt : k + 1));
+          for (int q = 0; q < nq; q++) {
+            Assert.That(BitConverter.ToDouble(rows, row + qposOffset + q * 8),
+                        Is.EqualTo(expected[k][i * nq + q]));
+          }
+        }
+      }
+      Assert.That(reader.ReadFrame(rows, out _, out _, out _), Is.False);
+    }
+  }
+
+  [Test]
+  public void PlainRowsRoundTrip() {
+    AssertRoundTrip(MjbRecordFlags.None);
+  }
+
+  [Test]
+  public void DeltaCompressedRowsRoundTrip() {
+    AssertRoundTrip(MjbRecordFlags.Delta | MjbRecordFlags.Compress);
+  }
+
+  [Test]
+  public void Float32RowsHoldTheRoundedState() {
+    var expected = Record(MjbRecordFlags.Float32 | MjbRecordFlags.Compress, 3, -1);
+    int nq = _model.Info.nq;
+    using (var reader = new MjbRecordReader(_path)) {
+      Assert.That(reader.Info.elemSize, Is.EqualTo(4));
+      int offset = reader.Info.GetFieldOffset(MjbBatchedField.Qpos);
+      var rows = new byte[reader.FrameBytes];
+      for (int k = 0; k < 3; k++) {
+        Assert.That(reader.ReadFrame(rows, out _, out _, out _), Is.True);
+        for (int i = 0; i < _numEnvs; i++) {
+          for (int q = 0; q < nq; q++) {
+            Assert.That(BitConverter.ToSingle(rows, i * reader.Info.rowBytes + offset + q * 4),
+                        Is.EqualTo((float)expected[k][i * nq + q]));
+          }
+        }
+      }
+    }
+  }
+}
+}
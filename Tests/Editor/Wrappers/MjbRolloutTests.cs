@@ -0,0 +1,142 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbRolloutTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+    <sensor>
+      <jointpos joint='elbow'/>
+    </sensor>
+  </mujoco>";
+
+  private const int _count = 3;
+  private const int _horizon = 5;
+
+  private MjbModel _model;
+  private MjbRollout _rollout;
+  private double[] _start;
+  private double[] _ctrl;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _rollout = new MjbRollout(_model, new MjbRolloutConfig {
+      outSpec = mjtState.mjSTATE_QPOS | mjtState.mjSTATE_QVEL, numThreads = 2 });
+    using (var data = _model.MakeData()) {
+      data.SetQpos(new[] { 0.3, -0.5 });
+      data.SetQvel(new[] { 0.2, 0.1 });
+      _start = data.GetState(mjtState.mjSTATE_INTEGRATION);
+    }
+    _ctrl = new double[_count * _horizon * _model.Info.nu];
+    for (int k = 0; k < _ctrl.Length; k++) _ctrl[k] = Math.Sin(0.37 * k);
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _rollout.Dispose();
+    _model.Dispose();
+  }
+
+  [Test]
+  public void StatesMatchSequentialStepping() {
+    int nq = _model.Info.nq, nv = _model.Info.nv, nu = _model.Info.nu;
+    int size = _rollout.OutStateSize;
+    Assert.That(size, Is.EqualTo(nq + nv));
+    var states = new double[_count * _horizon * size];
+    _rollout.Run(_start, _count, _horizon, _ctrl, states);
+
+    using (var data = _model.MakeData()) {
+      for (int k = 0; k < _count; k++) {
+        data.SetState(mjtState.mjSTATE_INTEGRATION, _start);
+        for (int t = 0; t < _horizon; t++) {
+          int row = k * _horizon + t;
+          var ctrl = new double[nu];
+          Array.Copy(_ctrl, row * nu, ctrl, 0, nu);
+          data.SetCtrl(ctrl);
+          data.Step();
+          var qpos = data.GetQpos().ToArray();
+          var qvel = data.GetQvel().ToArray();
+          for (int j = 0; j < nq; j++) Assert.That(states[row * size + j], Is.EqualTo(qpos[j]));
+          for (int j = 0; j < nv; j++) Assert.That(states[row * size + nq + j], Is.EqualTo(qvel[j]));
+        }
+      }
+    }
+  }
+
+  [Test]
+  public void CostsSumTheWeightedTermsOfEachStep() {
+    int nq = _model.Info.nq, nv = _model.Info.nv, nu = _model.Info.nu;
+    int ns = _model.Info.nsensordata;
+    var qposWeight = new[] { 1.0, 0.5 };
+    var qposRef = new[] { 0.1, -0.2 };
+    var qvelWeight = new[] { 0.25, 2.0 };
+    var ctrlWeight = new[] { 0.01, 0.03 };
+    var ctrlRef = new[] { 0.2, 0.0 };
+    var sensorWeight = new[] { 4.0 };
+    var sensorRef = new[] { 0.5 };
+    const double terminal = 9;
+    _rollout.SetCost(qposWeight, qvelWeight, ctrlWeight, sensorWeight, qposRef, null, ctrlRef,
+                     sensorRef, terminal);
+
+    int size = _rollout.OutStateSize;
+    var states = new double[_count * _horizon * size];
+    var sensors = new double[_count * _horizon * ns];
+    var costs = new double[_count];
+    _rollout.Run(_start, _count, _horizon, _ctrl, states, sensors, costs);
+
+    // Hinges only, so the tangent-space qpos error is the plain difference.
+    for (int k = 0; k < _count; k++) {
+      double expected = 0;
+      for (int t = 0; t < _horizon; t++) {
+        int row = k * _horizon + t;
+        double c = 0;
+        for (int j = 0; j < nv; j++) {
+          double e = states[row * size + j] - qposRef[j];
+          c += qposWeight[j] * e * e;
+        }
+        for (int j = 0; j < nv; j++) {
+          double v = states[row * size + nq + j];
+          c += qvelWeight[j] * v * v;
+        }
+        for (int j = 0; j < ns; j++) {
+          double e = sensors[row * ns + j] - sensorRef[j];
+          c += sensorWeight[j] * e * e;
+        }
+        if (t == _horizon - 1) c *= 1 + terminal;
+        for (int j = 0; j < nu; j++) {
+          double e = _ctrl[row * nu + j] - ctrlRef[j];
+          c += ctrlWeight[j] * e * e;
+        }
+        expected += c;
+      }
+      Assert.That(costs[k], Is.EqualTo(expected).Within(1e-12 * Math.Max(1, expected)));
+    }
+    Assert.That(costs[0], Is.Not.EqualTo(costs[1]));
+
+    _rollout.ClearCost();
+    _rollout.Run(_start, _count, _horizon, _ctrl, null, null, costs);
+    for (int k = 0; k < _count; k++) Assert.That(costs[k], Is.EqualTo(0));
+  }
+}
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbScatterTests {
+
+  // No gravity and no control, so a step leaves qpos where the scatter put it.
+  private const string _mjcf = @"<mujoco>
+    <option gravity='0 0 0'/>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow'/>
+    </actuator>
+  </mujoco>";
+
+  private const int _numEnvs = 4;
+
+  private MjbModel _model;
+  private MjbBatchedSim _sim;
+  private double[] _ctrl;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = _numEnvs, numThreads = 2 });
+    _ctrl = new double[_numEnvs * _model.Info.nu];
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _sim.Dispose();
+    _model.Dispose();
+  }
+
+  private double Qpos(int env, int elem) {
+    return _sim.GetQpos()[env * _model.Info.nq + elem];
+  }
+
+  [Test]
+  public void ValuesPairWithEnvsInOrder() {
+    _sim.Scatter(MjbPhysicsCommand.Qpos, new[] { 2, 0 }, new[] { 1 }, new[] { 0.5, -0.25 });
+    _sim.Scatter(MjbPhysicsCommand.Qpos, new[] { 3 }, null, new[] { 0.1, 0.2 });
+    _sim.Step(_ctrl);
+    Assert.That(Qpos(2, 1), Is.EqualTo(0.5));
+    Assert.That(Qpos(0, 1), Is.EqualTo(-0.25));
+    Assert.That(Qpos(3, 0), Is.EqualTo(0.1));
+    Assert.That(Qpos(3, 1), Is.EqualTo(0.2));
+    Assert.That(Qpos(1, 0), Is.EqualTo(0));
+    Assert.That(Qpos(1, 1), Is.EqualTo(0));
+  }
+
+  [Test]
+  public void LaterCallsWin() {
+    _sim.Scatter(MjbPhysicsCommand.Qpos, new[] { 1, 2 }, new[] { 0 }, new[] { 0.3, 0.4 });
+    _sim.Scatter(MjbPhysicsCommand.Qpos, 2, 0, 0.9);
+    _sim.Step(_ctrl);
+    Assert.That(Qpos(1, 0), Is.EqualTo(0.3));
+    Assert.That(Qpos(2, 0), Is.EqualTo(0.9));
+  }
+
+  [Test]
+  public void InactiveEnvsStillReceiveTheWrite() {
+    _sim.SetActive(new[] { 1, 0, 1, 1 });
+    _sim.Scatter(MjbPhysicsCommand.Qpos, 1, 1, 0.6);
+    _sim.Step(_ctrl);
+    Assert.That(Qpos(1, 1), Is.EqualTo(0.6));
+  }
+
+  [Test]
+  public void RepeatedEnvIsRejectedWithoutStaging() {
+    Assert.That(() => _sim.Scatter(MjbPhysicsCommand.Qpos, new[] { 0, 0 }, new[] { 0 }, new[] { 9.0, 9.0 }),
+                Throws.TypeOf<ArgumentException>());
+    Assert.That(() => _sim.Scatter(MjbPhysicsCommand.Qpos, 0, _model.Info.nq, 1.0),
+                Throws.TypeOf<ArgumentOutOfRangeException>());
+    _sim.Scatter(MjbPhysicsCommand.Qpos, new[] { 0, 1 }, new[] { 0 }, new[] { 0.2, 0.3 });
+    _sim.Step(_ctrl);
+    Assert.That(Qpos(0, 0), Is.EqualTo(0.2));
+    Assert.That(Qpos(1, 0), Is.EqualTo(0.3));
+  }
+}
+}
@@ -0,0 +1,148 @@
+// Copyright 2026 Arghya Sur / Mobyr
+// Apache-2.0 License
+
+using System;
+using NUnit.Framework;
+using Mujoco.Mjb;
+
+namespace Mujoco {
+
+[TestFixture]
+public class MjbTransitionFDTests {
+
+  private const string _mjcf = @"<mujoco>
+    <worldbody>
+      <body name='upper'>
+        <joint name='shoulder' type='hinge' axis='0 1 0' damping='0.05'/>
+        <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        <body name='lower' pos='0 0 -0.5'>
+          <joint name='elbow' type='hinge' axis='0 1 0'/>
+          <geom type='capsule' size='0.05' fromto='0 0 0 0 0 -0.5' contype='0' conaffinity='0'/>
+        </body>
+      </body>
+    </worldbody>
+    <actuator>
+      <motor joint='shoulder'/>
+      <motor joint='elbow' gear='2'/>
+    </actuator>
+    <sensor>
+      <jointpos joint='shoulder'/>
+      <jointvel joint='elbow'/>
+    </sensor>
+  </mujoco>";
+
+  private const double _eps = 1e-6;
+  private const double _tolerance = 1e-8;
+
+  private MjbModel _model;
+  private int _nx, _nu, _ns;
+
+  [SetUp]
+  public void SetUp() {
+    _model = MjbModel.LoadFromString(_mjcf);
+    _nx = 2 * _model.Info.nv + _model.Info.na;
+    _nu = _model.Info.nu;
+    _ns = _model.Info.nsensordata;
+  }
+
+  [TearDown]
+  public void TearDown() {
+    _model.Dispose();
+  }
+
+  private static double[] Row(double[] src, int env, int n) {
+    var dst = new double[n];
+    Array.Copy(src, env * n, dst, 0, n);
+    return dst;
+  }
+
+  // mjd_transitionFD on one thread, around the given state.
+  private void Reference(double[] qpos, double[] qvel, double[] ctrl, bool centered,
+                         double[] A, double[] B, double[] C, double[] D) {
+    using (var data = _model.MakeData()) {
+      Assert.That(data.SetTransitionFDThreads(1), Is.EqualTo(1));
+      data.SetQpos(qpos);
+      data.SetQvel(qvel);
+      data.SetCtrl(ctrl);
+      data.Forward();
+      data.TransitionFD(_eps, centered, A, B, C, D);
+    }
+  }
+
+  private static void AssertBlock(double[] actual, int offset, double[] expected) {
+    for (int k = 0; k < expected.Length; k++) {
+      Assert.That(actual[offset + k], Is.EqualTo(expected[k]).Within(_tolerance));
+    }
+  }
+
+  [TestCase(false)]
+  [TestCase(true)]
+  public void ParallelColumnsMatchMjdTransitionFD(bool centered) {
+    var qpos = new[] { 0.4, -0.7 };
+    var qvel = new[] { 0.3, 1.1 };
+    var ctrl = new[] { 0.5, -0.2 };
+    var A = new double[_nx * _nx];
+    var B = new double[_nx * _nu];
+    var C = new double[_ns * _nx];
+    var D = new double[_ns * _nu];
+    Reference(qpos, qvel, ctrl, centered, A, B, C, D);
+    Assert.That(_ns, Is.EqualTo(2));
+    Assert.That(Math.Abs(B[_nx * _nu - 1]), Is.GreaterThan(0));
+
+    using (var data = _model.MakeData()) {
+      Assert.That(data.SetTransitionFDThreads(3), Is.EqualTo(3));
+      data.SetQpos(qpos);
+      data.SetQvel(qvel);
+      data.SetCtrl(ctrl);
+      data.Forward();
+      var a = new double[A.Length];
+      var b = new double[B.Length];
+      var c = new double[C.Length];
+      var d = new double[D.Length];
+      data.TransitionFD(_eps, centered, a, b, c, d);
+      AssertBlock(a, 0, A);
+      AssertBlock(b, 0, B);
+      AssertBlock(c, 0, C);
+      AssertBlock(d, 0, D);
+      var qposAfter = data.GetQpos().ToArray();
+      for (int k = 0; k < qpos.Length; k++) Assert.That(qposAfter[k], Is.EqualTo(qpos[k]));
+    }
+  }
+
+  [Test]
+  public void BatchedBlocksMatchMjdTransitionFDPerEnv() {
+    const int numEnvs = 3;
+    using (var sim = _model.CreateBatchedSim(new MjbBatchedConfig { numEnvs = numEnvs, numThreads = 2 })) {
+      int nq = _model.Info.nq, nv = _model.Info.nv;
+      for (int i = 0; i < numEnvs; i++) {
+        sim.SetEnvQpos(i, new[] { 0.2 * i, -0.3 * i });
+        sim.SetEnvQvel(i, new[] { 0.1 * i, 0.5 });
+      }
+      var ctrl = new double[numEnvs * _nu];
+      for (int k = 0; k < ctrl.Length; k++) ctrl[k] = 0.25 * (k + 1);
+      sim.Step(ctrl);
+
+      var qpos = sim.GetQpos().ToArray();
+      var qvel = sim.GetQvel().ToArray();
+      var envCtrl = sim.GetCtrl().ToArray();
+      var a = new double[numEnvs * _nx * _nx];
+      var b = new double[numEnvs * _nx * _nu];
+      var c = new double[numEnvs * _ns * _nx];
+      var d = new double[numEnvs * _ns * _nu];
+      sim.TransitionFD(_eps, false, a, b, c, d);
+
+      for (int i = 0; i < numEnvs; i++) {
+        var A = new double[_nx * _nx];
+        var B = new double[_nx * _nu];
+        var C = new double[_ns * _nx];
+        var D = new double[_ns * _nu];
+        Reference(Row(qpos, i, nq), Row(qvel, i, nv), Row(envCtrl, i, _nu), false, A, B, C, D);
+        AssertBlock(a, i * A.Length, A);
+        AssertBlock(b, i * B.Length, B);
+        AssertBlock(c, i * C.Length, C);
+        AssertBlock(d, i * D.Length, D);
+      }
+    }
+  }
+}
+}
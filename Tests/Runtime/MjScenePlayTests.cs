@@ -17,10 +17,12 @@
 using System;
 using System.Collections;
 using System.Collections.Generic;
+using System.IO;
 using System.Xml;
 using NUnit.Framework;
 using UnityEngine;
 using UnityEngine.TestTools;
+using Mujoco.Mjb;
 
 namespace Mujoco {
 
@@ -65,6 +67,17 @@ public class MjScenePlayTests {
     // Assert.That(tickedRotation, Is.EqualTo(_body.transform.rotation).Using(_quaternionComparer));
   }
 
+  [UnityTest]
+  public IEnumerator BulkTransformSyncMatchesMujocoFrames() {
+    _joint.Velocity = 1;
+    _scene.CreateScene();
+    yield return new WaitForFixedUpdate();
+    var position = MjEngineTool.UnityVector3AtEntry(_scene.Data.GetXpos(), _body.MujocoId);
+    var rotation = MjEngineTool.UnityQuaternionAtEntry(_scene.Data.GetXquat(), _body.MujocoId);
+    Assert.That(Vector3.Distance(position, _body.transform.position), Is.LessThan(1e-5f));
+    Assert.That(Quaternion.Angle(rotation, _body.transform.rotation), Is.LessThan(1e-2f));
+  }
+
   [UnityTest]
   public IEnumerator SceneRecreatedWithAddition() {
     _joint.Velocity = 1;
@@ -101,6 +114,78 @@ public class MjScenePlayTests {
     yield return null; // should result in a new scene
     Assert.That(_scene.SceneRecreationAtLateUpdateRequested, Is.False);
   }
+
+  [UnityTest]
+  public IEnumerator PlaybackLoopsAndPosesTheScene() {
+    _scene.CreateScene();
+    var path = Path.Combine(Application.temporaryCachePath, "MjScenePlayTests.traj");
+    using (var writer = new MjbTrajectoryWriter(path, _scene.Model.Info.nq)) {
+      for (int k = 0; k < 3; k++) {
+        _scene.Data.SetQposAt(_joint.QposAddress, k);
+        writer.Add(k, _scene.Data.GetQpos());
+      }
+      writer.Close();
+    }
+    _scene.StartPlayback(path);
+    _scene.PlaybackLoop = true;
+    _scene.PlaybackSpeed = 0.5f / Time.fixedDeltaTime; // half a second per fixed update
+    _scene.SeekPlayback(1.75);
+    yield return new WaitForFixedUpdate();
+    // qpos is the trajectory time, wrapped into [0, 2)
+    Assert.That(_scene.PlaybackTime, Is.LessThan(2));
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress],
+                Is.EqualTo(_scene.PlaybackTime).Within(1e-6));
+    var rotation = MjEngineTool.UnityQuaternionAtEntry(_scene.Data.GetXquat(), _body.MujocoId);
+    Assert.That(Quaternion.Angle(rotation, _body.transform.rotation), Is.LessThan(1e-2f));
+
+    _scene.PlaybackLoop = false;
+    yield return new WaitForFixedUpdate();
+    yield return new WaitForFixedUpdate();
+    yield return new WaitForFixedUpdate();
+    yield return new WaitForFixedUpdate();
+    Assert.That(_scene.PlaybackTime, Is.EqualTo(2));
+    Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(2).Within(1e-9));
+    _scene.StopPlayback();
+    File.Delete(path);
+  }
+
+  [UnityTest]
+  public IEnumerator PhysicsThreadStopsAndRestarts() {
+    var settings = new GameObject("settings").AddComponent<MjGlobalSettings>();
+    try {
+      settings.BackgroundPhysics = true;
+      _joint.Velocity = 1;
+      _scene.CreateScene();
+      yield return new WaitForFixedUpdate();
+      if (_scene.PhysicsThread == null) {
+        Assert.Ignore("No physics thread on this platform.");
+      }
+      var thread = _scene.PhysicsThread;
+      yield return new WaitForSeconds(0.1f);
+      Assert.That(thread.Steps, Is.GreaterThan(0));
+
+      // ResetData hands Data back to the main thread
+      _scene.ResetData();
+      Assert.That(_scene.PhysicsThread, Is.Null);
+      Assert.That(_scene.Data.GetQpos()[_joint.QposAddress], Is.EqualTo(0));
+      yield return new WaitForFixedUpdate();
+      Assert.That(_scene.PhysicsThread, Is.Not.Null.And.Not.SameAs(thread));
+
+      _scene.PauseSimulation = true;
+      yield return new WaitForFixedUpdate();
+      yield return new WaitForSeconds(0.05f); // let a step in flight finish
+      long steps = _scene.PhysicsThread.Steps;
+      yield return new WaitForSeconds(0.1f);
+      Assert.That(_scene.PhysicsThread.Steps, Is.EqualTo(steps));
+      _scene.PauseSimulation = false;
+
+      settings.BackgroundPhysics = false;
+      yield return new WaitForFixedUpdate();
+      Assert.That(_scene.PhysicsThread, Is.Null);
+    } finally {
+      GameObject.DestroyImmediate(settings.gameObject);
+    }
+  }
 }
 }
 #endif